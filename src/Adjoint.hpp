@@ -0,0 +1,234 @@
+// Adjoint (reverse-mode) automatic differentiation. Every operation on an
+// Adjoint records on its Tape the indices of its arguments and the partial
+// derivatives with respect to them; one reverse sweep over the tape then
+// gives the derivatives of the output with respect to all inputs, at a cost
+// independent of the number of inputs. The scalar type is a template
+// parameter: with a Dual scalar seeded on the inputs, the sweep also gives
+// the derivatives of the gradient, which are the second derivatives.
+
+#ifndef ADJOINT_HPP
+#define ADJOINT_HPP
+
+#include "Dual.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace PricingLibrary {
+
+	template <typename T>
+	class Tape;
+
+	// Value recorded on a tape, constants have no tape entry
+	template <typename T>
+	struct Adjoint
+	{
+		static constexpr std::size_t constant = std::numeric_limits<std::size_t>::max(); // index of constants
+
+		T value{};                       // value
+		std::size_t index{constant};     // entry on the tape
+		Tape<T>* tape{nullptr};          // tape of the entry
+
+		Adjoint() =default;
+		// constant
+		Adjoint(const T& x) : value{x} {}
+		template <typename U> requires (std::is_arithmetic_v<U> && !std::is_same_v<T, U>)
+		Adjoint(U x) : value(x) {}
+	};
+
+	template <typename T>
+	class Tape
+	{
+	private:
+		// Operation with up to two arguments
+		struct Entry
+		{
+			std::size_t argument[2]; // tape indices of the arguments, constant if none
+			T partial[2];            // partial derivatives with respect to them
+		};
+
+		std::vector<Entry> _entries; // operations in the order they were evaluated
+
+	public:
+		/// @brief record an independent variable
+		/// @param x value
+		/// @return variable
+		Adjoint<T> variable(const T& x)
+		{
+			return record(x, Adjoint<T>::constant, T{}, Adjoint<T>::constant, T{});
+		}
+
+		/// @brief record an operation
+		/// @param x value of the result
+		/// @param a tape index of the first argument
+		/// @param da partial derivative with respect to it
+		/// @param b tape index of the second argument
+		/// @param db partial derivative with respect to it
+		/// @return result
+		Adjoint<T> record(const T& x, std::size_t a, const T& da, std::size_t b, const T& db)
+		{
+			_entries.push_back(Entry{{a, b}, {da, db}});
+			Adjoint<T> result{x};
+			result.index = _entries.size() - 1;
+			result.tape = this;
+			return result;
+		}
+
+		/// @brief derivatives of an output with respect to every entry of the tape,
+		/// by one reverse sweep
+		/// @param output result recorded on this tape
+		/// @return adjoint of every entry, index with Adjoint::index
+		std::vector<T> getAdjoints(const Adjoint<T>& output) const
+		{
+			std::vector<T> adjoints(_entries.size(), T{});
+			if (output.index == Adjoint<T>::constant)
+			{
+				return adjoints;
+			}
+
+			adjoints[output.index] = T(1.0);
+			for (std::size_t i = output.index + 1; i-- > 0;)
+			{
+				const Entry& entry = _entries[i];
+				for (std::size_t k = 0; k < 2; k++)
+				{
+					if (entry.argument[k] != Adjoint<T>::constant)
+					{
+						adjoints[entry.argument[k]] = adjoints[entry.argument[k]] + entry.partial[k] * adjoints[i];
+					}
+				}
+			}
+
+			return adjoints;
+		}
+
+		std::size_t size() const { return _entries.size(); } // number of entries
+		void clear() { _entries.clear(); } // remove all entries, keeps the memory
+	};
+
+	namespace AdjointDetail
+	{
+		// Tape of either argument, nullptr if both are constants
+		template <typename T>
+		Tape<T>* tapeOf(const Adjoint<T>& a, const Adjoint<T>& b)
+		{
+			return (a.tape != nullptr) ? a.tape : b.tape;
+		}
+
+		// Result of an operation, a constant if no argument is on a tape
+		template <typename T>
+		Adjoint<T> make(const T& x, const Adjoint<T>& a, const T& da, const Adjoint<T>& b, const T& db)
+		{
+			Tape<T>* tape = tapeOf(a, b);
+			if (tape == nullptr)
+			{
+				return Adjoint<T>(x);
+			}
+			return tape->record(x, a.index, da, b.index, db);
+		}
+
+		// Result of a function of one argument
+		template <typename T>
+		Adjoint<T> make(const T& x, const Adjoint<T>& a, const T& da)
+		{
+			if (a.tape == nullptr)
+			{
+				return Adjoint<T>(x);
+			}
+			return a.tape->record(x, a.index, da, Adjoint<T>::constant, T{});
+		}
+	}
+
+	/************************ Arithmetic ************************/
+
+	template <typename T>
+	Adjoint<T> operator-(const Adjoint<T>& a)
+	{
+		return AdjointDetail::make(T(-a.value), a, T(-1.0));
+	}
+
+	template <typename T>
+	Adjoint<T> operator+(const Adjoint<T>& a, const Adjoint<T>& b)
+	{
+		return AdjointDetail::make(T(a.value + b.value), a, T(1.0), b, T(1.0));
+	}
+
+	template <typename T>
+	Adjoint<T> operator-(const Adjoint<T>& a, const Adjoint<T>& b)
+	{
+		return AdjointDetail::make(T(a.value - b.value), a, T(1.0), b, T(-1.0));
+	}
+
+	template <typename T>
+	Adjoint<T> operator*(const Adjoint<T>& a, const Adjoint<T>& b)
+	{
+		return AdjointDetail::make(T(a.value * b.value), a, b.value, b, a.value);
+	}
+
+	template <typename T>
+	Adjoint<T> operator/(const Adjoint<T>& a, const Adjoint<T>& b)
+	{
+		const T quotient = a.value / b.value;
+		return AdjointDetail::make(quotient, a, T(1.0 / b.value), b, T(-quotient / b.value));
+	}
+
+	// Mixed with plain numbers
+	template <typename T>
+	Adjoint<T> operator+(const Adjoint<T>& a, double b) { return a + Adjoint<T>(b); }
+	template <typename T>
+	Adjoint<T> operator+(double a, const Adjoint<T>& b) { return Adjoint<T>(a) + b; }
+	template <typename T>
+	Adjoint<T> operator-(const Adjoint<T>& a, double b) { return a - Adjoint<T>(b); }
+	template <typename T>
+	Adjoint<T> operator-(double a, const Adjoint<T>& b) { return Adjoint<T>(a) - b; }
+	template <typename T>
+	Adjoint<T> operator*(const Adjoint<T>& a, double b) { return AdjointDetail::make(T(a.value * b), a, T(b)); }
+	template <typename T>
+	Adjoint<T> operator*(double a, const Adjoint<T>& b) { return b * a; }
+	template <typename T>
+	Adjoint<T> operator/(const Adjoint<T>& a, double b) { return a * (1.0 / b); }
+	template <typename T>
+	Adjoint<T> operator/(double a, const Adjoint<T>& b) { return Adjoint<T>(a) / b; }
+
+	/************************ Functions ************************/
+
+	template <typename T>
+	Adjoint<T> exp(const Adjoint<T>& x)
+	{
+		using std::exp;
+		const T e = exp(x.value);
+		return AdjointDetail::make(e, x, e);
+	}
+
+	template <typename T>
+	Adjoint<T> log(const Adjoint<T>& x)
+	{
+		using std::log;
+		return AdjointDetail::make(T(log(x.value)), x, T(1.0 / x.value));
+	}
+
+	template <typename T>
+	Adjoint<T> sqrt(const Adjoint<T>& x)
+	{
+		using std::sqrt;
+		const T root = sqrt(x.value);
+		return AdjointDetail::make(root, x, T(0.5 / root));
+	}
+
+	template <typename T>
+	Adjoint<T> normalPdf(const Adjoint<T>& x)
+	{
+		const T density = normalPdf(x.value);
+		return AdjointDetail::make(density, x, T(-x.value * density));
+	}
+
+	template <typename T>
+	Adjoint<T> normalCdf(const Adjoint<T>& x)
+	{
+		return AdjointDetail::make(T(normalCdf(x.value)), x, T(normalPdf(x.value)));
+	}
+}
+
+#endif
@@ -10,12 +10,27 @@ namespace PricingLibrary {
 	/// @param r risk-free rate
 	/// @param b cost-of-carry parameter
 	AnalyticAmericanPerpetualEngine::AnalyticAmericanPerpetualEngine(double S, double sigma, double r, double b)
-	: _S{S}, _sigma{sigma}, _r{r}, _b{b} {}
+	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _market{}, _underlying{0},
+	  _y{AnalyticAmericanPerpetualKernel::getExponents(sigma, r, b)} {}
+
+	/// @brief Construct on a shared market state, S, sigma, r and b are read
+	/// from the quote of the underlying each time a price or greek is requested
+	/// @param market market state
+	/// @param underlying index of the underlying in the market state
+	AnalyticAmericanPerpetualEngine::AnalyticAmericanPerpetualEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying)
+	: _S{}, _sigma{}, _r{}, _b{}, _market{market}, _underlying{underlying}, _y{}
+	{
+		if (!market || underlying >= market->getUnderlyingCount())
+		{
+			throw IncorrectInputException("Underlying is not in the market state.");
+		}
+	}
 
 	/// @brief Copy constructor
 	/// @param source AnalyticAmericanPerpetualEngine object
 	AnalyticAmericanPerpetualEngine::AnalyticAmericanPerpetualEngine(const AnalyticAmericanPerpetualEngine& source)
-	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b} 
+	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b},
+	  _market{source._market}, _underlying{source._underlying}, _y{source._y}
 	{}
 
 	/// @brief Copy assignemnt
@@ -34,6 +49,9 @@ namespace PricingLibrary {
 		_sigma = source._sigma;
 		_r = source._r;
 		_b = source._b;
+		_market = source._market;
+		_underlying = source._underlying;
+		_y = source._y;
 
 		return *this;
 	}
@@ -41,6 +59,21 @@ namespace PricingLibrary {
 	/// @brief Default destructor
 	AnalyticAmericanPerpetualEngine::~AnalyticAmericanPerpetualEngine() {}
 
+	/// @brief engine on a consistent snapshot of the market quote of the underlying
+	/// @return engine with fixed market data
+	AnalyticAmericanPerpetualEngine AnalyticAmericanPerpetualEngine::getSnapshot() const
+	{
+		const MarketQuote quote{_market->getQuote(_underlying)};
+		return AnalyticAmericanPerpetualEngine(quote.S, quote.sigma, quote.r, quote.b);
+	}
+
+	/// @brief version of the quote of the underlying in the market state
+	/// @return version, 0 without a market state
+	std::uint64_t AnalyticAmericanPerpetualEngine::getMarketVersion() const
+	{
+		return _market ? _market->getVersion(_underlying) : 0;
+	}
+
 	/// @brief Validate if engine was passed to a correct option
 	/// @param exercise American or European
 	void AnalyticAmericanPerpetualEngine::validate(const Payoff::Exercise& exercise) const
@@ -53,75 +86,115 @@ namespace PricingLibrary {
 
 	/// @brief return option price
 	/// @param payoff Payoff object
-	/// @return calls either call or option price function
+	/// @return price from AnalyticAmericanPerpetualKernel
 	double AnalyticAmericanPerpetualEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		if (payoff->getType() == Payoff::Type::Call)
+		if (_market)
 		{
-			return getEngineCallPrice(payoff);
+			return getSnapshot().getEnginePrice(payoff);
 		}
-		else
-		{
-			return getEnginePutPrice(payoff);
-		}
-	}
 
-	/// @brief return call option price
-	/// @param payoff Payoff object
-	/// @return price
-	double AnalyticAmericanPerpetualEngine::getEngineCallPrice(const std::shared_ptr<Payoff>& payoff) const
-	{
 		validate(payoff->getExercise());
 
-		double y1 = 0.5 - _b / (_sigma * _sigma) 
-				  + std::sqrt( std::pow( _b / (_sigma * _sigma) - 0.5, 2) 
-							   + (2 * _r) / (_sigma * _sigma) );
-		double price = payoff->getStrike() / (y1 - 1) 
-					 * std::pow( ((y1 - 1) * _S) / (y1 * payoff->getStrike()), y1 );
-
-		return price;
+		return AnalyticAmericanPerpetualKernel::getPrice(payoff->getType(), _S, payoff->getStrike(), _y);
 	}
 
-	/// @brief return put option price
+	/// @brief return delta greek
 	/// @param payoff Payoff object
-	/// @return price
-	double AnalyticAmericanPerpetualEngine::getEnginePutPrice(const std::shared_ptr<Payoff>& payoff) const
+	/// @return delta
+	double AnalyticAmericanPerpetualEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double y2 = 0.5 - _b / (_sigma * _sigma) 
-				  - std::sqrt( std::pow( _b / (_sigma * _sigma) - 0.5, 2) 
-							   + (2 * _r) / (_sigma * _sigma) );
-		double price = payoff->getStrike() / (1 - y2) 
-					 * std::pow( ((y2 - 1) * _S) / (y2 * payoff->getStrike()), y2 );
+		return getEngineAll(payoff, Greeks::Delta).delta;
+	}
 
-		return price;
+	/// @brief return gamma greek
+	/// @param payoff Payoff object
+	/// @return gamma
+	double AnalyticAmericanPerpetualEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return getEngineAll(payoff, Greeks::Gamma).gamma;
 	}
 
+	/// @brief return Theta greek, zero since a perpetual option does not expire
+	/// @param payoff Payoff object
+	/// @return theta
+	double AnalyticAmericanPerpetualEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return getEngineAll(payoff, Greeks::Theta).theta;
+	}
 
-	/*! \warning Not implemented calculation of Delta greek */
-	double AnalyticAmericanPerpetualEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
+	/// @brief return Vega greek
+	/// @param payoff Payoff object
+	/// @return vega
+	double AnalyticAmericanPerpetualEngine::getEngineVega(const std::shared_ptr<Payoff>& payoff) const
 	{
-		return -1.0;
+		return getEngineAll(payoff, Greeks::Vega).vega;
 	}
 
-	/*! \warning Not implemented calculation of Gamma greek */
-	double AnalyticAmericanPerpetualEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
+	/// @brief return price and Greeks selected by mask, computed by
+	/// AnalyticAmericanPerpetualKernel. Rho is not implemented and is the
+	/// value of getEngineRho, as when it is asked for alone
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks AnalyticAmericanPerpetualEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
 	{
-		return -1.0;
+		if (_market)
+		{
+			return getSnapshot().getEngineAll(payoff, mask);
+		}
+
+		validate(payoff->getExercise());
+
+		Greeks result = AnalyticAmericanPerpetualKernel::getAll(payoff->getType(), _S, payoff->getStrike(), _y, mask);
+		if (mask & Greeks::Rho)
+		{
+			result.rho = getEngineRho(payoff);
+		}
+
+		return result;
 	}
-	
-	/*! \warning Not implemented calculation of Theta greek */
-	double AnalyticAmericanPerpetualEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
+
+	/// @brief return exercise boundary S*, a call is exercised at S >= S* and
+	/// a put at S <= S*
+	/// @param payoff Payoff object
+	/// @return boundary, infinite for a call that is never exercised early
+	double AnalyticAmericanPerpetualEngine::getExerciseBoundary(const std::shared_ptr<Payoff>& payoff) const
 	{
-		return -1.0;
+		if (_market)
+		{
+			return getSnapshot().getExerciseBoundary(payoff);
+		}
+
+		validate(payoff->getExercise());
+
+		return AnalyticAmericanPerpetualKernel::getBoundary(payoff->getType(), payoff->getStrike(), _y);
 	}
 
-	/*! \warning Not implemented calculation of Vega greek */
-	double AnalyticAmericanPerpetualEngine::getEngineVega(const std::shared_ptr<Payoff>& payoff) const
+	/// @brief price a ladder of perpetual options under the engine's sigma, r
+	/// and b. The exponents are shared, so each option costs one pow
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param type option types
+	/// @param price output prices
+	void AnalyticAmericanPerpetualEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+														 std::span<const Payoff::Type> type, std::span<double> price) const
 	{
-		return -1.0;
+		if (_market)
+		{
+			getSnapshot().getBatchPrices(S, K, type, price);
+			return;
+		}
+
+		const std::size_t n{price.size()};
+		if (S.size() != n || K.size() != n || type.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			price[i] = AnalyticAmericanPerpetualKernel::getPrice(type[i], S[i], K[i], _y);
+		}
 	}
-}
\ No newline at end of file
+}
@@ -1,13 +1,20 @@
-// Define engine to price american perpetual options analytically
+// Define engine to price american perpetual options analytically, the
+// price and Greeks are computed by AnalyticAmericanPerpetualKernel. The
+// exponents y1 and y2 depend only on sigma, r and b and are computed once
+// when the engine is constructed, so a price costs one pow
 
 #ifndef ANALYTICAMERICANPERPETUALENGINE_HPP
 #define ANALYTICAMERICANPERPETUALENGINE_HPP
 
 #include "PricingEngine.hpp"
+#include "MarketState.hpp"
+#include "PricingKernels.hpp"
 #include "EngineException.hpp"
 #include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
 
 #include <cmath>
+#include <span>
 
 namespace PricingLibrary {
 
@@ -18,28 +25,39 @@ namespace PricingLibrary {
 		double _sigma;    // volatility
 		double _r;        // risk-free rate
 		double _b;        // cost of carry
+		std::shared_ptr<const MarketState> _market; // market read at pricing time, if any
+		std::size_t _underlying; // underlying in the market
+		AnalyticAmericanPerpetualKernel::Exponents _y; // exponents for sigma, r and b
 
-		// Get call option price
-		double getEngineCallPrice(const std::shared_ptr<Payoff>& payoff) const;
-		// Get put option price
-		double getEnginePutPrice(const std::shared_ptr<Payoff>& payoff) const;
+		// Engine on a snapshot of the market quote
+		AnalyticAmericanPerpetualEngine getSnapshot() const;
 
 		public:
 		AnalyticAmericanPerpetualEngine(double S, double sigma, double r, double b); // default constructor
+		// construct on the quote of an underlying in a shared market state
+		AnalyticAmericanPerpetualEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying);
 		AnalyticAmericanPerpetualEngine(const AnalyticAmericanPerpetualEngine& source); // copy constructor
 		AnalyticAmericanPerpetualEngine& operator= (const AnalyticAmericanPerpetualEngine& source); // copy assignment
 		~AnalyticAmericanPerpetualEngine();	// destructor
 
-		// Get option price, calls appropriately either getEngineCallPrice 
-		// or getEnginePutPrice
+		// Get option price
 		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
-		// Not implemented calculation of greeks
+		// Calculate Greeks, theta is zero
 		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		// Price and Greeks selected by mask, rho is not computed
+		Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const override;
+		// Underlying price at which the option is exercised
+		double getExerciseBoundary(const std::shared_ptr<Payoff>& payoff) const;
+		// Price options of any spot, strike and type under the engine's sigma, r and b
+		void getBatchPrices(std::span<const double> S, std::span<const double> K,
+							std::span<const Payoff::Type> type, std::span<double> price) const;
 		// Validate if engine was passed to a correct option
 		void validate(const Payoff::Exercise& exercise) const override;
+		// Version of the quote of the underlying, 0 without a market state
+		std::uint64_t getMarketVersion() const override;
 	};
 }
 
@@ -2,6 +2,9 @@
 
 #include "AnalyticEuropeanEngine.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace PricingLibrary {
 
 	/// @brief Default constructor
@@ -10,12 +13,65 @@ namespace PricingLibrary {
 	/// @param r risk-free rate
 	/// @param b cost-of-carry parameter
 	AnalyticEuropeanEngine::AnalyticEuropeanEngine(double S, double sigma, double r, double b)
-	: _S{S}, _sigma{sigma}, _r{r}, _b{b} {}
+	: AnalyticEuropeanEngine(S, MarketInputs(sigma, r, b)) {}
+
+	/// @brief Construct on the volatility, rate and cost of carry of inputs
+	/// @param S underlying price
+	/// @param inputs scalars, volatility surface or yield curves
+	AnalyticEuropeanEngine::AnalyticEuropeanEngine(double S, const MarketInputs& inputs)
+	: _S{S}, _inputs{inputs}, _market{}, _underlying{0} {}
+
+	/// @brief Construct on a volatility surface, the volatility of each option
+	/// is read from the surface at its strike and maturity
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	AnalyticEuropeanEngine::AnalyticEuropeanEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+												   double r, double b)
+	: AnalyticEuropeanEngine(S, MarketInputs(surface, r, b)) {}
+
+	/// @brief Construct on yield curves, the rate and cost of carry of each
+	/// option are read from the curves at its maturity, b = r - q
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	AnalyticEuropeanEngine::AnalyticEuropeanEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+												   const std::shared_ptr<const YieldCurve>& dividends)
+	: AnalyticEuropeanEngine(S, MarketInputs(sigma, rates, dividends)) {}
+
+	/// @brief Construct on a volatility surface and yield curves
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	AnalyticEuropeanEngine::AnalyticEuropeanEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+												   const std::shared_ptr<const YieldCurve>& rates,
+												   const std::shared_ptr<const YieldCurve>& dividends)
+	: AnalyticEuropeanEngine(S, MarketInputs(surface, rates, dividends)) {}
+
+	/// @brief Construct on a shared market state, S, sigma, r and b are read
+	/// from the quote of the underlying each time a price or greek is requested
+	/// @param market market state
+	/// @param underlying index of the underlying in the market state
+	/// @param surface volatility surface used in place of the quoted volatility, optional
+	AnalyticEuropeanEngine::AnalyticEuropeanEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying,
+												   const std::shared_ptr<const VolSurface>& surface)
+	: _S{}, _inputs{surface ? MarketInputs(surface, 0.0, 0.0) : MarketInputs(0.0, 0.0, 0.0)},
+	  _market{market}, _underlying{underlying}
+	{
+		if (!market || underlying >= market->getUnderlyingCount())
+		{
+			throw IncorrectInputException("Underlying is not in the market state.");
+		}
+	}
 
 	/// @brief Copy constructor
 	/// @param source AnalyticAmericanPerpetualEngine object
 	AnalyticEuropeanEngine::AnalyticEuropeanEngine(const AnalyticEuropeanEngine& source)
-	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b} 
+	: PricingEngine{source}, _S{source._S}, _inputs{source._inputs},
+	  _market{source._market}, _underlying{source._underlying}
 	{}
 
 	/// @brief Copy assignemnt
@@ -31,9 +87,9 @@ namespace PricingLibrary {
 
 		PricingEngine::operator=(source);
 		_S = source._S;
-		_sigma = source._sigma;
-		_r = source._r;
-		_b = source._b;
+		_inputs = source._inputs;
+		_market = source._market;
+		_underlying = source._underlying;
 
 		return *this;
 	}
@@ -41,6 +97,27 @@ namespace PricingLibrary {
 	/// @brief Default destructor
 	AnalyticEuropeanEngine::~AnalyticEuropeanEngine() {}
 
+	/// @brief market data of an option: a consistent snapshot of the quote of
+	/// the underlying, or the engine's underlying price, resolved by the inputs
+	/// at the strike and maturity of the option
+	/// @param payoff option to be priced
+	/// @return S, sigma, r and b of the option
+	MarketQuote AnalyticEuropeanEngine::getQuote(const Payoff& payoff) const
+	{
+		if (_market)
+		{
+			return _inputs.resolve(_market->getQuote(_underlying), payoff.getStrike(), payoff.getMaturity());
+		}
+		return _inputs.resolve(_S, payoff.getStrike(), payoff.getMaturity());
+	}
+
+	/// @brief version of the quote of the underlying in the market state
+	/// @return version, 0 without a market state
+	std::uint64_t AnalyticEuropeanEngine::getMarketVersion() const
+	{
+		return _market ? _market->getVersion(_underlying) : 0;
+	}
+
 	/// @brief Validate if engine was passed to a correct option
 	/// @param exercise American or European
 	void AnalyticEuropeanEngine::validate(const Payoff::Exercise& exercise) const
@@ -53,51 +130,12 @@ namespace PricingLibrary {
 
 	/// @brief return option price
 	/// @param payoff Payoff object
-	/// @return calls either call or option price function
+	/// @return price from AnalyticEuropeanKernel
 	double AnalyticEuropeanEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
 	{
 		validate(payoff->getExercise());
 
-		if (payoff->getType() == Payoff::Type::Call)
-		{
-			return getEngineCallPrice(payoff);
-		}
-		else
-		{
-			return getEnginePutPrice(payoff);
-		}
-	}
-
-	/// @brief return call option price
-	/// @param payoff Payoff object
-	/// @return price
-	double AnalyticEuropeanEngine::getEngineCallPrice(const std::shared_ptr<Payoff>& payoff) const
-	{
-		validate(payoff->getExercise());
-
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-
-		double d1 = ( std::log(_S / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double d2 = d1 - _sigma * std::sqrt(T);
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double N_d1 = boost::math::cdf(standard_normal, d1);
-		double N_d2 = boost::math::cdf(standard_normal, d2);
-		double price = _S * std::exp( (_b - _r) * T ) * N_d1 - K * std::exp(-_r * T) * N_d2;
-
-		return price;
-	}
-
-	/// @brief return put option price
-	/// @param payoff Payoff object
-	/// @return price
-	double AnalyticEuropeanEngine::getEnginePutPrice(const std::shared_ptr<Payoff>& payoff) const
-	{
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		double callPrice = getEngineCallPrice(payoff);
-
-		return callPrice - _S + K * std::exp(-_r * T);
+		return AnalyticEuropeanKernel::getPrice(Contract::fromPayoff(*payoff), getQuote(*payoff));
 	}
 
 	/// @brief return delta greek
@@ -105,17 +143,7 @@ namespace PricingLibrary {
 	/// @return delta
 	double AnalyticEuropeanEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double d1 = ( std::log(_S / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		d1 = (payoff->getType() == Payoff::Type::Call) ? d1 : -d1;
-		double N_d1 = boost::math::cdf(standard_normal, d1);
-		double delta = std::exp( (_b - _r ) * T ) * N_d1;
-
-		return (payoff->getType() == Payoff::Type::Call) ? delta : -delta;
+		return getEngineAll(payoff, Greeks::Delta).delta;
 	}
 
 	/// @brief return gamma greek
@@ -123,16 +151,7 @@ namespace PricingLibrary {
 	/// @return gamma
 	double AnalyticEuropeanEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double d1 = ( std::log(_S / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double n_d1 = boost::math::pdf(standard_normal, d1);
-		double gamma = n_d1 * std::exp( (_b - _r) * T ) / (_S * _sigma * std::sqrt(T));
-
-		return gamma;
+		return getEngineAll(payoff, Greeks::Gamma).gamma;
 	}
 
 	/// @brief return Vega greek
@@ -140,51 +159,36 @@ namespace PricingLibrary {
 	/// @return vega
 	double AnalyticEuropeanEngine::getEngineVega(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double d1 = ( std::log(_S / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double n_d1 = boost::math::pdf(standard_normal, d1);
-		double vega = _S * std::sqrt(T) * std::exp( (_b - _r) * T ) * n_d1 / 100; // divide by 100 to covert from percentage to raw
-
-		return vega;
+		return getEngineAll(payoff, Greeks::Vega).vega;
 	}
 
 	/// @brief return Theta greek
 	/// @param payoff Payoff object
 	/// @return theta
 	double AnalyticEuropeanEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return getEngineAll(payoff, Greeks::Theta).theta;
+	}
+
+	/// @brief return Rho greek
+	/// @param payoff Payoff object
+	/// @return rho
+	double AnalyticEuropeanEngine::getEngineRho(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return getEngineAll(payoff, Greeks::Rho).rho;
+	}
+
+	/// @brief return price and Greeks selected by mask, computed by the
+	/// BlackScholesKernel of the option type and carry model from shared
+	/// intermediate results. The separate Greek functions select one value
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks AnalyticEuropeanEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
 	{
 		validate(payoff->getExercise());
 
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		double d1 = ( std::log(_S / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double d2 = d1 - _sigma * std::sqrt(T);
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double N_d1 = (payoff->getType() == Payoff::Type::Call) ? 
-					boost::math::cdf(standard_normal, d1) :  boost::math::cdf(standard_normal, -d1);
-		double N_d2 = (payoff->getType() == Payoff::Type::Call) ?
-		 			boost::math::cdf(standard_normal, d2) : boost::math::cdf(standard_normal, -d2);
-		double n_d1 = boost::math::pdf(standard_normal, d1);
-
-		double theta{};
-		if (payoff->getType() == Payoff::Type::Call)
-		{
-			theta = -(_S * _sigma * std::exp( (_b - _r) * T ) * n_d1) / (2 * std::sqrt(T)) 
-				   - (_b - _r) * _S * std::exp( (_b - _r) * T ) * N_d1
-				   - _r * K * std::exp(-_r * T) * N_d2;
-		}
-		else
-		{
-			theta = -(_S * _sigma * std::exp( (_b - _r) * T ) * n_d1) / (2 * std::sqrt(T)) 
-				   + (_b - _r) * _S * std::exp( (_b - _r) * T ) * N_d1
-				   + _r * K * std::exp(-_r * T) * N_d2;
-		}
-		 
-		return theta;
+		return AnalyticEuropeanKernel::getAll(Contract::fromPayoff(*payoff), getQuote(*payoff), mask);
 	}
 
 	/// @brief if put-call parity is satisfied
@@ -202,5 +206,304 @@ namespace PricingLibrary {
 	{
 		return std::abs(call - put - S + K * std::exp(-r * T)) <= epsilon;
 	}
-	
-}
\ No newline at end of file
+
+	/// @brief price a batch of European options given in structure-of-arrays form.
+	/// Uses the same formulas as AnalyticEuropeanKernel::getPrice.
+	/// Contracts are processed in blocks: d1 and d2 of a block are evaluated first, 
+	/// then passed through the vectorized normal cdf. A batch whose contracts all
+	/// have the same type and carry model is priced by its BlackScholesKernel
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void AnalyticEuropeanEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+												std::span<const double> T, std::span<const double> sigma,
+												std::span<const double> r, std::span<const double> b,
+												std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		const std::size_t n{price.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n ||
+			r.size() != n || b.size() != n || type.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		// A batch of one type and carry model runs on its specialized kernel
+		if (n > 0)
+		{
+			const CarryModel model{BlackScholesKernels::getCarryModel(r[0], b[0])};
+			std::size_t i{1};
+			while (i < n && type[i] == type[0] && BlackScholesKernels::getCarryModel(r[i], b[i]) == model)
+			{
+				i++;
+			}
+			if (i == n)
+			{
+				BlackScholesKernels::visit(type[0], r[0], b[0], [&](auto kernel)
+				{
+					kernel.getBatchPrices(S, K, T, sigma, r, b, price);
+				});
+				return;
+			}
+		}
+
+		constexpr std::size_t block_size{256};
+		double d[2 * block_size];
+		double N_d[2 * block_size];
+		for (std::size_t start = 0; start < n; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, n - start)};
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				double d1 = ( std::log(S[i] / K[i]) + (b[i] + sigma[i] * sigma[i] / 2) * T[i] ) / (sigma[i] * std::sqrt(T[i]));
+				d[j] = d1;
+				d[m + j] = d1 - sigma[i] * std::sqrt(T[i]);
+			}
+			StandardNormal::cdf(std::span<const double>(d, 2 * m), std::span<double>(N_d, 2 * m));
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				double discount = K[i] * std::exp(-r[i] * T[i]);
+				double call = S[i] * std::exp( (b[i] - r[i]) * T[i] ) * N_d[j] - discount * N_d[m + j];
+				price[i] = (type[i] == Payoff::Type::Call) ? call : BlackScholesKernels::getPutFromCall(call, S[i], discount);
+			}
+		}
+	}
+
+	/// @brief price a batch of European options with the volatility of each
+	/// contract read from a surface, then priced as by the batch with volatilities
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param surface volatility surface
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void AnalyticEuropeanEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+												std::span<const double> T, const VolSurface& surface,
+												std::span<const double> r, std::span<const double> b,
+												std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		std::vector<double> sigma(price.size());
+		surface.getVolatilities(S, K, T, b, sigma);
+		getBatchPrices(S, K, T, sigma, r, b, type, price);
+	}
+
+	/// @brief price a batch of European options with the rate, cost of carry,
+	/// discount factor and carry factor of each maturity looked up in a cache,
+	/// so no exponential is evaluated for the cached maturities. Contracts
+	/// grouped by maturity find their entry without a search
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param curves discount and carry factors of the maturities
+	/// @param type option types
+	/// @param price output prices
+	void AnalyticEuropeanEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+												std::span<const double> T, std::span<const double> sigma,
+												const DiscountCache& curves,
+												std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		const std::size_t n{price.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n || type.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		constexpr std::size_t block_size{256};
+		double d[2 * block_size];
+		double N_d[2 * block_size];
+		double discount[block_size];
+		double carry[block_size];
+		std::size_t hint{0};
+		for (std::size_t start = 0; start < n; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, n - start)};
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const DiscountFactors factors{curves.getFactors(T[i], hint)};
+				double d1 = ( std::log(S[i] / K[i]) + (factors.b + sigma[i] * sigma[i] / 2) * T[i] ) / (sigma[i] * std::sqrt(T[i]));
+				d[j] = d1;
+				d[m + j] = d1 - sigma[i] * std::sqrt(T[i]);
+				discount[j] = factors.discount;
+				carry[j] = factors.carry;
+			}
+			StandardNormal::cdf(std::span<const double>(d, 2 * m), std::span<double>(N_d, 2 * m));
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				double strike = K[i] * discount[j];
+				double forward = S[i] * carry[j];
+				double call = forward * N_d[j] - strike * N_d[m + j];
+				price[i] = (type[i] == Payoff::Type::Call) ? call : BlackScholesKernels::getPutFromCall(call, S[i], strike);
+			}
+		}
+	}
+
+	/// @brief price a batch of European options in single precision, with the
+	/// normal distribution on the float batch kernels, twice as many lanes as
+	/// in double. Puts take the value of the double engine, call - S + K exp(-rT),
+	/// but are computed from N(-d1) and N(-d2) plus S (exp((b - r)T) - 1):
+	/// subtracting S from the call would cancel in float. Errors against the
+	/// double engine are bounded as documented in the README
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void AnalyticEuropeanEngine::getBatchPrices(std::span<const float> S, std::span<const float> K,
+												std::span<const float> T, std::span<const float> sigma,
+												std::span<const float> r, std::span<const float> b,
+												std::span<const Payoff::Type> type, std::span<float> price)
+	{
+		const std::size_t n{price.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n ||
+			r.size() != n || b.size() != n || type.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		constexpr std::size_t block_size{256};
+		float d[2 * block_size];
+		float N_d[2 * block_size];
+		for (std::size_t start = 0; start < n; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, n - start)};
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				// d1 and d2 for calls, -d1 and -d2 for puts
+				const float omega = (type[i] == Payoff::Type::Call) ? 1.0f : -1.0f;
+				const float sigma_sqrt_T = sigma[i] * std::sqrt(T[i]);
+				const float d1 = ( std::log(S[i] / K[i]) + (b[i] + sigma[i] * sigma[i] / 2) * T[i] ) / sigma_sqrt_T;
+				d[j] = omega * d1;
+				d[m + j] = omega * (d1 - sigma_sqrt_T);
+			}
+			StandardNormal::cdf(std::span<const float>(d, 2 * m), std::span<float>(N_d, 2 * m));
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const float omega = (type[i] == Payoff::Type::Call) ? 1.0f : -1.0f;
+				const float forward = S[i] * std::exp( (b[i] - r[i]) * T[i] );
+				const float strike = K[i] * std::exp(-r[i] * T[i]);
+				const float value = omega * (forward * N_d[j] - strike * N_d[m + j]);
+				price[i] = (omega > 0) ? value : value + S[i] * std::expm1( (b[i] - r[i]) * T[i] );
+			}
+		}
+	}
+
+	/// @brief price and Greeks selected by mask of a batch of European options
+	/// in single precision. Conventions follow getEngineAll: vega per percentage
+	/// point, and the futures option rho when b = 0. Put prices are those of the
+	/// float getBatchPrices. Errors against the double engine are bounded as
+	/// documented in the README
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param greeks output prices and Greeks, fields outside the mask are zero
+	/// @param mask combination of Greeks::Mask flags
+	void AnalyticEuropeanEngine::getBatchAll(std::span<const float> S, std::span<const float> K,
+											 std::span<const float> T, std::span<const float> sigma,
+											 std::span<const float> r, std::span<const float> b,
+											 std::span<const Payoff::Type> type, std::span<FloatGreeks> greeks,
+											 unsigned mask)
+	{
+		const std::size_t n{greeks.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n ||
+			r.size() != n || b.size() != n || type.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		const bool needDensity = mask & (Greeks::Gamma | Greeks::Vega | Greeks::Theta);
+		constexpr std::size_t block_size{256};
+		float d[3 * block_size];
+		float N_d[3 * block_size];
+		for (std::size_t start = 0; start < n; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, n - start)};
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const float omega = (type[i] == Payoff::Type::Call) ? 1.0f : -1.0f;
+				const float sigma_sqrt_T = sigma[i] * std::sqrt(T[i]);
+				const float d1 = ( std::log(S[i] / K[i]) + (b[i] + sigma[i] * sigma[i] / 2) * T[i] ) / sigma_sqrt_T;
+				d[j] = omega * d1;
+				d[m + j] = omega * (d1 - sigma_sqrt_T);
+				d[2 * m + j] = d1;
+			}
+			StandardNormal::cdf(std::span<const float>(d, 2 * m), std::span<float>(N_d, 2 * m));
+			if (needDensity)
+			{
+				StandardNormal::pdf(std::span<const float>(d + 2 * m, m), std::span<float>(N_d + 2 * m, m));
+			}
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const float omega = (type[i] == Payoff::Type::Call) ? 1.0f : -1.0f;
+				const float sqrt_T = std::sqrt(T[i]);
+				const float carry = std::exp( (b[i] - r[i]) * T[i] );
+				const float strike = K[i] * std::exp(-r[i] * T[i]);
+				// N(omega d1), N(omega d2) and n(d1)
+				const float N_d1 = N_d[j];
+				const float N_d2 = N_d[m + j];
+				const float n_d1 = needDensity ? N_d[2 * m + j] : 0.0f;
+				// Black-Scholes value; the put price adds S (exp((b - r)T) - 1) as in getBatchPrices
+				const float value = omega * (S[i] * carry * N_d1 - strike * N_d2);
+
+				FloatGreeks result;
+				if (mask & Greeks::Price)
+				{
+					result.price = (omega > 0) ? value : value + S[i] * std::expm1( (b[i] - r[i]) * T[i] );
+				}
+				if (mask & Greeks::Delta)
+				{
+					result.delta = omega * carry * N_d1;
+				}
+				if (mask & Greeks::Gamma)
+				{
+					result.gamma = n_d1 * carry / (S[i] * sigma[i] * sqrt_T);
+				}
+				if (mask & Greeks::Vega)
+				{
+					result.vega = S[i] * sqrt_T * carry * n_d1 / 100; // divide by 100 to covert from percentage to raw
+				}
+				if (mask & Greeks::Theta)
+				{
+					const float decay = -(S[i] * sigma[i] * carry * n_d1) / (2 * sqrt_T);
+					const float drift = (b[i] - r[i]) * S[i] * carry * N_d1;
+					result.theta = decay - omega * (drift + r[i] * strike * N_d2);
+				}
+				if (mask & Greeks::Rho)
+				{
+					// Futures option model as in BlackScholesKernel: -T times the call,
+					// plus -T K exp(-rT) for a put, which is -T (value + S exp((b - r)T))
+					if (b[i] == 0.0f)
+					{
+						result.rho = (omega > 0) ? -T[i] * value : -T[i] * (value + S[i] * carry);
+					}
+					else
+					{
+						result.rho = omega * T[i] * strike * N_d2;
+					}
+				}
+				greeks[i] = result;
+			}
+		}
+	}
+}
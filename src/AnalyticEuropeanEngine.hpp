@@ -1,51 +1,104 @@
-// Define engine to price european vanilla options analytically
+// Define engine to price european vanilla options analytically, price and
+// getEngineAll are computed by AnalyticEuropeanKernel. The volatility is a
+// scalar or is read from a VolSurface at the strike and maturity of each option;
+// the rate and cost of carry are scalars or are read from a rate and a
+// dividend yield YieldCurve at the maturity of each option. Column batches
+// run in double or, with documented error bounds, in single precision
 
 #ifndef ANALYTICEUROPEANENGINE_HPP
 #define ANALYTICEUROPEANENGINE_HPP
 
 #include "PricingEngine.hpp"
+#include "MarketState.hpp"
+#include "MarketInputs.hpp"
+#include "DiscountCache.hpp"
+#include "PricingKernels.hpp"
 #include "EngineException.hpp"
 #include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+#include "StandardNormal.hpp"
 
 #include <cmath>
-#include <boost/math/distributions/normal.hpp>
+#include <span>
 
 namespace PricingLibrary {
 
 	class AnalyticEuropeanEngine : public PricingEngine
 	{
 	private:
-		double _S;        // underlying price
-		double _sigma;   // volatility
-		double _r;       // risk-free rate
-		double _b;       // cost of carry
+		double _S;             // underlying price
+		MarketInputs _inputs;  // volatility, rate and cost of carry
+		std::shared_ptr<const MarketState> _market; // market read at pricing time, if any
+		std::size_t _underlying; // underlying in the market
 
-		// Get call option price
-		double getEngineCallPrice(const std::shared_ptr<Payoff>& payoff) const;
-		// Get put option price
-		double getEnginePutPrice(const std::shared_ptr<Payoff>& payoff) const;
+		// Market data of an option from the market state or the engine, resolved by the inputs
+		MarketQuote getQuote(const Payoff& payoff) const;
 
 	public:
 		AnalyticEuropeanEngine(double S, double sigma, double r, double b); // default constructor
+		// construct on the volatility, rate and carry of inputs
+		AnalyticEuropeanEngine(double S, const MarketInputs& inputs);
+		// construct on a volatility surface in place of the volatility
+		AnalyticEuropeanEngine(double S, const std::shared_ptr<const VolSurface>& surface, double r, double b);
+		// construct on rate and dividend yield curves in place of r and b
+		AnalyticEuropeanEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+							   const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		AnalyticEuropeanEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+							   const std::shared_ptr<const YieldCurve>& rates,
+							   const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		// construct on the quote of an underlying in a shared market state, the
+		// volatility of the quote is replaced by the surface if one is given
+		AnalyticEuropeanEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying,
+							   const std::shared_ptr<const VolSurface>& surface=nullptr);
 		AnalyticEuropeanEngine(const AnalyticEuropeanEngine& source); // copy constructor
 		AnalyticEuropeanEngine& operator= (const AnalyticEuropeanEngine& source); // copy assignment
 		~AnalyticEuropeanEngine(); // destructor
 
-		// Get option price, calls appropriately either getEngineCallPrice 
-		// or getEnginePutPrice
+		// Get option price
 		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
 		// Calculate Greeks
 		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineRho(const std::shared_ptr<Payoff>& payoff) const override;
+		// Calculate price and Greeks selected by mask from shared intermediate results
+		Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const override;
 
 		// Validate if engine was passed to a correct option
 		void validate(const Payoff::Exercise& exercise) const override;
+		// Version of the quote of the underlying, 0 without a market state
+		std::uint64_t getMarketVersion() const override;
 		// Put-call parity
 		static bool satisfy_put_call_parity(double call, double put, double K, 
 											double S, double r, double T,
 											double epsilon=1e-6);
+		// Price a batch of European options stored as contiguous columns
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, std::span<const double> sigma,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+		// Price a batch of European options with volatilities from a surface
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, const VolSurface& surface,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+		// Price a batch of European options with rates and factors of each maturity from a cache
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, std::span<const double> sigma,
+								   const DiscountCache& curves,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+		// Price a batch of European options in single precision
+		static void getBatchPrices(std::span<const float> S, std::span<const float> K,
+								   std::span<const float> T, std::span<const float> sigma,
+								   std::span<const float> r, std::span<const float> b,
+								   std::span<const Payoff::Type> type, std::span<float> price);
+		// Price and Greeks selected by mask of a batch of European options in single precision
+		static void getBatchAll(std::span<const float> S, std::span<const float> K,
+								std::span<const float> T, std::span<const float> sigma,
+								std::span<const float> r, std::span<const float> b,
+								std::span<const Payoff::Type> type, std::span<FloatGreeks> greeks,
+								unsigned mask=Greeks::All);
 	};
 }
 
@@ -0,0 +1,120 @@
+// Implementation of the header file AsyncResultSink.hpp
+
+#include "AsyncResultSink.hpp"
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Written buffers kept for reuse
+		constexpr std::size_t max_spare_buffers = 16;
+	}
+
+	/// @brief Default constructor, starts the background thread
+	/// @param sink sink to write to, owned by this object
+	AsyncResultSink::AsyncResultSink(std::unique_ptr<ResultSink> sink)
+	: ResultSink{sink ? sink->getColumns() : std::vector<std::string>{}}, _sink{std::move(sink)},
+	  _writing{false}, _stop{false}
+	{
+		_worker = std::thread(&AsyncResultSink::run, this);
+	}
+
+	/// @brief Destructor, waits until all queued rows are written
+	AsyncResultSink::~AsyncResultSink()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_queued.notify_one();
+		_worker.join();
+	}
+
+	/// @brief background thread, writes buffers in queue order. An error stops
+	/// the writing and is rethrown by the next write or flush
+	void AsyncResultSink::run()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (true)
+		{
+			_queued.wait(lock, [this]() { return _stop || !_queue.empty(); });
+			if (_queue.empty())
+			{
+				return;
+			}
+
+			std::vector<double> buffer = std::move(_queue.front());
+			_queue.pop_front();
+			_writing = true;
+			lock.unlock();
+			std::exception_ptr error;
+			try
+			{
+				_sink->write(std::span<const double>(buffer));
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			lock.lock();
+			_writing = false;
+			if (error)
+			{
+				_error = error;
+				_queue.clear();
+			}
+			if (_spare.size() < max_spare_buffers)
+			{
+				buffer.clear();
+				_spare.push_back(std::move(buffer));
+			}
+			if (_queue.empty())
+			{
+				_written.notify_all();
+			}
+		}
+	}
+
+	/// @brief rethrow the error of the background thread once
+	void AsyncResultSink::rethrow()
+	{
+		if (_error)
+		{
+			std::exception_ptr error = _error;
+			_error = nullptr;
+			std::rethrow_exception(error);
+		}
+	}
+
+	/// @brief queue a copy of the rows and return without waiting for the write
+	/// @param values row after row of values
+	void AsyncResultSink::write(std::span<const double> values)
+	{
+		getRowCount(values);
+
+		std::unique_lock<std::mutex> lock(_mutex);
+		rethrow();
+		std::vector<double> buffer;
+		if (!_spare.empty())
+		{
+			buffer = std::move(_spare.back());
+			_spare.pop_back();
+		}
+		lock.unlock();
+		// Copy outside the lock so writers on other threads do not wait for it
+		buffer.assign(values.begin(), values.end());
+		lock.lock();
+		_queue.push_back(std::move(buffer));
+		lock.unlock();
+		_queued.notify_one();
+	}
+
+	/// @brief wait until all queued rows are written, then flush the sink
+	void AsyncResultSink::flush()
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		_written.wait(lock, [this]() { return _queue.empty() && !_writing; });
+		rethrow();
+		_sink->flush();
+	}
+}
@@ -0,0 +1,53 @@
+// Result sink that hands rows to another sink on a background thread.
+// write copies the rows into a queued buffer and returns, so pricing threads
+// never wait for formatting or disk writes; the background thread writes the
+// buffers in the order they were queued. Buffers are reused once written.
+// Several threads may write at the same time, each call stays one block.
+
+#ifndef ASYNCRESULTSINK_HPP
+#define ASYNCRESULTSINK_HPP
+
+#include "ResultSink.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace PricingLibrary {
+
+	class AsyncResultSink : public ResultSink
+	{
+	private:
+		std::unique_ptr<ResultSink> _sink;         // sink written by the background thread
+		std::mutex _mutex;                         // guards the members below
+		std::condition_variable _queued;           // signals new rows or stop
+		std::condition_variable _written;          // signals an empty queue
+		std::deque<std::vector<double>> _queue;    // rows waiting to be written
+		std::vector<std::vector<double>> _spare;   // written buffers kept for reuse
+		bool _writing;                             // background thread is writing a buffer
+		bool _stop;                                // destructor was called
+		std::exception_ptr _error;                 // first error of the background thread
+		std::thread _worker;                       // background thread
+
+		// Background thread, writes queued buffers until stopped
+		void run();
+		// Rethrow an error of the background thread, the caller holds the mutex
+		void rethrow();
+
+	public:
+		using ResultSink::write;
+
+		explicit AsyncResultSink(std::unique_ptr<ResultSink> sink); // default constructor
+		~AsyncResultSink(); // destructor, writes all queued rows
+
+		// Queue a copy of the rows
+		void write(std::span<const double> values) override;
+		// Wait until all queued rows are written and flush the sink
+		void flush() override;
+	};
+}
+
+#endif
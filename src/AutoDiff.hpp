@@ -0,0 +1,165 @@
+// Automatic differentiation of a pricing function of the market inputs
+// S, sigma, T, r and b. The function is written once for a generic scalar
+// type, e.g. a generic lambda, and evaluated once on Dual or Adjoint numbers:
+// - forward mode runs it on Dual<Dual<double, 5>, 5>, every operation
+//   carries the gradient and the Hessian along
+// - adjoint mode records it on a Tape of Adjoint<Dual<double, 5>> and one
+//   reverse sweep gives the gradient and, through the Dual scalar, the Hessian
+// Both modes return the price, the five first derivatives and the 5 x 5
+// second derivatives, exact up to rounding.
+
+#ifndef AUTODIFF_HPP
+#define AUTODIFF_HPP
+
+#include "Adjoint.hpp"
+#include "Dual.hpp"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace PricingLibrary {
+
+	// Mode of automatic differentiation
+	enum DifferentiationMode {ForwardMode=1, AdjointMode=2};
+
+	// Price and its derivatives with respect to the market inputs
+	struct Sensitivities
+	{
+		// Index of the inputs in gradient and hessian
+		enum Input {Spot=0, Volatility=1, Maturity=2, Rate=3, Carry=4};
+		static constexpr std::size_t inputs{5};
+
+		double value{};                    // price
+		double gradient[inputs]{};         // dV/dx
+		double hessian[inputs][inputs]{};  // d2V/dx dy
+	};
+
+	namespace AutoDiff
+	{
+		using Market = std::array<double, Sensitivities::inputs>; // S, sigma, T, r, b
+
+		/// @brief price, gradient and Hessian by forward mode
+		/// @param pricer callable on five values of one scalar type: S, sigma, T, r, b
+		/// @param market values of the inputs
+		/// @return Sensitivities
+		template <typename Pricer>
+		Sensitivities getForward(Pricer&& pricer, const Market& market)
+		{
+			using Inner = Dual<double, Sensitivities::inputs>;
+			using Outer = Dual<Inner, Sensitivities::inputs>;
+
+			std::array<Outer, Sensitivities::inputs> x;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				x[i] = Outer(Inner::variable(market[i], i));
+				x[i].derivative[i] = Inner(1.0);
+			}
+			const Outer price = pricer(x[0], x[1], x[2], x[3], x[4]);
+
+			Sensitivities result;
+			result.value = price.value.value;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				result.gradient[i] = price.value.derivative[i];
+				for (std::size_t j = 0; j < Sensitivities::inputs; j++)
+				{
+					result.hessian[i][j] = price.derivative[i].derivative[j];
+				}
+			}
+
+			return result;
+		}
+
+		/// @brief price, gradient and Hessian by adjoint mode over forward mode
+		/// @param pricer callable on five values of one scalar type: S, sigma, T, r, b
+		/// @param market values of the inputs
+		/// @return Sensitivities
+		template <typename Pricer>
+		Sensitivities getAdjoint(Pricer&& pricer, const Market& market)
+		{
+			using Inner = Dual<double, Sensitivities::inputs>;
+
+			Tape<Inner> tape;
+			std::array<Adjoint<Inner>, Sensitivities::inputs> x;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				x[i] = tape.variable(Inner::variable(market[i], i));
+			}
+			const Adjoint<Inner> price = pricer(x[0], x[1], x[2], x[3], x[4]);
+			const std::vector<Inner> adjoints = tape.getAdjoints(price);
+
+			Sensitivities result;
+			result.value = price.value.value;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				result.gradient[i] = adjoints[x[i].index].value;
+				for (std::size_t j = 0; j < Sensitivities::inputs; j++)
+				{
+					result.hessian[i][j] = adjoints[x[i].index].derivative[j];
+				}
+			}
+
+			return result;
+		}
+
+		/// @brief price and gradient, second derivatives left at zero. Forward mode
+		/// runs the pricer on Dual<double, 5>, adjoint mode records it on a Tape of doubles
+		/// @param pricer callable on five values of one scalar type: S, sigma, T, r, b
+		/// @param market values of the inputs
+		/// @param mode ForwardMode or AdjointMode
+		/// @return Sensitivities
+		template <typename Pricer>
+		Sensitivities getGradient(Pricer&& pricer, const Market& market, DifferentiationMode mode=ForwardMode)
+		{
+			Sensitivities result;
+			if (mode == AdjointMode)
+			{
+				Tape<double> tape;
+				std::array<Adjoint<double>, Sensitivities::inputs> x;
+				for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+				{
+					x[i] = tape.variable(market[i]);
+				}
+				const Adjoint<double> price = pricer(x[0], x[1], x[2], x[3], x[4]);
+				const std::vector<double> adjoints = tape.getAdjoints(price);
+
+				result.value = price.value;
+				for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+				{
+					result.gradient[i] = adjoints[x[i].index];
+				}
+				return result;
+			}
+
+			using Scalar = Dual<double, Sensitivities::inputs>;
+			std::array<Scalar, Sensitivities::inputs> x;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				x[i] = Scalar::variable(market[i], i);
+			}
+			const Scalar price = pricer(x[0], x[1], x[2], x[3], x[4]);
+
+			result.value = price.value;
+			for (std::size_t i = 0; i < Sensitivities::inputs; i++)
+			{
+				result.gradient[i] = price.derivative[i];
+			}
+
+			return result;
+		}
+
+		/// @brief price, gradient and Hessian in the given mode
+		/// @param pricer callable on five values of one scalar type: S, sigma, T, r, b
+		/// @param market values of the inputs
+		/// @param mode ForwardMode or AdjointMode
+		/// @return Sensitivities
+		template <typename Pricer>
+		Sensitivities getSensitivities(Pricer&& pricer, const Market& market, DifferentiationMode mode)
+		{
+			return (mode == AdjointMode) ? getAdjoint(pricer, market) : getForward(pricer, market);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,24 @@
+// Implementation of the header file AxisLocator.hpp
+
+#include "AxisLocator.hpp"
+
+namespace PricingLibrary {
+
+	/// @brief Constructor, builds sixteen buckets per node
+	/// @param nodes increasing nodes, at least two
+	AxisLocator::AxisLocator(const std::vector<double>& nodes)
+	: _nodes{nodes}, _start(16 * nodes.size()), _scale{}
+	{
+		_scale = static_cast<double>(_start.size()) / (_nodes.back() - _nodes.front());
+		std::size_t i{0};
+		for (std::size_t bucket = 0; bucket < _start.size(); bucket++)
+		{
+			const double x = _nodes.front() + static_cast<double>(bucket) / _scale;
+			while (i + 2 < _nodes.size() && _nodes[i + 1] <= x)
+			{
+				i++;
+			}
+			_start[bucket] = static_cast<std::uint32_t>(i);
+		}
+	}
+}
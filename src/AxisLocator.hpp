@@ -0,0 +1,59 @@
+// Finds the interval of an increasing axis that holds a value in constant
+// time: a table of equal-width buckets, sixteen per node, gives the interval
+// at the start of each bucket, from which rarely a node is skipped. Used for
+// the expiry and moneyness axes of the volatility surfaces and the
+// maturities of a DiscountCache.
+
+#ifndef AXISLOCATOR_HPP
+#define AXISLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class AxisLocator
+	{
+	private:
+		std::vector<double> _nodes;        // increasing nodes, at least two
+		std::vector<std::uint32_t> _start; // interval at the start of each bucket
+		double _scale{};                   // buckets per unit of the axis
+
+	public:
+		AxisLocator() =default;
+		explicit AxisLocator(const std::vector<double>& nodes);
+
+		/// @brief interval i with nodes[i] <= x < nodes[i + 1], the last interval at the last node
+		/// @param x value between the first and the last node, others give the
+		/// first or the last interval and NaN gives an interval of the first bucket
+		/// @return interval
+		std::size_t locate(double x) const
+		{
+			// Converted only when in range, the cast of NaN or a too large value is undefined
+			const double offset = (x - _nodes.front()) * _scale;
+			std::size_t bucket{_start.size() - 1};
+			if (!(offset >= 0.0))
+			{
+				bucket = 0;
+			}
+			else if (offset < static_cast<double>(_start.size()))
+			{
+				bucket = static_cast<std::size_t>(offset);
+			}
+			std::size_t i{_start[bucket]};
+			// Rounding of the bucket boundaries can put x one node early
+			while (i > 0 && _nodes[i] > x)
+			{
+				i--;
+			}
+			while (i + 2 < _nodes.size() && _nodes[i + 1] <= x)
+			{
+				i++;
+			}
+			return i;
+		}
+	};
+}
+
+#endif
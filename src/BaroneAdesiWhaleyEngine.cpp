@@ -0,0 +1,383 @@
+// Implementation of the header file BaroneAdesiWhaleyEngine.hpp
+
+#include "BaroneAdesiWhaleyEngine.hpp"
+#include "StandardNormal.hpp"
+
+#include <cmath>
+#include <array>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Key of the critical price cache
+		struct CriticalKey
+		{
+			double K, T, sigma, r, b;
+			Payoff::Type type;
+
+			bool operator==(const CriticalKey& other) const
+			{
+				return K == other.K && T == other.T && sigma == other.sigma && r == other.r && b == other.b
+					&& type == other.type;
+			}
+		};
+
+		struct CriticalKeyHash
+		{
+			std::size_t operator()(const CriticalKey& key) const
+			{
+				std::size_t seed = std::hash<int>{}(key.type);
+				for (double value : {key.K, key.T, key.sigma, key.r, key.b})
+				{
+					seed ^= std::hash<double>{}(value) + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2);
+				}
+				return seed;
+			}
+		};
+
+		// Slot of the critical price cache
+		struct CriticalSlot
+		{
+			CriticalKey key;
+			double critical;
+			bool filled;
+		};
+
+		// Direct-mapped cache of each thread, a new key replaces the one in its slot
+		constexpr std::size_t cache_slots = 1 << 10;
+		thread_local std::array<CriticalSlot, cache_slots> critical_cache{};
+
+		// Black-Scholes value and d1
+		double blackScholes(double S, double K, double T, double sigma, double r, double b, Payoff::Type type, double& d1)
+		{
+			d1 = (std::log(S / K) + (b + sigma * sigma / 2) * T) / (sigma * std::sqrt(T));
+			const double d2 = d1 - sigma * std::sqrt(T);
+			const double theta = (type == Payoff::Type::Call) ? 1.0 : -1.0;
+
+			return theta * (S * std::exp((b - r) * T) * StandardNormal::cdf(theta * d1)
+						  - K * std::exp(-r * T) * StandardNormal::cdf(theta * d2));
+		}
+
+		// Exponent q2 of the call (theta = 1) or q1 of the put (theta = -1)
+		double exponent(double T, double sigma, double r, double b, double theta)
+		{
+			const double n = 2 * b / (sigma * sigma);
+			// k = 2r / (sigma^2 (1 - exp(-rT))) tends to 2 / (sigma^2 T) for r -> 0
+			const double k = (std::abs(r * T) > 1e-12) ? 2 * r / (sigma * sigma * (1 - std::exp(-r * T)))
+													   : 2 / (sigma * sigma * T);
+			return (-(n - 1) + theta * std::sqrt((n - 1) * (n - 1) + 4 * k)) / 2;
+		}
+
+		// Early exercise is never optimal for a call with b >= r or a put with r <= 0
+		bool isEuropean(double r, double b, Payoff::Type type)
+		{
+			return (type == Payoff::Type::Call) ? b >= r : r <= 0.0;
+		}
+
+		// Newton iteration for the critical price (Haug, 2007)
+		double solveCriticalPrice(double K, double T, double sigma, double r, double b, Payoff::Type type)
+		{
+			const double theta = (type == Payoff::Type::Call) ? 1.0 : -1.0;
+			const double sqrt_T = std::sqrt(T);
+			const double carry = std::exp((b - r) * T);
+			const double q = exponent(T, sigma, r, b, theta);
+
+			// Seed from the perpetual critical price
+			const double n = 2 * b / (sigma * sigma);
+			const double m = 2 * r / (sigma * sigma);
+			const double q_inf = (-(n - 1) + theta * std::sqrt((n - 1) * (n - 1) + 4 * m)) / 2;
+			const double S_inf = K / (1 - 1 / q_inf);
+			double Si{};
+			if (theta > 0)
+			{
+				const double h = -(b * T + 2 * sigma * sqrt_T) * K / (S_inf - K);
+				Si = K + (S_inf - K) * (1 - std::exp(h));
+			}
+			else
+			{
+				const double h = (b * T - 2 * sigma * sqrt_T) * K / (K - S_inf);
+				Si = S_inf + (K - S_inf) * std::exp(h);
+			}
+
+			for (int iteration = 0; iteration < 100; iteration++)
+			{
+				double d1{};
+				const double european = blackScholes(Si, K, T, sigma, r, b, type, d1);
+				const double N_d1 = StandardNormal::cdf(theta * d1);
+				// Value matching: theta (Si - K) = european + theta (1 - carry N(theta d1)) Si / q
+				const double lhs = theta * (Si - K);
+				const double rhs = european + theta * (1 - carry * N_d1) * Si / q;
+				if (std::abs(lhs - rhs) <= 1e-10 * K)
+				{
+					break;
+				}
+				// Slope of the right-hand side
+				const double slope = theta * (carry * N_d1 * (1 - 1 / q)
+											+ (1 - theta * carry * StandardNormal::pdf(d1) / (sigma * sqrt_T)) / q);
+				Si = (theta > 0) ? (K + rhs - slope * Si) / (1 - slope) : (K - rhs + slope * Si) / (1 + slope);
+			}
+
+			return Si;
+		}
+	}
+
+	/// @brief Default constructor
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(double S, double sigma, double r, double b)
+	: BaroneAdesiWhaleyEngine(S, MarketInputs(sigma, r, b)) {}
+
+	/// @brief Construct on the volatility, rate and cost of carry of inputs
+	/// @param S underlying price
+	/// @param inputs scalars, volatility surface or yield curves
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(double S, const MarketInputs& inputs)
+	: _S{S}, _inputs{inputs} {}
+
+	/// @brief Construct on a volatility surface, the volatility of each option
+	/// is read from the surface at its strike and maturity
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(double S, const std::shared_ptr<const VolSurface>& surface, double r, double b)
+	: BaroneAdesiWhaleyEngine(S, MarketInputs(surface, r, b)) {}
+
+	/// @brief Construct on yield curves, the rate and cost of carry of each
+	/// option are read from the curves at its maturity, b = r - q
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+														 const std::shared_ptr<const YieldCurve>& dividends)
+	: BaroneAdesiWhaleyEngine(S, MarketInputs(sigma, rates, dividends)) {}
+
+	/// @brief Construct on a volatility surface and yield curves
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+														 const std::shared_ptr<const YieldCurve>& rates,
+														 const std::shared_ptr<const YieldCurve>& dividends)
+	: BaroneAdesiWhaleyEngine(S, MarketInputs(surface, rates, dividends)) {}
+
+	/// @brief Copy constructor
+	/// @param source BaroneAdesiWhaleyEngine object
+	BaroneAdesiWhaleyEngine::BaroneAdesiWhaleyEngine(const BaroneAdesiWhaleyEngine& source)
+	: PricingEngine{source}, _S{source._S}, _inputs{source._inputs}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source BaroneAdesiWhaleyEngine object
+	/// @return BaroneAdesiWhaleyEngine object
+	BaroneAdesiWhaleyEngine& BaroneAdesiWhaleyEngine::operator= (const BaroneAdesiWhaleyEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		PricingEngine::operator=(source);
+		_S = source._S;
+		_inputs = source._inputs;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	BaroneAdesiWhaleyEngine::~BaroneAdesiWhaleyEngine() {}
+
+	/// @brief Validate if engine was passed to a correct option
+	/// @param exercise American or European
+	void BaroneAdesiWhaleyEngine::validate(const Payoff::Exercise& exercise) const
+	{
+		if (exercise != Payoff::American)
+		{
+			throw IncorrectEngineException("Only American options have Barone-Adesi and Whaley approximation.");
+		}
+	}
+
+	/// @brief critical underlying price beyond which exercise is optimal. Solved
+	/// once per (K, T, sigma, r, b, type) and kept in a direct-mapped cache of the
+	/// calling thread, so concurrent pricing never locks
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type call or put
+	/// @return critical price, infinity for a call and 0 for a put never exercised early
+	double BaroneAdesiWhaleyEngine::getCriticalPrice(double K, double T, double sigma, double r, double b,
+													 Payoff::Type type)
+	{
+		if (isEuropean(r, b, type))
+		{
+			return (type == Payoff::Type::Call) ? std::numeric_limits<double>::infinity() : 0.0;
+		}
+
+		const CriticalKey key{K, T, sigma, r, b, type};
+		CriticalSlot& slot = critical_cache[CriticalKeyHash{}(key) & (cache_slots - 1)];
+		if (slot.filled && slot.key == key)
+		{
+			return slot.critical;
+		}
+
+		slot.key = key;
+		slot.critical = solveCriticalPrice(K, T, sigma, r, b, type);
+		slot.filled = true;
+
+		return slot.critical;
+	}
+
+	/// @brief price from the critical underlying price
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type call or put
+	/// @param critical critical underlying price
+	/// @return price
+	double BaroneAdesiWhaleyEngine::getApproximation(double S, double K, double T, double sigma, double r, double b,
+													 Payoff::Type type, double critical)
+	{
+		const double theta = (type == Payoff::Type::Call) ? 1.0 : -1.0;
+		// Beyond the critical price the option is exercised
+		if (!isEuropean(r, b, type) && theta * (S - critical) >= 0.0)
+		{
+			return theta * (S - K);
+		}
+
+		double d1{};
+		const double european = blackScholes(S, K, T, sigma, r, b, type, d1);
+		if (isEuropean(r, b, type))
+		{
+			return european;
+		}
+
+		const double q = exponent(T, sigma, r, b, theta);
+		double d1_critical{};
+		blackScholes(critical, K, T, sigma, r, b, type, d1_critical);
+		const double A = theta * critical / q
+					   * (1 - std::exp((b - r) * T) * StandardNormal::cdf(theta * d1_critical));
+
+		return european + A * std::pow(S / critical, q);
+	}
+
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double BaroneAdesiWhaleyEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		validate(payoff->getExercise());
+
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const Payoff::Type type{payoff->getType()};
+		const MarketQuote quote{_inputs.resolve(_S, K, T)};
+
+		return getAmericanPrice(quote.S, K, T, quote.sigma, quote.r, quote.b, type);
+	}
+
+	/// @brief price of one American option
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type call or put
+	/// @return price
+	double BaroneAdesiWhaleyEngine::getAmericanPrice(double S, double K, double T, double sigma, double r, double b,
+													 Payoff::Type type)
+	{
+		return getApproximation(S, K, T, sigma, r, b, type, getCriticalPrice(K, T, sigma, r, b, type));
+	}
+
+	/// @brief price a batch of American options. Rows with the same contract
+	/// parameters as the previous row reuse its critical price without locking the cache
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void BaroneAdesiWhaleyEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+												 std::span<const double> T, std::span<const double> sigma,
+												 std::span<const double> r, std::span<const double> b,
+												 std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		const std::size_t n{S.size()};
+		if (K.size() != n || T.size() != n || sigma.size() != n || r.size() != n || b.size() != n ||
+			type.size() != n || price.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		double critical{};
+		for (std::size_t i = 0; i < n; i++)
+		{
+			if (i == 0 || K[i] != K[i - 1] || T[i] != T[i - 1] || sigma[i] != sigma[i - 1] ||
+				r[i] != r[i - 1] || b[i] != b[i - 1] || type[i] != type[i - 1])
+			{
+				critical = getCriticalPrice(K[i], T[i], sigma[i], r[i], b[i], type[i]);
+			}
+			price[i] = getApproximation(S[i], K[i], T[i], sigma[i], r[i], b[i], type[i], critical);
+		}
+	}
+
+	/*! \warning Not implemented calculation of Delta greek */
+	double BaroneAdesiWhaleyEngine::getEngineDelta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Gamma greek */
+	double BaroneAdesiWhaleyEngine::getEngineGamma(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Theta greek */
+	double BaroneAdesiWhaleyEngine::getEngineTheta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Vega greek */
+	double BaroneAdesiWhaleyEngine::getEngineVega(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/// @brief price a batch of American options with the volatility of each
+	/// contract read from a surface, then priced as by the batch with volatilities
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param surface volatility surface
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void BaroneAdesiWhaleyEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+								std::span<const double> T, const VolSurface& surface,
+								std::span<const double> r, std::span<const double> b,
+								std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		std::vector<double> sigma(price.size());
+		surface.getVolatilities(S, K, T, b, sigma);
+		getBatchPrices(S, K, T, sigma, r, b, type, price);
+	}
+}
@@ -0,0 +1,73 @@
+// Define engine to price american options of finite maturity with the
+// quadratic approximation of Barone-Adesi and Whaley (1987). The critical
+// underlying price does not depend on the underlying price, so its Newton
+// solve is cached per (K, T, sigma, r, b, type) in a table of each thread.
+
+#ifndef BARONEADESIWHALEYENGINE_HPP
+#define BARONEADESIWHALEYENGINE_HPP
+
+#include "PricingEngine.hpp"
+#include "MarketInputs.hpp"
+#include "EngineException.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <span>
+
+namespace PricingLibrary {
+
+	class BaroneAdesiWhaleyEngine : public PricingEngine
+	{
+	private:
+		double _S;             // underlying price
+		MarketInputs _inputs;  // volatility, rate and cost of carry
+
+		// Price from the critical underlying price
+		static double getApproximation(double S, double K, double T, double sigma, double r, double b,
+									   Payoff::Type type, double critical);
+
+	public:
+		BaroneAdesiWhaleyEngine(double S, double sigma, double r, double b); // default constructor
+		// construct on the volatility, rate and carry of inputs
+		BaroneAdesiWhaleyEngine(double S, const MarketInputs& inputs);
+		// construct on a volatility surface in place of the volatility
+		BaroneAdesiWhaleyEngine(double S, const std::shared_ptr<const VolSurface>& surface, double r, double b);
+		// construct on rate and dividend yield curves in place of r and b
+		BaroneAdesiWhaleyEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+								const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		BaroneAdesiWhaleyEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+								const std::shared_ptr<const YieldCurve>& rates,
+								const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		BaroneAdesiWhaleyEngine(const BaroneAdesiWhaleyEngine& source); // copy constructor
+		BaroneAdesiWhaleyEngine& operator= (const BaroneAdesiWhaleyEngine& source); // copy assignment
+		~BaroneAdesiWhaleyEngine(); // destructor
+
+		// Get option price
+		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
+		// Not implemented calculation of greeks
+		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		// Validate if engine was passed to a correct option
+		void validate(const Payoff::Exercise& exercise) const override;
+
+		// Critical underlying price beyond which exercise is optimal, cached
+		static double getCriticalPrice(double K, double T, double sigma, double r, double b, Payoff::Type type);
+		// Call or put price of one contract
+		static double getAmericanPrice(double S, double K, double T, double sigma, double r, double b,
+									   Payoff::Type type);
+		// Price a batch of American options stored as contiguous columns
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, std::span<const double> sigma,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+		// Price a batch of American options with volatilities from a surface
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, const VolSurface& surface,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+	};
+}
+
+#endif
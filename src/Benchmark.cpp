@@ -0,0 +1,778 @@
+// Benchmark of the pricing engines and of the Helper_functions sweeps.
+// Every case prices a fixed set of contracts through one path (scalar
+// engine calls, batch entry points or a SweepExecutor on all hardware
+// threads) and reports ns/contract and contracts/sec as JSON on standard
+// output, so results can be stored and compared between releases.
+//
+// Usage: bench [min_seconds]
+//   min_seconds  minimum measured time per case, default 0.2
+// Usage: bench --accuracy
+//   checks the single precision batches of AnalyticEuropeanEngine against
+//   the double engine on a parameter grid, prints the errors and their
+//   documented bounds as JSON and exits with 1 if a bound is exceeded
+
+#include "Payoff.hpp"
+#include "AnalyticEuropeanEngine.hpp"
+#include "NumericalEuropeanEngine.hpp"
+#include "AnalyticAmericanPerpetualEngine.hpp"
+#include "MonteCarloEuropeanEngine.hpp"
+#include "FiniteDifferenceEngine.hpp"
+#include "LatticeEngine.hpp"
+#include "BaroneAdesiWhaleyEngine.hpp"
+#include "BjerksundStenslandEngine.hpp"
+#include "GridVolSurface.hpp"
+#include "SviVolSurface.hpp"
+#include "DiscountCache.hpp"
+#include "VanillaOption.hpp"
+#include "PriceCache.hpp"
+#include "SweepExecutor.hpp"
+#include "LiveBook.hpp"
+#include "MarketState.hpp"
+#include "PricingKernels.hpp"
+#include "Portfolio.hpp"
+#include "ScenarioEngine.hpp"
+#include "ContractBook.hpp"
+#include "CsvResultSink.hpp"
+#include "BinaryResultSink.hpp"
+#include "AsyncResultSink.hpp"
+
+#include "Helper_functions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace PricingLibrary;
+using namespace Helper_functions;
+
+namespace
+{
+	// Result of one benchmark case
+	struct Record
+	{
+		std::string engine;    // engine or function measured
+		std::string path;      // scalar, batch, parallel or sweep
+		std::size_t contracts; // contracts priced per run
+		double nsPerContract;  // best time per contract
+	};
+
+	// Contracts as columns
+	struct Contracts
+	{
+		std::vector<double> S, K, T, sigma, r, b;
+		std::vector<Payoff::Type> type;
+		std::vector<std::shared_ptr<Payoff>> european, american;
+
+		std::size_t size() const { return S.size(); }
+	};
+
+	// Deterministic chain of calls and puts around S = 100
+	Contracts make_contracts(std::size_t n)
+	{
+		Contracts c;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			c.S.push_back(100.0);
+			c.K.push_back(60.0 + static_cast<double>(i % 81));
+			c.T.push_back(0.1 + 0.1 * static_cast<double>((i / 81) % 20));
+			c.sigma.push_back(0.1 + 0.05 * static_cast<double>((i / 7) % 9));
+			c.r.push_back(0.01 + 0.01 * static_cast<double>((i / 3) % 6));
+			c.b.push_back(c.r.back());
+			c.type.push_back((i % 2 == 0) ? Payoff::Call : Payoff::Put);
+			c.european.push_back(std::make_shared<Payoff>(c.T.back(), c.K.back(), c.type.back(), Payoff::European));
+			c.american.push_back(std::make_shared<Payoff>(c.T.back(), c.K.back(), c.type.back(), Payoff::American));
+		}
+
+		return c;
+	}
+
+	// Best time per contract of three trials, each repeating the run
+	// until the minimum time has passed
+	double measure(std::size_t contracts, double minSeconds, const std::function<void()>& run)
+	{
+		using clock = std::chrono::steady_clock;
+		run(); // warm-up
+
+		double best{1e300};
+		for (int trial = 0; trial < 3; trial++)
+		{
+			std::size_t repetitions{0};
+			const auto start = clock::now();
+			double elapsed{};
+			do
+			{
+				run();
+				repetitions++;
+				elapsed = std::chrono::duration<double>(clock::now() - start).count();
+			} while (elapsed < minSeconds / 3);
+			best = std::min(best, elapsed * 1e9 / static_cast<double>(repetitions * contracts));
+		}
+
+		return best;
+	}
+
+	// Scalar path: one engine per contract, as in the README examples
+	template <typename Engine, typename... Args>
+	void price_scalar(const Contracts& c, const std::vector<std::shared_ptr<Payoff>>& payoffs,
+					  std::size_t begin, std::size_t end, std::vector<double>& out, const Args&... args)
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			const Engine engine(c.S[i], c.sigma[i], c.r[i], c.b[i], args...);
+			out[i] = engine.getEnginePrice(payoffs[i]);
+		}
+	}
+
+	// Batch entry point taking volatilities as a column, picks that overload
+	// of the engines' getBatchPrices
+	using BatchFunction = void (*)(std::span<const double>, std::span<const double>, std::span<const double>,
+								   std::span<const double>, std::span<const double>, std::span<const double>,
+								   std::span<const Payoff::Type>, std::span<double>);
+
+	// Batch path on the contracts [begin, end)
+	void price_batch(const Contracts& c, std::size_t begin, std::size_t end, std::vector<double>& out, BatchFunction batch)
+	{
+		const std::size_t n{end - begin};
+		batch(std::span<const double>(c.S).subspan(begin, n), std::span<const double>(c.K).subspan(begin, n),
+			  std::span<const double>(c.T).subspan(begin, n), std::span<const double>(c.sigma).subspan(begin, n),
+			  std::span<const double>(c.r).subspan(begin, n), std::span<const double>(c.b).subspan(begin, n),
+			  std::span<const Payoff::Type>(c.type).subspan(begin, n), std::span<double>(out).subspan(begin, n));
+	}
+
+	// Documented error bound of one output of the single precision batches
+	struct ErrorBound
+	{
+		std::string output; // price or Greek
+		double absolute;    // maximum absolute error
+		double relative;    // maximum relative error where the double value is at least relative_floor
+	};
+
+	// Relative errors are checked where the double value is at least this large
+	constexpr double relative_floor{0.01};
+
+	// Bounds documented in the README, S = 100
+	const std::vector<ErrorBound> float_bounds{
+		{"price", 1e-4, 1e-3}, {"delta", 2e-6, 2e-5}, {"gamma", 2e-6, 5e-5},
+		{"vega", 2e-6, 2e-5}, {"theta", 5e-4, 1e-3}, {"rho", 1e-3, 1e-4}};
+
+	// Errors of the float batches and a single precision LiveBook against
+	// AnalyticEuropeanEngine::getEngineAll on a grid of S = 100 and strikes
+	// from 40 to 250, maturities from one day to ten years, volatilities from
+	// 3% to 120%, rates from -1% to 10% and stock, futures and two dividend
+	// carry models, calls and puts
+	int check_float_accuracy()
+	{
+		std::vector<float> S, K, T, sigma, r, b;
+		std::vector<Payoff::Type> type;
+		for (double strike = 40.0; strike <= 250.0; strike += 2.5)
+		{
+			for (double maturity : {1.0 / 365, 1.0 / 52, 1.0 / 12, 0.25, 0.5, 1.0, 2.0, 5.0, 10.0})
+			{
+				for (double volatility : {0.03, 0.05, 0.1, 0.2, 0.4, 0.8, 1.2})
+				{
+					for (double rate : {-0.01, 0.0, 0.02, 0.05, 0.1})
+					{
+						for (double carry : {rate, 0.0, rate - 0.03, rate + 0.02})
+						{
+							for (Payoff::Type t : {Payoff::Call, Payoff::Put})
+							{
+								S.push_back(100.0f);
+								K.push_back(static_cast<float>(strike));
+								T.push_back(static_cast<float>(maturity));
+								sigma.push_back(static_cast<float>(volatility));
+								r.push_back(static_cast<float>(rate));
+								b.push_back(static_cast<float>(carry));
+								type.push_back(t);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		const std::size_t n{S.size()};
+		std::vector<float> price(n);
+		std::vector<FloatGreeks> greeks(n);
+		AnalyticEuropeanEngine::getBatchPrices(S, K, T, sigma, r, b, type, price);
+		AnalyticEuropeanEngine::getBatchAll(S, K, T, sigma, r, b, type, greeks);
+		LiveBook book(1, LiveBook::Single);
+		const std::size_t underlying{book.addUnderlying(S[0])};
+		for (std::size_t i = 0; i < n; i++)
+		{
+			book.addContract(underlying, K[i], T[i], sigma[i], r[i], b[i], type[i]);
+		}
+		book.updateSpot(underlying, S[0]);
+
+		// Maximum errors of price, delta, gamma, vega, theta and rho; the price
+		// of both float batches and of the single precision LiveBook counts as price
+		std::vector<double> absolute(float_bounds.size(), 0.0), relative(float_bounds.size(), 0.0);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			// The double engine on the same inputs, widened to double
+			const AnalyticEuropeanEngine engine(S[i], sigma[i], r[i], b[i]);
+			const Greeks expected{engine.getEngineAll(std::make_shared<Payoff>(T[i], K[i], type[i], Payoff::European))};
+			const double values[][2]{{greeks[i].price, expected.price}, {greeks[i].delta, expected.delta},
+									 {greeks[i].gamma, expected.gamma}, {greeks[i].vega, expected.vega},
+									 {greeks[i].theta, expected.theta}, {greeks[i].rho, expected.rho},
+									 {price[i], expected.price}, {book.getPrice(i), expected.price}};
+			for (std::size_t k = 0; k < std::size(values); k++)
+			{
+				const std::size_t output{(k < float_bounds.size()) ? k : 0};
+				const double error{std::abs(values[k][0] - values[k][1])};
+				absolute[output] = std::max(absolute[output], error);
+				if (std::abs(values[k][1]) >= relative_floor)
+				{
+					relative[output] = std::max(relative[output], error / std::abs(values[k][1]));
+				}
+			}
+		}
+
+		bool passed{true};
+		std::cout << "{\n  \"accuracy\": \"single-precision\",\n"
+				  << "  \"contracts\": " << n << ",\n"
+				  << "  \"relative_floor\": " << relative_floor << ",\n"
+				  << "  \"results\": [\n";
+		for (std::size_t k = 0; k < float_bounds.size(); k++)
+		{
+			const ErrorBound& bound = float_bounds[k];
+			const bool within{absolute[k] <= bound.absolute && relative[k] <= bound.relative};
+			passed = passed && within;
+			std::cout << "    {\"output\": \"" << bound.output << "\", \"max_absolute_error\": " << absolute[k]
+					  << ", \"absolute_bound\": " << bound.absolute
+					  << ", \"max_relative_error\": " << relative[k]
+					  << ", \"relative_bound\": " << bound.relative
+					  << ", \"passed\": " << (within ? "true" : "false") << "}"
+					  << (k + 1 < float_bounds.size() ? ",\n" : "\n");
+		}
+		std::cout << "  ]\n}\n";
+
+		return passed ? 0 : 1;
+	}
+
+	// Write records as JSON
+	void print_json(const std::vector<Record>& records, std::size_t threads, double minSeconds)
+	{
+		std::cout << "{\n  \"benchmark\": \"option-pricing\",\n"
+				  << "  \"threads\": " << threads << ",\n"
+				  << "  \"min_seconds\": " << minSeconds << ",\n"
+				  << "  \"results\": [\n";
+		for (std::size_t i = 0; i < records.size(); i++)
+		{
+			const Record& record = records[i];
+			std::cout << "    {\"engine\": \"" << record.engine << "\", \"path\": \"" << record.path
+					  << "\", \"contracts\": " << record.contracts
+					  << ", \"ns_per_contract\": " << record.nsPerContract
+					  << ", \"contracts_per_sec\": " << 1e9 / record.nsPerContract << "}"
+					  << (i + 1 < records.size() ? ",\n" : "\n");
+		}
+		std::cout << "  ]\n}\n";
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && std::string(argv[1]) == "--accuracy")
+	{
+		return check_float_accuracy();
+	}
+
+	const double minSeconds{(argc > 1) ? std::atof(argv[1]) : 0.2};
+	if (!(minSeconds > 0.0))
+	{
+		std::cerr << "Usage: bench [min_seconds] | bench --accuracy\n";
+		return 1;
+	}
+
+	const std::size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+	SweepExecutor executor(threads, 256);
+	std::vector<Record> records;
+
+	// Run a case in its scalar form and on all threads
+	auto scalar_and_parallel = [&](const std::string& engine, std::size_t contracts,
+								   const std::function<void(std::size_t, std::size_t)>& kernel)
+	{
+		records.push_back({engine, "scalar", contracts,
+						   measure(contracts, minSeconds, [&]() { kernel(0, contracts); })});
+		records.push_back({engine, "parallel", contracts,
+						   measure(contracts, minSeconds, [&]() { executor.run(contracts, kernel); })});
+	};
+
+	/************************ Closed form engines ************************/
+	{
+		const Contracts c{make_contracts(1 << 16)};
+		std::vector<double> out(c.size());
+		// Value-type records of the same contracts for the kernel path
+		std::vector<Contract> european, american;
+		std::vector<MarketQuote> quotes;
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			european.push_back(Contract::fromPayoff(*c.european[i]));
+			american.push_back(Contract::fromPayoff(*c.american[i]));
+			quotes.push_back({c.S[i], c.sigma[i], c.r[i], c.b[i]});
+		}
+		auto kernel_case = [&](const std::string& engine, const PricingKernel& kernel, const std::vector<Contract>& contracts)
+		{
+			records.push_back({engine, "kernel", c.size(), measure(c.size(), minSeconds, [&]()
+			{
+				PricingKernels::getBatchPrices(kernel, contracts, quotes, out);
+			})});
+		};
+
+		scalar_and_parallel("AnalyticEuropeanEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<AnalyticEuropeanEngine>(c, c.european, begin, end, out);
+		});
+		records.push_back({"AnalyticEuropeanEngine", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			price_batch(c, 0, c.size(), out, AnalyticEuropeanEngine::getBatchPrices);
+		})});
+		records.push_back({"AnalyticEuropeanEngine", "batch_parallel", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			executor.run(c.size(), [&](std::size_t begin, std::size_t end)
+			{
+				price_batch(c, begin, end, out, AnalyticEuropeanEngine::getBatchPrices);
+			});
+		})});
+		kernel_case("AnalyticEuropeanEngine", AnalyticEuropeanKernel{}, european);
+		// Homogeneous batches on kernels specialized at compile time: calls on
+		// stocks (b = r) and calls on futures (b = 0)
+		const std::vector<double> futures(c.size(), 0.0);
+		records.push_back({"BlackScholesKernel<Call,Stock>", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			BlackScholesKernel<Payoff::Call, CarryModel::Stock>::getBatchPrices(c.S, c.K, c.T, c.sigma, c.r, c.b, out);
+		})});
+		records.push_back({"BlackScholesKernel<Call,Futures>", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			BlackScholesKernel<Payoff::Call, CarryModel::Futures>::getBatchPrices(c.S, c.K, c.T, c.sigma, c.r, futures, out);
+		})});
+		// The same contracts in single precision
+		const std::vector<float> S(c.S.begin(), c.S.end()), K(c.K.begin(), c.K.end()), T(c.T.begin(), c.T.end()),
+			sigma(c.sigma.begin(), c.sigma.end()), r(c.r.begin(), c.r.end()), b(c.b.begin(), c.b.end());
+		std::vector<float> price(c.size());
+		std::vector<FloatGreeks> greeks(c.size());
+		records.push_back({"AnalyticEuropeanEngine", "batch_float", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			AnalyticEuropeanEngine::getBatchPrices(S, K, T, sigma, r, b, c.type, price);
+		})});
+		records.push_back({"AnalyticEuropeanEngine", "batch_all_float", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			AnalyticEuropeanEngine::getBatchAll(S, K, T, sigma, r, b, c.type, greeks);
+		})});
+
+		// NumericalEuropeanEngine delta by forward-mode automatic differentiation
+		scalar_and_parallel("NumericalEuropeanEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; i++)
+			{
+				const NumericalEuropeanEngine engine(c.S[i], c.sigma[i], c.r[i], c.b[i]);
+				out[i] = engine.getEngineDelta(c.european[i]);
+			}
+		});
+		// Price and all Greeks from one differentiated pass, in both modes
+		for (DifferentiationMode mode : {ForwardMode, AdjointMode})
+		{
+			records.push_back({"NumericalEuropeanEngine", (mode == ForwardMode) ? "all_forward" : "all_adjoint",
+							   c.size(), measure(c.size(), minSeconds, [&]()
+			{
+				for (std::size_t i = 0; i < c.size(); i++)
+				{
+					const NumericalEuropeanEngine engine(c.S[i], c.sigma[i], c.r[i], c.b[i], mode);
+					out[i] = engine.getEngineAll(c.european[i]).gamma;
+				}
+			})});
+		}
+
+		scalar_and_parallel("AnalyticAmericanPerpetualEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<AnalyticAmericanPerpetualEngine>(c, c.american, begin, end, out);
+		});
+		kernel_case("AnalyticAmericanPerpetualEngine", AnalyticAmericanPerpetualKernel{}, american);
+		// Strike ladder under one sigma, r and b, the exponents are computed once
+		records.push_back({"AnalyticAmericanPerpetualEngine", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			const AnalyticAmericanPerpetualEngine engine(100.0, 0.2, 0.05, 0.02);
+			engine.getBatchPrices(c.S, c.K, c.type, out);
+		})});
+
+		scalar_and_parallel("BaroneAdesiWhaleyEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<BaroneAdesiWhaleyEngine>(c, c.american, begin, end, out);
+		});
+		kernel_case("BaroneAdesiWhaleyEngine", BaroneAdesiWhaleyKernel{}, american);
+		records.push_back({"BaroneAdesiWhaleyEngine", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			price_batch(c, 0, c.size(), out, BaroneAdesiWhaleyEngine::getBatchPrices);
+		})});
+
+		scalar_and_parallel("BjerksundStenslandEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<BjerksundStenslandEngine>(c, c.american, begin, end, out);
+		});
+		kernel_case("BjerksundStenslandEngine", BjerksundStenslandKernel{}, american);
+		records.push_back({"BjerksundStenslandEngine", "batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			price_batch(c, 0, c.size(), out, BjerksundStenslandEngine::getBatchPrices);
+		})});
+	}
+
+	/************************ Volatility surfaces ************************/
+	{
+		// Smile on the benchmark chain: a grid of 20 expiries x 17 moneyness nodes
+		// and an SVI slice per expiry, looked up per contract and fed to the batch
+		const Contracts c{make_contracts(1 << 16)};
+		std::vector<double> sigma(c.size()), out(c.size());
+		std::vector<double> expiries, moneyness, volatilities;
+		std::vector<SviSlice> slices;
+		for (std::size_t i = 0; i < 20; i++)
+		{
+			expiries.push_back(0.1 + 0.1 * static_cast<double>(i));
+			slices.push_back({expiries.back(), 0.02 * expiries.back(), 0.1, -0.4, 0.0, 0.2});
+		}
+		for (std::size_t j = 0; j < 17; j++)
+		{
+			moneyness.push_back(-0.8 + 0.1 * static_cast<double>(j));
+		}
+		for (double T : expiries)
+		{
+			for (double k : moneyness)
+			{
+				volatilities.push_back(0.2 - 0.1 * k + 0.05 * k * k + 0.01 * T);
+			}
+		}
+		const GridVolSurface grid(expiries, moneyness, volatilities);
+		const SviVolSurface svi(slices);
+
+		auto lookup_case = [&](const std::string& engine, const VolSurface& surface)
+		{
+			records.push_back({engine, "lookup", c.size(), measure(c.size(), minSeconds, [&]()
+			{
+				surface.getVolatilities(c.S, c.K, c.T, c.b, sigma);
+			})});
+		};
+		lookup_case("GridVolSurface", grid);
+		lookup_case("SviVolSurface", svi);
+
+		records.push_back({"AnalyticEuropeanEngine", "batch_surface", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			AnalyticEuropeanEngine::getBatchPrices(c.S, c.K, c.T, grid, c.r, c.b, c.type, out);
+		})});
+		records.push_back({"BaroneAdesiWhaleyEngine", "batch_surface", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			BaroneAdesiWhaleyEngine::getBatchPrices(c.S, c.K, c.T, grid, c.r, c.b, c.type, out);
+		})});
+	}
+
+	/************************ Yield curves ************************/
+	{
+		// Rates and dividend yields of each contract from curves: the batch with
+		// a DiscountCache of the chain's 20 expiries against the column batch
+		const Contracts c{make_contracts(1 << 16)};
+		std::vector<double> out(c.size());
+		auto rates = std::make_shared<const YieldCurve>(std::vector<double>{0.25, 1.0, 2.0}, std::vector<double>{0.02, 0.03, 0.035});
+		auto dividends = std::make_shared<const YieldCurve>(0.01);
+		const DiscountCache cache(rates, dividends, c.T);
+
+		records.push_back({"AnalyticEuropeanEngine", "batch_curves", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			AnalyticEuropeanEngine::getBatchPrices(c.S, c.K, c.T, c.sigma, cache, c.type, out);
+		})});
+		records.push_back({"DiscountCache", "build", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			const DiscountCache rebuilt(rates, dividends, c.T);
+		})});
+	}
+
+	/************************ Price cache ************************/
+	{
+		// The same options asked again under an unchanged market: every call
+		// prices with the engine, or all calls after the first are cache hits
+		const Contracts c{make_contracts(1 << 12)};
+		auto engine = std::make_shared<AnalyticEuropeanEngine>(100.0, 0.2, 0.05, 0.02);
+		auto cache = std::make_shared<PriceCache>(1 << 14);
+		std::vector<VanillaOption> options, cached;
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			options.emplace_back(c.european[i], engine);
+			cached.emplace_back(c.european[i], engine);
+			cached.back().setCache(cache);
+		}
+		std::vector<double> out(c.size());
+
+		records.push_back({"VanillaOption", "price", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			for (std::size_t i = 0; i < c.size(); i++)
+			{
+				out[i] = options[i].getPrice();
+			}
+		})});
+		records.push_back({"PriceCache", "price", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			for (std::size_t i = 0; i < c.size(); i++)
+			{
+				out[i] = cached[i].getPrice();
+			}
+		})});
+	}
+
+	/************************ Shared market state ************************/
+	{
+		// One engine per (sigma, r) pair reading a MarketState instead of one engine
+		// per contract, every run moves all spots and reprices the whole chain
+		const Contracts c{make_contracts(1 << 16)};
+		std::vector<double> out(c.size());
+		auto market = std::make_shared<MarketState>();
+		std::vector<std::size_t> underlying(c.size());
+		std::vector<std::shared_ptr<AnalyticEuropeanEngine>> engines;
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			std::size_t u = 0;
+			while (u < market->getUnderlyingCount() &&
+				   (market->getQuote(u).sigma != c.sigma[i] || market->getQuote(u).r != c.r[i]))
+			{
+				u++;
+			}
+			if (u == market->getUnderlyingCount())
+			{
+				market->addUnderlying({c.S[i], c.sigma[i], c.r[i], c.b[i]});
+				engines.push_back(std::make_shared<AnalyticEuropeanEngine>(market, u));
+			}
+			underlying[i] = u;
+		}
+
+		double spot{100.0};
+		records.push_back({"AnalyticEuropeanEngine", "market_state", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			spot = (spot > 101.0) ? 99.0 : spot + 0.01;
+			for (std::size_t u = 0; u < market->getUnderlyingCount(); u++)
+			{
+				market->setSpot(u, spot);
+			}
+			for (std::size_t i = 0; i < c.size(); i++)
+			{
+				out[i] = engines[underlying[i]]->getEnginePrice(c.european[i]);
+			}
+		})});
+	}
+
+	/************************ Contract book file ************************/
+	{
+		// Opening maps the file, so its cost per contract falls with the book size
+		const Contracts c{make_contracts(1 << 20)};
+		std::vector<double> out(c.size());
+		std::vector<Payoff::Exercise> exercise(c.size(), Payoff::European);
+		const std::string path{(std::filesystem::temp_directory_path() / "option_pricing_bench.book").string()};
+		ContractBook::write(path, c.S, c.K, c.T, c.sigma, c.r, c.b, c.type, exercise);
+
+		records.push_back({"ContractBook", "open", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			const ContractBook book(path);
+			out[0] = static_cast<double>(book.getCount());
+		})});
+		const ContractBook book(path);
+		records.push_back({"ContractBook", "mapped_batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			AnalyticEuropeanEngine::getBatchPrices(book.getSpots(), book.getStrikes(), book.getMaturities(),
+												   book.getVolatilities(), book.getRates(), book.getCarries(),
+												   book.getTypes(), out);
+		})});
+		std::filesystem::remove(path);
+	}
+
+	/************************ Portfolio risk ************************/
+	{
+		// 1M positions on 100 underlyings, one in ten American
+		const Contracts c{make_contracts(1 << 20)};
+		Portfolio portfolio;
+		portfolio.reserve(c.size());
+		std::vector<MarketQuote> quotes;
+		for (std::size_t u = 0; u < 100; u++)
+		{
+			quotes.push_back({90.0 + 0.2 * static_cast<double>(u), 0.2, 0.03, 0.03});
+		}
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			const Payoff& payoff = (i % 10 == 0) ? *c.american[i] : *c.european[i];
+			portfolio.addPosition(Contract::fromPayoff(payoff), static_cast<double>(i % 7) - 3.0, i % 100);
+		}
+
+		records.push_back({"Portfolio", "risk", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			portfolio.getRisk(quotes, 1);
+		})});
+		records.push_back({"Portfolio", "risk_parallel", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			portfolio.getRisk(quotes, threads);
+		})});
+	}
+
+	/************************ Scenario grid ************************/
+	{
+		// 21 x 11 spot and volatility shocks on 4096 European positions, reported
+		// per position and scenario
+		const Contracts c{make_contracts(4096)};
+		Portfolio portfolio;
+		std::vector<MarketQuote> quotes;
+		for (std::size_t u = 0; u < 16; u++)
+		{
+			quotes.push_back({95.0 + 0.5 * static_cast<double>(u), 0.2, 0.03, 0.03});
+		}
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			portfolio.addPosition(Contract::fromPayoff(*c.european[i]), static_cast<double>(i % 7) - 3.0, i % 16);
+		}
+		const std::vector<double> spotShocks{ScenarioEngine::makeLadder(0.1, 21)};
+		const std::vector<double> volShocks{ScenarioEngine::makeLadder(0.05, 11)};
+		const ScenarioEngine scenarios(spotShocks, volShocks, 1);
+		const ScenarioEngine parallelScenarios(spotShocks, volShocks, threads);
+		const std::size_t evaluations{c.size() * scenarios.getScenarioCount()};
+
+		records.push_back({"ScenarioEngine", "positions", evaluations, measure(evaluations, minSeconds, [&]()
+		{
+			scenarios.getPositionPnL(portfolio, quotes);
+		})});
+		records.push_back({"ScenarioEngine", "positions_parallel", evaluations, measure(evaluations, minSeconds, [&]()
+		{
+			parallelScenarios.getPositionPnL(portfolio, quotes);
+		})});
+		records.push_back({"ScenarioEngine", "underlyings_parallel", evaluations, measure(evaluations, minSeconds, [&]()
+		{
+			parallelScenarios.getUnderlyingPnL(portfolio, quotes);
+		})});
+	}
+
+	/************************ Spot ticks ************************/
+	{
+		// One underlying with the whole chain, and 100 underlyings ticking together
+		const Contracts c{make_contracts(100000)};
+		LiveBook single;
+		LiveBook threaded(0);
+		LiveBook singleFloat(1, LiveBook::Single);
+		LiveBook multiple;
+		const std::size_t underlying{single.addUnderlying(100.0)};
+		threaded.addUnderlying(100.0);
+		singleFloat.addUnderlying(100.0);
+		std::vector<std::size_t> underlyings;
+		for (std::size_t u = 0; u < 100; u++)
+		{
+			underlyings.push_back(multiple.addUnderlying(100.0));
+		}
+		for (std::size_t i = 0; i < c.size(); i++)
+		{
+			single.addContract(underlying, c.K[i], c.T[i], c.sigma[i], c.r[i], c.b[i], c.type[i]);
+			threaded.addContract(underlying, c.K[i], c.T[i], c.sigma[i], c.r[i], c.b[i], c.type[i]);
+			singleFloat.addContract(underlying, c.K[i], c.T[i], c.sigma[i], c.r[i], c.b[i], c.type[i]);
+			multiple.addContract(underlyings[i % 100], c.K[i], c.T[i], c.sigma[i], c.r[i], c.b[i], c.type[i]);
+		}
+
+		double spot{100.0};
+		records.push_back({"LiveBook", "tick", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			spot = (spot > 101.0) ? 99.0 : spot + 0.01;
+			single.updateSpot(underlying, spot);
+		})});
+		records.push_back({"LiveBook", "tick_threads", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			spot = (spot > 101.0) ? 99.0 : spot + 0.01;
+			threaded.updateSpot(underlying, spot);
+		})});
+		records.push_back({"LiveBook", "tick_float", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			spot = (spot > 101.0) ? 99.0 : spot + 0.01;
+			singleFloat.updateSpot(underlying, spot);
+		})});
+		std::vector<double> spots(underlyings.size());
+		records.push_back({"LiveBook", "tick_batch", c.size(), measure(c.size(), minSeconds, [&]()
+		{
+			spot = (spot > 101.0) ? 99.0 : spot + 0.01;
+			std::fill(spots.begin(), spots.end(), spot);
+			multiple.updateSpots(underlyings, spots);
+		})});
+	}
+
+	/************************ Numerical engines ************************/
+	{
+		const Contracts c{make_contracts(64)};
+		std::vector<double> out(c.size());
+
+		scalar_and_parallel("LatticeEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<LatticeEngine>(c, c.american, begin, end, out, std::size_t{200},
+										LatticeEngine::Binomial, LatticeEngine::BBSR);
+		});
+		scalar_and_parallel("FiniteDifferenceEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<FiniteDifferenceEngine>(c, c.american, begin, end, out, std::size_t{200}, std::size_t{100});
+		});
+		scalar_and_parallel("MonteCarloEuropeanEngine", c.size(), [&](std::size_t begin, std::size_t end)
+		{
+			price_scalar<MonteCarloEuropeanEngine>(c, c.european, begin, end, out, std::size_t{1} << 14);
+		});
+	}
+
+	/************************ Helper_functions sweeps ************************/
+	for (double step : {0.05, 0.02, 0.01})
+	{
+		// Expiry, volatility and rate axes of about 1/step points each
+		const std::vector<double> expiry{create_mesh(0.1, 1.0, step)};
+		const std::vector<double> volatility{create_mesh(0.1, 0.6, step / 2)};
+		const std::vector<double> rate{create_mesh(0.0, 0.1, step / 10)};
+		const std::size_t contracts{expiry.size() * volatility.size() * rate.size()};
+
+		records.push_back({"create_mesh_matrix+compute_option_prices", "sweep", contracts,
+						   measure(contracts, minSeconds, [&]()
+		{
+			const auto matrix = create_mesh_matrix(100.0, 100.0, expiry, volatility, rate);
+			const auto prices = compute_option_prices(matrix, Payoff::Call, "price");
+		})});
+		records.push_back({"create_mesh_matrix+compute_option_prices", "parallel", contracts,
+						   measure(contracts, minSeconds, [&]()
+		{
+			const auto matrix = create_mesh_matrix(100.0, 100.0, expiry, volatility, rate);
+			const auto prices = compute_option_prices(matrix, Payoff::Call, "price", executor);
+		})});
+	}
+
+	/************************ Result sinks ************************/
+	{
+		// Rows of a sweep written to a temporary file, per row
+		const std::vector<double> expiry{create_mesh(0.1, 1.0, 0.01)};
+		const std::vector<double> volatility{create_mesh(0.1, 0.6, 0.005)};
+		const std::vector<double> rate{create_mesh(0.0, 0.1, 0.01)};
+		const auto rows = compute_option_prices(create_mesh_matrix(100.0, 100.0, expiry, volatility, rate),
+												Payoff::Call, "price", executor);
+		const std::string path{(std::filesystem::temp_directory_path() / "option_pricing_bench.out").string()};
+
+		records.push_back({"CsvResultSink", "write", rows.size(), measure(rows.size(), minSeconds, [&]()
+		{
+			CsvResultSink sink(path, option_price_columns());
+			print_option_prices(rows, sink);
+			sink.flush();
+		})});
+		records.push_back({"BinaryResultSink", "write", rows.size(), measure(rows.size(), minSeconds, [&]()
+		{
+			BinaryResultSink sink(path, option_price_columns());
+			print_option_prices(rows, sink);
+			sink.flush();
+		})});
+		// Rows handed to the background writer, waiting for it at the end of each run
+		AsyncResultSink async(std::make_unique<CsvResultSink>(path, option_price_columns()));
+		records.push_back({"AsyncResultSink", "write", rows.size(), measure(rows.size(), minSeconds, [&]()
+		{
+			print_option_prices(rows, async);
+			async.flush();
+		})});
+		std::filesystem::remove(path);
+	}
+
+	print_json(records, threads, minSeconds);
+
+	return 0;
+}
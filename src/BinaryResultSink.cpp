@@ -0,0 +1,162 @@
+// Implementation of the header file BinaryResultSink.hpp
+
+#include "BinaryResultSink.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		constexpr char magic[8] = {'O', 'P', 'T', 'R', 'S', 'L', 'T', '\0'};
+		constexpr std::uint32_t byte_order_mark{0x01020304};
+
+		// Write the bytes of a value
+		template <typename T>
+		void put(std::ofstream& file, const T& value)
+		{
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+
+		// Read the bytes of a value, false at the end of the file
+		template <typename T>
+		bool get(std::ifstream& file, T& value)
+		{
+			return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+		}
+	}
+
+	/// @brief Default constructor, creates the file and writes the header
+	/// @param path output file
+	/// @param columns column names
+	/// @param blockRows rows collected before a block is written
+	BinaryResultSink::BinaryResultSink(const std::string& path, const std::vector<std::string>& columns,
+									   std::size_t blockRows)
+	: ResultSink{columns}, _file{path, std::ios::binary | std::ios::trunc}, _blockRows{std::max<std::size_t>(blockRows, 1)},
+	  _block(columns.size())
+	{
+		if (!_file)
+		{
+			throw IncorrectInputException("Cannot write results to " + path + ".");
+		}
+
+		_file.write(magic, sizeof(magic));
+		put(_file, version);
+		put(_file, byte_order_mark);
+		put(_file, static_cast<std::uint32_t>(_columns.size()));
+		put(_file, std::uint32_t{0});
+		for (const std::string& name : _columns)
+		{
+			put(_file, static_cast<std::uint32_t>(name.size()));
+			_file.write(name.data(), static_cast<std::streamsize>(name.size()));
+		}
+		for (std::vector<double>& column : _block)
+		{
+			column.reserve(_blockRows);
+		}
+	}
+
+	/// @brief Destructor, writes the last block
+	BinaryResultSink::~BinaryResultSink()
+	{
+		writeBlock();
+		_file.flush();
+	}
+
+	/// @brief write the current block, nothing if it is empty
+	void BinaryResultSink::writeBlock()
+	{
+		const std::uint64_t rows{_block.front().size()};
+		if (rows == 0)
+		{
+			return;
+		}
+
+		put(_file, rows);
+		for (std::vector<double>& column : _block)
+		{
+			_file.write(reinterpret_cast<const char*>(column.data()), static_cast<std::streamsize>(rows * sizeof(double)));
+			column.clear();
+		}
+	}
+
+	/// @brief add rows to the current block, a full block is written
+	/// @param values row after row of values
+	void BinaryResultSink::write(std::span<const double> values)
+	{
+		const std::size_t rows{getRowCount(values)};
+		const std::size_t columns{_columns.size()};
+		for (std::size_t row = 0; row < rows; row++)
+		{
+			for (std::size_t column = 0; column < columns; column++)
+			{
+				_block[column].push_back(values[row * columns + column]);
+			}
+			if (_block.front().size() == _blockRows)
+			{
+				writeBlock();
+			}
+		}
+	}
+
+	/// @brief write the current block and flush the file
+	void BinaryResultSink::flush()
+	{
+		writeBlock();
+		_file.flush();
+		if (!_file)
+		{
+			throw IncorrectInputException("Cannot write results.");
+		}
+	}
+
+	/// @brief read a file written by BinaryResultSink
+	/// @param path input file
+	/// @param columns set to the column names
+	/// @return values of each column
+	std::vector<std::vector<double>> BinaryResultSink::read(const std::string& path, std::vector<std::string>& columns)
+	{
+		std::ifstream file(path, std::ios::binary);
+		char fileMagic[sizeof(magic)] = {};
+		std::uint32_t fileVersion{};
+		std::uint32_t order{};
+		std::uint32_t count{};
+		std::uint32_t reserved{};
+		if (!file.read(fileMagic, sizeof(fileMagic)) || std::memcmp(fileMagic, magic, sizeof(magic)) != 0 ||
+			!get(file, fileVersion) || fileVersion != version || !get(file, order) || order != byte_order_mark ||
+			!get(file, count) || !get(file, reserved))
+		{
+			throw IncorrectInputException("Results file " + path + " is not a supported binary result file.");
+		}
+
+		columns.assign(count, std::string{});
+		for (std::string& name : columns)
+		{
+			std::uint32_t length{};
+			if (!get(file, length))
+			{
+				throw IncorrectInputException("Results file " + path + " is truncated.");
+			}
+			name.resize(length);
+			file.read(name.data(), length);
+		}
+
+		std::vector<std::vector<double>> values(count);
+		std::uint64_t rows{};
+		while (get(file, rows))
+		{
+			for (std::vector<double>& column : values)
+			{
+				const std::size_t start{column.size()};
+				column.resize(start + rows);
+				if (!file.read(reinterpret_cast<char*>(column.data() + start), static_cast<std::streamsize>(rows * sizeof(double))))
+				{
+					throw IncorrectInputException("Results file " + path + " is truncated.");
+				}
+			}
+		}
+
+		return values;
+	}
+}
@@ -0,0 +1,51 @@
+// Result sink writing a compact binary columnar file. Rows are collected
+// into blocks; each block is written as its row count followed by the
+// values of every column of the block, so a reader can load one column
+// without touching the others and no text is formatted.
+//
+// Layout, little-endian, version 1:
+//   magic "OPTRSLT\0", uint32 version, uint32 byte order mark 0x01020304,
+//   uint32 number of columns, uint32 reserved,
+//   per column: uint32 name length and the name,
+//   per block: uint64 rows and rows doubles of each column in turn
+
+#ifndef BINARYRESULTSINK_HPP
+#define BINARYRESULTSINK_HPP
+
+#include "ResultSink.hpp"
+
+#include <cstdint>
+#include <fstream>
+
+namespace PricingLibrary {
+
+	class BinaryResultSink : public ResultSink
+	{
+	private:
+		std::ofstream _file;                 // output file
+		std::size_t _blockRows;              // rows per block
+		std::vector<std::vector<double>> _block; // values of the current block, per column
+
+		// Write the current block
+		void writeBlock();
+
+	public:
+		using ResultSink::write;
+
+		static constexpr std::uint32_t version{1}; // format version written and read
+
+		BinaryResultSink(const std::string& path, const std::vector<std::string>& columns,
+						 std::size_t blockRows=1 << 16); // default constructor
+		~BinaryResultSink(); // destructor, flushes
+
+		// Add rows to the current block, full blocks are written
+		void write(std::span<const double> values) override;
+		// Write the current block and flush the file
+		void flush() override;
+
+		// Read a file, returns the values of each column and sets the column names
+		static std::vector<std::vector<double>> read(const std::string& path, std::vector<std::string>& columns);
+	};
+}
+
+#endif
@@ -0,0 +1,280 @@
+// Implementation of the header file BjerksundStenslandEngine.hpp
+
+#include "BjerksundStenslandEngine.hpp"
+#include "StandardNormal.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Exponent beta of the perpetual call, NaN if it does not exist
+		double beta(double sigma, double r, double b)
+		{
+			const double s2 = sigma * sigma;
+			return (0.5 - b / s2) + std::sqrt((b / s2 - 0.5) * (b / s2 - 0.5) + 2 * r / s2);
+		}
+
+		// Function phi(S, T, gamma, H, I) of Bjerksund and Stensland
+		double phi(double S, double T, double gamma, double H, double I, double sigma, double r, double b)
+		{
+			const double sigma_sqrt_T = sigma * std::sqrt(T);
+			const double lambda = (-r + gamma * b + 0.5 * gamma * (gamma - 1) * sigma * sigma) * T;
+			const double d = -(std::log(S / H) + (b + (gamma - 0.5) * sigma * sigma) * T) / sigma_sqrt_T;
+			const double kappa = 2 * b / (sigma * sigma) + (2 * gamma - 1);
+
+			return std::exp(lambda) * std::pow(S, gamma)
+				 * (StandardNormal::cdf(d) - std::pow(I / S, kappa) * StandardNormal::cdf(d - 2 * std::log(I / S) / sigma_sqrt_T));
+		}
+
+		// Black-Scholes call price
+		double blackScholesCall(double S, double K, double T, double sigma, double r, double b)
+		{
+			const double d1 = (std::log(S / K) + (b + sigma * sigma / 2) * T) / (sigma * std::sqrt(T));
+			const double d2 = d1 - sigma * std::sqrt(T);
+
+			return S * std::exp((b - r) * T) * StandardNormal::cdf(d1) - K * std::exp(-r * T) * StandardNormal::cdf(d2);
+		}
+	}
+
+	/// @brief Default constructor
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	BjerksundStenslandEngine::BjerksundStenslandEngine(double S, double sigma, double r, double b)
+	: BjerksundStenslandEngine(S, MarketInputs(sigma, r, b)) {}
+
+	/// @brief Construct on the volatility, rate and cost of carry of inputs
+	/// @param S underlying price
+	/// @param inputs scalars, volatility surface or yield curves
+	BjerksundStenslandEngine::BjerksundStenslandEngine(double S, const MarketInputs& inputs)
+	: _S{S}, _inputs{inputs} {}
+
+	/// @brief Construct on a volatility surface, the volatility of each option
+	/// is read from the surface at its strike and maturity
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	BjerksundStenslandEngine::BjerksundStenslandEngine(double S, const std::shared_ptr<const VolSurface>& surface, double r, double b)
+	: BjerksundStenslandEngine(S, MarketInputs(surface, r, b)) {}
+
+	/// @brief Construct on yield curves, the rate and cost of carry of each
+	/// option are read from the curves at its maturity, b = r - q
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	BjerksundStenslandEngine::BjerksundStenslandEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+														   const std::shared_ptr<const YieldCurve>& dividends)
+	: BjerksundStenslandEngine(S, MarketInputs(sigma, rates, dividends)) {}
+
+	/// @brief Construct on a volatility surface and yield curves
+	/// @param S underlying price
+	/// @param surface volatility surface
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	BjerksundStenslandEngine::BjerksundStenslandEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+														   const std::shared_ptr<const YieldCurve>& rates,
+														   const std::shared_ptr<const YieldCurve>& dividends)
+	: BjerksundStenslandEngine(S, MarketInputs(surface, rates, dividends)) {}
+
+	/// @brief Copy constructor
+	/// @param source BjerksundStenslandEngine object
+	BjerksundStenslandEngine::BjerksundStenslandEngine(const BjerksundStenslandEngine& source)
+	: PricingEngine{source}, _S{source._S}, _inputs{source._inputs}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source BjerksundStenslandEngine object
+	/// @return BjerksundStenslandEngine object
+	BjerksundStenslandEngine& BjerksundStenslandEngine::operator= (const BjerksundStenslandEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		PricingEngine::operator=(source);
+		_S = source._S;
+		_inputs = source._inputs;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	BjerksundStenslandEngine::~BjerksundStenslandEngine() {}
+
+	/// @brief Validate if engine was passed to a correct option
+	/// @param exercise American or European
+	void BjerksundStenslandEngine::validate(const Payoff::Exercise& exercise) const
+	{
+		if (exercise != Payoff::American)
+		{
+			throw IncorrectEngineException("Only American options have Bjerksund and Stensland approximation.");
+		}
+	}
+
+	/// @brief flat exercise boundary of the call
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @return trigger price, infinity if early exercise is never optimal
+	double BjerksundStenslandEngine::getTriggerPrice(double K, double T, double sigma, double r, double b)
+	{
+		const double B = beta(sigma, r, b);
+		if (b >= r || !(B > 1.0))
+		{
+			return std::numeric_limits<double>::infinity();
+		}
+
+		const double B_inf = B / (B - 1) * K;
+		const double B_0 = std::max(K, r / (r - b) * K);
+		const double h = -(b * T + 2 * sigma * std::sqrt(T)) * B_0 / (B_inf - B_0);
+
+		return B_0 + (B_inf - B_0) * (1 - std::exp(h));
+	}
+
+	/// @brief call price from the trigger price
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param trigger trigger price
+	/// @return price
+	double BjerksundStenslandEngine::getCallApproximation(double S, double K, double T, double sigma, double r, double b,
+														 double trigger)
+	{
+		if (std::isinf(trigger))
+		{
+			return blackScholesCall(S, K, T, sigma, r, b);
+		}
+		if (S >= trigger)
+		{
+			return S - K;
+		}
+
+		const double B = beta(sigma, r, b);
+		const double I = trigger;
+		const double alpha = (I - K) * std::pow(I, -B);
+
+		return alpha * std::pow(S, B) - alpha * phi(S, T, B, I, I, sigma, r, b)
+			 + phi(S, T, 1, I, I, sigma, r, b) - phi(S, T, 1, K, I, sigma, r, b)
+			 - K * phi(S, T, 0, I, I, sigma, r, b) + K * phi(S, T, 0, K, I, sigma, r, b);
+	}
+
+	/// @brief american price, puts are priced through the put-call
+	/// transformation P(S, K, T, r, b) = C(K, S, T, r - b, -b)
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type call or put
+	/// @return price
+	double BjerksundStenslandEngine::getAmericanPrice(double S, double K, double T, double sigma, double r, double b,
+													  Payoff::Type type)
+	{
+		if (type == Payoff::Type::Call)
+		{
+			return getCallApproximation(S, K, T, sigma, r, b, getTriggerPrice(K, T, sigma, r, b));
+		}
+		return getCallApproximation(K, S, T, sigma, r - b, -b, getTriggerPrice(S, T, sigma, r - b, -b));
+	}
+
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double BjerksundStenslandEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		validate(payoff->getExercise());
+
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const MarketQuote quote{_inputs.resolve(_S, K, T)};
+
+		return getAmericanPrice(quote.S, K, T, quote.sigma, quote.r, quote.b, payoff->getType());
+	}
+
+	/// @brief price a batch of American options
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void BjerksundStenslandEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+												  std::span<const double> T, std::span<const double> sigma,
+												  std::span<const double> r, std::span<const double> b,
+												  std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		const std::size_t n{S.size()};
+		if (K.size() != n || T.size() != n || sigma.size() != n || r.size() != n || b.size() != n ||
+			type.size() != n || price.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			price[i] = getAmericanPrice(S[i], K[i], T[i], sigma[i], r[i], b[i], type[i]);
+		}
+	}
+
+	/*! \warning Not implemented calculation of Delta greek */
+	double BjerksundStenslandEngine::getEngineDelta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Gamma greek */
+	double BjerksundStenslandEngine::getEngineGamma(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Theta greek */
+	double BjerksundStenslandEngine::getEngineTheta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Vega greek */
+	double BjerksundStenslandEngine::getEngineVega(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/// @brief price a batch of American options with the volatility of each
+	/// contract read from a surface, then priced as by the batch with volatilities
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param surface volatility surface
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param price output prices
+	void BjerksundStenslandEngine::getBatchPrices(std::span<const double> S, std::span<const double> K,
+								std::span<const double> T, const VolSurface& surface,
+								std::span<const double> r, std::span<const double> b,
+								std::span<const Payoff::Type> type, std::span<double> price)
+	{
+		std::vector<double> sigma(price.size());
+		surface.getVolatilities(S, K, T, b, sigma);
+		getBatchPrices(S, K, T, sigma, r, b, type, price);
+	}
+}
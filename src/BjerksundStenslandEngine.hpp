@@ -0,0 +1,73 @@
+// Define engine to price american options of finite maturity with the
+// flat exercise boundary approximation of Bjerksund and Stensland (1993).
+// The trigger price is in closed form, so no iteration is needed; puts are
+// priced as calls through the put-call transformation.
+
+#ifndef BJERKSUNDSTENSLANDENGINE_HPP
+#define BJERKSUNDSTENSLANDENGINE_HPP
+
+#include "PricingEngine.hpp"
+#include "MarketInputs.hpp"
+#include "EngineException.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <span>
+
+namespace PricingLibrary {
+
+	class BjerksundStenslandEngine : public PricingEngine
+	{
+	private:
+		double _S;             // underlying price
+		MarketInputs _inputs;  // volatility, rate and cost of carry
+
+		// Call price from the trigger price
+		static double getCallApproximation(double S, double K, double T, double sigma, double r, double b,
+										   double trigger);
+
+	public:
+		BjerksundStenslandEngine(double S, double sigma, double r, double b); // default constructor
+		// construct on the volatility, rate and carry of inputs
+		BjerksundStenslandEngine(double S, const MarketInputs& inputs);
+		// construct on a volatility surface in place of the volatility
+		BjerksundStenslandEngine(double S, const std::shared_ptr<const VolSurface>& surface, double r, double b);
+		// construct on rate and dividend yield curves in place of r and b
+		BjerksundStenslandEngine(double S, double sigma, const std::shared_ptr<const YieldCurve>& rates,
+								 const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		BjerksundStenslandEngine(double S, const std::shared_ptr<const VolSurface>& surface,
+								 const std::shared_ptr<const YieldCurve>& rates,
+								 const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		BjerksundStenslandEngine(const BjerksundStenslandEngine& source); // copy constructor
+		BjerksundStenslandEngine& operator= (const BjerksundStenslandEngine& source); // copy assignment
+		~BjerksundStenslandEngine(); // destructor
+
+		// Get option price
+		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
+		// Not implemented calculation of greeks
+		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		// Validate if engine was passed to a correct option
+		void validate(const Payoff::Exercise& exercise) const override;
+
+		// Call or put price of one contract
+		static double getAmericanPrice(double S, double K, double T, double sigma, double r, double b,
+									   Payoff::Type type);
+		// Flat exercise boundary of the call, infinity if early exercise is never optimal
+		static double getTriggerPrice(double K, double T, double sigma, double r, double b);
+		// Price a batch of American options stored as contiguous columns
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, std::span<const double> sigma,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+		// Price a batch of American options with volatilities from a surface
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, const VolSurface& surface,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<const Payoff::Type> type, std::span<double> price);
+	};
+}
+
+#endif
@@ -0,0 +1,294 @@
+// Black-Scholes prices and Greeks of European options specialized at compile
+// time on the option type and the cost-of-carry model. The generalized
+// formula with cost of carry b covers every model listed in Main.cpp:
+// - CarryModel::Stock, b = r: the carry factor exp((b - r)T) is 1
+// - CarryModel::Futures, b = 0: the carry factor is the discount factor
+// - CarryModel::General, any b, e.g. b = r - q (Merton) or b = r - R
+//   (Garman and Kohlhagen)
+// Each combination is its own type, so the type and model branches of the
+// general formula are resolved by the compiler. A batch of contracts of one
+// type and model runs without branches, with the normal distribution on the
+// SIMD batch kernels. BlackScholesKernels::visit picks the combination of one
+// contract at runtime; AnalyticEuropeanKernel prices through it, so every
+// combination gives the values of the general formula, put price from
+// put-call parity included.
+
+#ifndef BLACKSCHOLESKERNEL_HPP
+#define BLACKSCHOLESKERNEL_HPP
+
+#include "Payoff.hpp"
+#include "Greeks.hpp"
+#include "StandardNormal.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace PricingLibrary {
+
+	// Cost-of-carry model of the generalized Black-Scholes formula
+	enum class CarryModel {General=0, Stock=1, Futures=2};
+
+	namespace BlackScholesKernels
+	{
+		/// @brief put price from the call price by put-call parity, the put
+		/// convention of every analytic European price in the library
+		/// @param call call price
+		/// @param S underlying price
+		/// @param discountedStrike K exp(-rT)
+		/// @return put price
+		inline double getPutFromCall(double call, double S, double discountedStrike)
+		{
+			return call - S + discountedStrike;
+		}
+	}
+
+	template <Payoff::Type type, CarryModel model>
+	struct BlackScholesKernel
+	{
+		static constexpr bool isCall{type == Payoff::Call};
+
+		/// @brief cost of carry of the model
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter, read by the general model only
+		/// @return r for stock options, 0 for futures options, b otherwise
+		static double getCarry(double r, double b)
+		{
+			if constexpr (model == CarryModel::Stock)
+			{
+				return r;
+			}
+			else if constexpr (model == CarryModel::Futures)
+			{
+				return 0.0;
+			}
+			else
+			{
+				return b;
+			}
+		}
+
+		/// @brief carry factor exp((b - r)T) from the discount factor
+		/// @param df discount factor exp(-rT)
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @param T maturity
+		/// @return carry factor
+		static double getCarryFactor(double df, double r, double b, double T)
+		{
+			if constexpr (model == CarryModel::Stock)
+			{
+				return 1.0;
+			}
+			else if constexpr (model == CarryModel::Futures)
+			{
+				return df;
+			}
+			else
+			{
+				return std::exp( (b - r) * T );
+			}
+		}
+
+		/// @brief option price, put price from put-call parity
+		/// @param S underlying price
+		/// @param K strike price
+		/// @param T maturity
+		/// @param sigma volatility
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @return price
+		static double getPrice(double S, double K, double T, double sigma, double r, double b)
+		{
+			const double d1 = ( std::log(S / K) + (getCarry(r, b) + sigma * sigma / 2) * T ) / (sigma * std::sqrt(T));
+			const double d2 = d1 - sigma * std::sqrt(T);
+			const double df = std::exp(-r * T);
+			const double call = S * getCarryFactor(df, r, b, T) * StandardNormal::cdf(d1) - K * df * StandardNormal::cdf(d2);
+
+			if constexpr (isCall)
+			{
+				return call;
+			}
+			else
+			{
+				return BlackScholesKernels::getPutFromCall(call, S, K * df);
+			}
+		}
+
+		/// @brief price and Greeks selected by mask from shared intermediate results
+		/// @param S underlying price
+		/// @param K strike price
+		/// @param T maturity
+		/// @param sigma volatility
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @param mask combination of Greeks::Mask flags
+		/// @return Greeks
+		static Greeks getAll(double S, double K, double T, double sigma, double r, double b, unsigned mask=Greeks::All)
+		{
+			const double carryRate = getCarry(r, b);
+			const double sqrt_T = std::sqrt(T);
+			const double d1 = ( std::log(S / K) + (carryRate + sigma * sigma / 2) * T ) / (sigma * sqrt_T);
+			const double d2 = d1 - sigma * sqrt_T;
+			const double df = std::exp(-r * T);
+			const double carry = getCarryFactor(df, r, b, T);
+			// The futures option model has its own rho, which needs the call price
+			const bool futuresRho = (model == CarryModel::Futures) || carryRate == 0.0;
+
+			const bool needCall = (mask & Greeks::Price) || ((mask & Greeks::Rho) && futuresRho);
+			const bool needDensity = mask & (Greeks::Gamma | Greeks::Vega | Greeks::Theta);
+			// N(d1), N(d2) for calls and N(-d1), N(-d2) for puts, as used by delta and theta
+			const bool needSignedCdf = (mask & (Greeks::Delta | Greeks::Theta | Greeks::Rho)) || (needCall && isCall);
+
+			const double n_d1 = needDensity ? StandardNormal::pdf(d1) : 0.0;
+			const double N_d1 = needSignedCdf ? StandardNormal::cdf(isCall ? d1 : -d1) : 0.0;
+			const double N_d2 = needSignedCdf ? StandardNormal::cdf(isCall ? d2 : -d2) : 0.0;
+
+			Greeks result;
+			double call{};
+			if (needCall)
+			{
+				if constexpr (isCall)
+				{
+					call = S * carry * N_d1 - K * df * N_d2;
+				}
+				else
+				{
+					call = S * carry * StandardNormal::cdf(d1) - K * df * StandardNormal::cdf(d2);
+				}
+			}
+			if (mask & Greeks::Price)
+			{
+				result.price = isCall ? call : BlackScholesKernels::getPutFromCall(call, S, K * df);
+			}
+			if (mask & Greeks::Delta)
+			{
+				result.delta = isCall ? carry * N_d1 : -(carry * N_d1);
+			}
+			if (mask & Greeks::Gamma)
+			{
+				result.gamma = n_d1 * carry / (S * sigma * sqrt_T);
+			}
+			if (mask & Greeks::Vega)
+			{
+				result.vega = S * sqrt_T * carry * n_d1 / 100; // divide by 100 to covert from percentage to raw
+			}
+			if (mask & Greeks::Theta)
+			{
+				const double decay = -(S * sigma * carry * n_d1) / (2 * sqrt_T);
+				// No drift term in the stock option model, b - r = 0
+				const double drift = (model == CarryModel::Stock) ? 0.0 : (carryRate - r) * S * carry * N_d1;
+				result.theta = isCall ? decay - drift - r * K * df * N_d2
+									  : decay + drift + r * K * df * N_d2;
+			}
+			if (mask & Greeks::Rho)
+			{
+				if (futuresRho)
+				{
+					// Futures option model: call depends on r only through discounting,
+					// put adds the derivative of the discounted strike from put-call parity
+					result.rho = isCall ? -T * call : -T * call - T * K * df;
+				}
+				else
+				{
+					result.rho = isCall ? T * K * df * N_d2 : -T * K * df * N_d2;
+				}
+			}
+
+			return result;
+		}
+
+		/// @brief price a batch of options of this type and model stored as
+		/// contiguous columns. The loops have no branches; the stock and futures
+		/// models evaluate one exponential per contract instead of two
+		/// @param S underlying prices
+		/// @param K strike prices
+		/// @param T maturities
+		/// @param sigma volatilities
+		/// @param r risk-free rates
+		/// @param b cost-of-carry parameters, read by the general model only
+		/// @param price output prices
+		static void getBatchPrices(std::span<const double> S, std::span<const double> K,
+								   std::span<const double> T, std::span<const double> sigma,
+								   std::span<const double> r, std::span<const double> b,
+								   std::span<double> price)
+		{
+			const std::size_t n{price.size()};
+			if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n || r.size() != n ||
+				(model == CarryModel::General && b.size() != n))
+			{
+				throw IncorrectInputException("All batch columns must have the same length.");
+			}
+
+			constexpr std::size_t block_size{256};
+			double d[2 * block_size];
+			double N_d[2 * block_size];
+			for (std::size_t start = 0; start < n; start += block_size)
+			{
+				const std::size_t m{std::min(block_size, n - start)};
+				for (std::size_t j = 0; j < m; j++)
+				{
+					const std::size_t i{start + j};
+					const double carryRate = getCarry(r[i], (model == CarryModel::General) ? b[i] : 0.0);
+					const double d1 = ( std::log(S[i] / K[i]) + (carryRate + sigma[i] * sigma[i] / 2) * T[i] ) / (sigma[i] * std::sqrt(T[i]));
+					d[j] = d1;
+					d[m + j] = d1 - sigma[i] * std::sqrt(T[i]);
+				}
+				StandardNormal::cdf(std::span<const double>(d, 2 * m), std::span<double>(N_d, 2 * m));
+				for (std::size_t j = 0; j < m; j++)
+				{
+					const std::size_t i{start + j};
+					const double df = std::exp(-r[i] * T[i]);
+					const double carry = getCarryFactor(df, r[i], (model == CarryModel::General) ? b[i] : 0.0, T[i]);
+					const double call = S[i] * carry * N_d[j] - K[i] * df * N_d[m + j];
+					price[i] = isCall ? call : BlackScholesKernels::getPutFromCall(call, S[i], K[i] * df);
+				}
+			}
+		}
+	};
+
+	namespace BlackScholesKernels
+	{
+		/// @brief cost-of-carry model of a market, the futures model is
+		/// checked first so that r = b = 0 keeps the futures option rho
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @return CarryModel
+		inline CarryModel getCarryModel(double r, double b)
+		{
+			if (b == 0.0)
+			{
+				return CarryModel::Futures;
+			}
+			return (b == r) ? CarryModel::Stock : CarryModel::General;
+		}
+
+		/// @brief call a function with the kernel of a type and market, chosen
+		/// once at runtime
+		/// @param type call or put
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @param function callable on a BlackScholesKernel object
+		/// @return result of the function
+		template <typename Function>
+		decltype(auto) visit(Payoff::Type type, double r, double b, Function&& function)
+		{
+			switch (getCarryModel(r, b))
+			{
+			case CarryModel::Stock:
+				return (type == Payoff::Call) ? function(BlackScholesKernel<Payoff::Call, CarryModel::Stock>{})
+											  : function(BlackScholesKernel<Payoff::Put, CarryModel::Stock>{});
+			case CarryModel::Futures:
+				return (type == Payoff::Call) ? function(BlackScholesKernel<Payoff::Call, CarryModel::Futures>{})
+											  : function(BlackScholesKernel<Payoff::Put, CarryModel::Futures>{});
+			default:
+				return (type == Payoff::Call) ? function(BlackScholesKernel<Payoff::Call, CarryModel::General>{})
+											  : function(BlackScholesKernel<Payoff::Put, CarryModel::General>{});
+			}
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,34 @@
+// Contract record holds the terms of a vanilla option as a trivially
+// copyable value: strike, maturity, type and exercise. Together with a
+// MarketQuote it is everything a pricing kernel needs, so contracts can be
+// stored in plain arrays and priced without Payoff objects or shared pointers.
+
+#ifndef CONTRACT_HPP
+#define CONTRACT_HPP
+
+#include "Payoff.hpp"
+
+#include <type_traits>
+
+namespace PricingLibrary {
+
+	struct Contract
+	{
+		double K{};                                  // strike price
+		double T{};                                  // maturity
+		Payoff::Type type{Payoff::Call};             // call or put
+		Payoff::Exercise exercise{Payoff::European}; // European or American
+
+		/// @brief contract with the terms of a Payoff object
+		/// @param payoff Payoff object
+		/// @return contract
+		static Contract fromPayoff(const Payoff& payoff)
+		{
+			return Contract{payoff.getStrike(), payoff.getMaturity(), payoff.getType(), payoff.getExercise()};
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<Contract>, "Contract must stay a plain value");
+}
+
+#endif
@@ -0,0 +1,311 @@
+// Implementation of the header file ContractBook.hpp
+
+#include "ContractBook.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CONTRACTBOOK_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PricingLibrary {
+
+	// Type and exercise columns are read in place as the enumerations
+	static_assert(sizeof(Payoff::Type) == sizeof(std::int32_t), "Payoff::Type must be 32 bits");
+	static_assert(sizeof(Payoff::Exercise) == sizeof(std::int32_t), "Payoff::Exercise must be 32 bits");
+
+	namespace
+	{
+		constexpr char magic[8] = {'O', 'P', 'T', 'B', 'O', 'O', 'K', '\0'};
+		constexpr std::uint32_t byte_order_mark{0x01020304};
+		constexpr std::size_t header_size{128};
+		constexpr std::size_t alignment{64};
+		constexpr std::size_t column_count{8};
+		// Width in bytes of the columns: S, K, T, sigma, r, b, type, exercise
+		constexpr std::size_t column_width[column_count] = {8, 8, 8, 8, 8, 8, 4, 4};
+
+		// Round up to the column alignment
+		std::uint64_t align(std::uint64_t offset)
+		{
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	/// @brief Default constructor, opens and maps a book
+	/// @param path file written by ContractBook::write
+	ContractBook::ContractBook(const std::string& path)
+	: _path{path}, _data{nullptr}, _size{0}, _buffer{}, _count{0}, _offsets{}
+	{
+		open();
+	}
+
+	/// @brief Copy constructor, maps the file of the source again
+	/// @param source ContractBook object
+	ContractBook::ContractBook(const ContractBook& source)
+	: _path{source._path}, _data{nullptr}, _size{0}, _buffer{}, _count{0}, _offsets{}
+	{
+		open();
+	}
+
+	/// @brief Copy assignment
+	/// @param source ContractBook object
+	/// @return ContractBook object
+	ContractBook& ContractBook::operator= (const ContractBook& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		close();
+		_path = source._path;
+		open();
+
+		return *this;
+	}
+
+	/// @brief Destructor, unmaps the file
+	ContractBook::~ContractBook()
+	{
+		close();
+	}
+
+	/// @brief map the file into memory, or read it where mapping is not available,
+	/// and check the header. Column contents are not scanned
+	void ContractBook::open()
+	{
+#ifdef CONTRACTBOOK_MMAP
+		const int descriptor = ::open(_path.c_str(), O_RDONLY);
+		if (descriptor < 0)
+		{
+			throw IncorrectInputException("Cannot open contract book " + _path + ".");
+		}
+		struct stat status{};
+		if (::fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(header_size))
+		{
+			::close(descriptor);
+			throw IncorrectInputException("Contract book " + _path + " is too short.");
+		}
+		_size = static_cast<std::size_t>(status.st_size);
+		void* mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		::close(descriptor);
+		if (mapping == MAP_FAILED)
+		{
+			_size = 0;
+			throw IncorrectInputException("Cannot map contract book " + _path + ".");
+		}
+		_data = static_cast<const std::byte*>(mapping);
+#else
+		std::ifstream file(_path, std::ios::binary | std::ios::ate);
+		if (!file || file.tellg() < static_cast<std::streamoff>(header_size))
+		{
+			throw IncorrectInputException("Cannot open contract book " + _path + ".");
+		}
+		_size = static_cast<std::size_t>(file.tellg());
+		// Doubles keep the columns aligned in memory
+		_buffer.resize((_size + sizeof(double) - 1) / sizeof(double));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(_buffer.data()), static_cast<std::streamsize>(_size));
+		_data = reinterpret_cast<const std::byte*>(_buffer.data());
+#endif
+
+		std::uint32_t fileVersion{};
+		std::uint32_t order{};
+		std::uint64_t count{};
+		std::memcpy(&fileVersion, _data + 8, sizeof(fileVersion));
+		std::memcpy(&order, _data + 12, sizeof(order));
+		std::memcpy(&count, _data + 16, sizeof(count));
+		std::memcpy(_offsets, _data + 24, sizeof(_offsets));
+
+		std::string error;
+		if (std::memcmp(_data, magic, sizeof(magic)) != 0)
+		{
+			error = "is not a contract book";
+		}
+		else if (fileVersion != version)
+		{
+			error = "has unsupported version " + std::to_string(fileVersion);
+		}
+		else if (order != byte_order_mark)
+		{
+			error = "was written with another byte order";
+		}
+		else
+		{
+			for (std::size_t column = 0; column < column_count; column++)
+			{
+				if (_offsets[column] % alignment != 0 || _offsets[column] < header_size ||
+					_offsets[column] > _size || (_size - _offsets[column]) / column_width[column] < count)
+				{
+					error = "is truncated or corrupt";
+				}
+			}
+		}
+		if (!error.empty())
+		{
+			close();
+			throw IncorrectInputException("Contract book " + _path + " " + error + ".");
+		}
+		_count = static_cast<std::size_t>(count);
+	}
+
+	/// @brief unmap the file
+	void ContractBook::close()
+	{
+#ifdef CONTRACTBOOK_MMAP
+		if (_data != nullptr)
+		{
+			::munmap(const_cast<std::byte*>(_data), _size);
+		}
+#endif
+		_buffer.clear();
+		_data = nullptr;
+		_size = 0;
+		_count = 0;
+	}
+
+	/// @brief write a book. Each column is written at a 64-byte aligned offset
+	/// @param path output file
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param sigma volatilities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param exercise exercise types
+	void ContractBook::write(const std::string& path, std::span<const double> S, std::span<const double> K,
+							 std::span<const double> T, std::span<const double> sigma,
+							 std::span<const double> r, std::span<const double> b,
+							 std::span<const Payoff::Type> type, std::span<const Payoff::Exercise> exercise)
+	{
+		const std::size_t n{S.size()};
+		if (K.size() != n || T.size() != n || sigma.size() != n || r.size() != n || b.size() != n ||
+			type.size() != n || exercise.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		const void* columns[column_count] = {S.data(), K.data(), T.data(), sigma.data(), r.data(), b.data(),
+											 type.data(), exercise.data()};
+		std::uint64_t offsets[column_count];
+		std::uint64_t offset{header_size};
+		for (std::size_t column = 0; column < column_count; column++)
+		{
+			offsets[column] = offset;
+			offset = align(offset + n * column_width[column]);
+		}
+
+		char header[header_size] = {};
+		const std::uint64_t count{n};
+		std::memcpy(header, magic, sizeof(magic));
+		std::memcpy(header + 8, &version, sizeof(version));
+		std::memcpy(header + 12, &byte_order_mark, sizeof(byte_order_mark));
+		std::memcpy(header + 16, &count, sizeof(count));
+		std::memcpy(header + 24, offsets, sizeof(offsets));
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			throw IncorrectInputException("Cannot write contract book " + path + ".");
+		}
+		file.write(header, header_size);
+		const char padding[alignment] = {};
+		std::uint64_t position{header_size};
+		for (std::size_t column = 0; column < column_count; column++)
+		{
+			file.write(padding, static_cast<std::streamsize>(offsets[column] - position));
+			file.write(static_cast<const char*>(columns[column]), static_cast<std::streamsize>(n * column_width[column]));
+			position = offsets[column] + n * column_width[column];
+		}
+		if (!file)
+		{
+			throw IncorrectInputException("Cannot write contract book " + path + ".");
+		}
+	}
+
+	/// @brief column of the mapped file
+	/// @param column index of the column
+	/// @return span over the column
+	template <typename T>
+	std::span<const T> ContractBook::getColumn(std::size_t column) const
+	{
+		return std::span<const T>(reinterpret_cast<const T*>(_data + _offsets[column]), _count);
+	}
+
+	/// @brief get number of contracts
+	/// @return number of contracts
+	std::size_t ContractBook::getCount() const
+	{
+		return _count;
+	}
+
+	/// @brief get path of the file
+	/// @return path
+	const std::string& ContractBook::getPath() const
+	{
+		return _path;
+	}
+
+	/// @brief underlying prices
+	/// @return column
+	std::span<const double> ContractBook::getSpots() const
+	{
+		return getColumn<double>(0);
+	}
+
+	/// @brief strike prices
+	/// @return column
+	std::span<const double> ContractBook::getStrikes() const
+	{
+		return getColumn<double>(1);
+	}
+
+	/// @brief maturities
+	/// @return column
+	std::span<const double> ContractBook::getMaturities() const
+	{
+		return getColumn<double>(2);
+	}
+
+	/// @brief volatilities
+	/// @return column
+	std::span<const double> ContractBook::getVolatilities() const
+	{
+		return getColumn<double>(3);
+	}
+
+	/// @brief risk-free rates
+	/// @return column
+	std::span<const double> ContractBook::getRates() const
+	{
+		return getColumn<double>(4);
+	}
+
+	/// @brief cost-of-carry parameters
+	/// @return column
+	std::span<const double> ContractBook::getCarries() const
+	{
+		return getColumn<double>(5);
+	}
+
+	/// @brief option types
+	/// @return column
+	std::span<const Payoff::Type> ContractBook::getTypes() const
+	{
+		return getColumn<Payoff::Type>(6);
+	}
+
+	/// @brief exercise types
+	/// @return column
+	std::span<const Payoff::Exercise> ContractBook::getExercises() const
+	{
+		return getColumn<Payoff::Exercise>(7);
+	}
+}
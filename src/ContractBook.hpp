@@ -0,0 +1,78 @@
+// Binary columnar file format for contract books. A file holds a fixed
+// header followed by one column per field: underlying price, strike,
+// maturity, volatility, risk-free rate and cost of carry as doubles, type and
+// exercise as 32-bit integers. Every column starts on a 64-byte boundary, so
+// ContractBook maps the file into memory and hands out spans that point
+// straight into the mapping: the batch pricing functions read the file
+// without parsing or copying, and opening a book costs the same for any size.
+//
+// Layout, little-endian, version 1:
+//   offset 0   magic "OPTBOOK\0"
+//   offset 8   uint32 version
+//   offset 12  uint32 byte order mark 0x01020304
+//   offset 16  uint64 number of contracts
+//   offset 24  uint64 offset of each of the 8 columns, in the order above
+//   offset 128 columns
+
+#ifndef CONTRACTBOOK_HPP
+#define CONTRACTBOOK_HPP
+
+#include "Payoff.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class ContractBook
+	{
+	private:
+		std::string _path;            // file the book was opened from
+		const std::byte* _data;       // start of the file contents
+		std::size_t _size;            // file size in bytes
+		std::vector<double> _buffer;  // file contents where memory mapping is not available
+		std::size_t _count;           // number of contracts
+		std::uint64_t _offsets[8];    // offsets of the columns
+
+		// Map the file and check its header
+		void open();
+		// Unmap the file
+		void close();
+		// Column at an offset
+		template <typename T>
+		std::span<const T> getColumn(std::size_t column) const;
+
+	public:
+		static constexpr std::uint32_t version{1}; // format version written and read
+
+		explicit ContractBook(const std::string& path); // default constructor, opens a file
+		ContractBook(const ContractBook& source); // copy constructor, maps the same file again
+		ContractBook& operator= (const ContractBook& source); // copy assignment
+		~ContractBook(); // destructor
+
+		// Write a book, all columns must have the same length
+		static void write(const std::string& path, std::span<const double> S, std::span<const double> K,
+						  std::span<const double> T, std::span<const double> sigma,
+						  std::span<const double> r, std::span<const double> b,
+						  std::span<const Payoff::Type> type, std::span<const Payoff::Exercise> exercise);
+
+		std::size_t getCount() const; // number of contracts
+		const std::string& getPath() const; // file path
+
+		// Columns pointing into the mapped file
+		std::span<const double> getSpots() const;
+		std::span<const double> getStrikes() const;
+		std::span<const double> getMaturities() const;
+		std::span<const double> getVolatilities() const;
+		std::span<const double> getRates() const;
+		std::span<const double> getCarries() const;
+		std::span<const Payoff::Type> getTypes() const;
+		std::span<const Payoff::Exercise> getExercises() const;
+	};
+}
+
+#endif
@@ -0,0 +1,92 @@
+// Implementation of the header file CsvResultSink.hpp
+
+#include "CsvResultSink.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Longest text of a double from std::to_chars, plus a separator
+		constexpr std::size_t max_value_length = 32;
+	}
+
+	/// @brief Default constructor, creates the file and writes the header line
+	/// @param path output file
+	/// @param columns column names
+	/// @param bufferSize characters formatted before they are written to the file
+	CsvResultSink::CsvResultSink(const std::string& path, const std::vector<std::string>& columns,
+								 std::size_t bufferSize)
+	: ResultSink{columns}, _file{std::make_unique<std::ofstream>(path, std::ios::binary | std::ios::trunc)},
+	  _out{_file.get()}, _buffer(std::max(bufferSize, 2 * max_value_length)), _used{0}
+	{
+		if (!*_file)
+		{
+			throw IncorrectInputException("Cannot write results to " + path + ".");
+		}
+		for (std::size_t i = 0; i < _columns.size(); i++)
+		{
+			*_out << _columns[i] << (i + 1 < _columns.size() ? ',' : '\n');
+		}
+	}
+
+	/// @brief Constructor on an existing stream, writes the header line
+	/// @param out output stream, must outlive the sink
+	/// @param columns column names
+	/// @param bufferSize characters formatted before they are written to the stream
+	CsvResultSink::CsvResultSink(std::ostream& out, const std::vector<std::string>& columns, std::size_t bufferSize)
+	: ResultSink{columns}, _file{}, _out{&out}, _buffer(std::max(bufferSize, 2 * max_value_length)), _used{0}
+	{
+		for (std::size_t i = 0; i < _columns.size(); i++)
+		{
+			*_out << _columns[i] << (i + 1 < _columns.size() ? ',' : '\n');
+		}
+	}
+
+	/// @brief Destructor, writes the remaining rows
+	CsvResultSink::~CsvResultSink()
+	{
+		drain();
+		_out->flush();
+	}
+
+	/// @brief write the buffered text to the stream
+	void CsvResultSink::drain()
+	{
+		_out->write(_buffer.data(), static_cast<std::streamsize>(_used));
+		_used = 0;
+	}
+
+	/// @brief format rows with std::to_chars, the buffer goes to the stream when full
+	/// @param values row after row of values
+	void CsvResultSink::write(std::span<const double> values)
+	{
+		getRowCount(values);
+
+		const std::size_t columns{_columns.size()};
+		for (std::size_t i = 0; i < values.size(); i++)
+		{
+			if (_buffer.size() - _used < max_value_length)
+			{
+				drain();
+			}
+			char* end = _buffer.data() + _buffer.size();
+			const std::to_chars_result result = std::to_chars(_buffer.data() + _used, end, values[i]);
+			*result.ptr = ((i + 1) % columns == 0) ? '\n' : ',';
+			_used = static_cast<std::size_t>(result.ptr + 1 - _buffer.data());
+		}
+	}
+
+	/// @brief write the buffered text and flush the stream
+	void CsvResultSink::flush()
+	{
+		drain();
+		_out->flush();
+		if (!*_out)
+		{
+			throw IncorrectInputException("Cannot write results.");
+		}
+	}
+}
@@ -0,0 +1,46 @@
+// Result sink writing comma-separated values. Numbers are formatted with
+// std::to_chars into a large buffer, which is written to the stream only
+// when full or flushed, so no locale or stream formatting is involved per
+// value. Values are written in the shortest form that reads back exactly.
+
+#ifndef CSVRESULTSINK_HPP
+#define CSVRESULTSINK_HPP
+
+#include "ResultSink.hpp"
+
+#include <fstream>
+#include <memory>
+#include <ostream>
+
+namespace PricingLibrary {
+
+	class CsvResultSink : public ResultSink
+	{
+	private:
+		std::unique_ptr<std::ofstream> _file; // file owned by the sink, if any
+		std::ostream* _out;                   // destination stream
+		std::vector<char> _buffer;            // formatted text not yet written
+		std::size_t _used;                    // characters used in the buffer
+
+		// Write the buffer to the stream
+		void drain();
+
+	public:
+		using ResultSink::write;
+
+		// Write to a new file
+		CsvResultSink(const std::string& path, const std::vector<std::string>& columns,
+					  std::size_t bufferSize=1 << 20); // default constructor
+		// Write to an existing stream, such as std::cout
+		CsvResultSink(std::ostream& out, const std::vector<std::string>& columns,
+					  std::size_t bufferSize=1 << 20);
+		~CsvResultSink(); // destructor, flushes
+
+		// Format rows into the buffer
+		void write(std::span<const double> values) override;
+		// Write the buffer to the stream and flush it
+		void flush() override;
+	};
+}
+
+#endif
@@ -0,0 +1,140 @@
+// Implementation of the header file DiscountCache.hpp
+
+#include "DiscountCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor, computes the factors of every distinct maturity
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	/// @param maturities maturities to cache, in any order and with repetitions
+	DiscountCache::DiscountCache(const std::shared_ptr<const YieldCurve>& rates,
+								 const std::shared_ptr<const YieldCurve>& dividends,
+								 std::span<const double> maturities)
+	: _rates{rates}, _dividends{dividends}, _factors{}, _locator{}
+	{
+		if (!rates)
+		{
+			throw IncorrectInputException("Rate curve is missing.");
+		}
+
+		std::vector<double> T(maturities.begin(), maturities.end());
+		std::sort(T.begin(), T.end());
+		T.erase(std::unique(T.begin(), T.end()), T.end());
+		_factors.reserve(T.size());
+		for (double t : T)
+		{
+			_factors.push_back(getFactors(*_rates, _dividends.get(), t));
+		}
+		if (T.size() > 1)
+		{
+			_locator = AxisLocator(T);
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source DiscountCache object
+	DiscountCache::DiscountCache(const DiscountCache& source)
+	: _rates{source._rates}, _dividends{source._dividends}, _factors{source._factors},
+	  _locator{source._locator}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source DiscountCache object
+	/// @return DiscountCache object
+	DiscountCache& DiscountCache::operator= (const DiscountCache& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_rates = source._rates;
+		_dividends = source._dividends;
+		_factors = source._factors;
+		_locator = source._locator;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	DiscountCache::~DiscountCache() {}
+
+	/// @brief factors of any maturity from the curves
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	/// @param T maturity
+	/// @return DiscountFactors
+	DiscountFactors DiscountCache::getFactors(const YieldCurve& rates, const YieldCurve* dividends, double T)
+	{
+		const double r{rates.getZeroRate(T)};
+		const double q{dividends ? dividends->getZeroRate(T) : 0.0};
+		return DiscountFactors{T, r, r - q, std::exp(-r * T), std::exp(-q * T)};
+	}
+
+	/// @brief factors of a maturity, computed from the curves if it is not cached
+	/// @param T maturity
+	/// @return DiscountFactors
+	DiscountFactors DiscountCache::getFactors(double T) const
+	{
+		std::size_t hint{0};
+		return getFactors(T, hint);
+	}
+
+	/// @brief factors of a maturity. The entry of the hint and its successor are
+	/// tried first, then the locator; the hint is set to the entry found, so
+	/// consecutive lookups of the same or the next maturity do not search
+	/// @param T maturity
+	/// @param hint index of a cached entry, e.g. of the previous lookup
+	/// @return DiscountFactors
+	DiscountFactors DiscountCache::getFactors(double T, std::size_t& hint) const
+	{
+		const std::size_t n{_factors.size()};
+		if (hint < n && _factors[hint].T == T)
+		{
+			return _factors[hint];
+		}
+		if (hint + 1 < n && _factors[hint + 1].T == T)
+		{
+			return _factors[++hint];
+		}
+
+		if (n > 1 && T >= _factors.front().T && T <= _factors.back().T)
+		{
+			// The interval of T starts at its entry, or ends at it for the last maturity
+			std::size_t i{_locator.locate(T)};
+			i = (_factors[i].T == T) ? i : i + 1;
+			if (_factors[i].T == T)
+			{
+				hint = i;
+				return _factors[i];
+			}
+		}
+		return getFactors(*_rates, _dividends.get(), T);
+	}
+
+	/// @brief cached maturities with their factors
+	/// @return factors by increasing maturity
+	const std::vector<DiscountFactors>& DiscountCache::getCachedFactors() const
+	{
+		return _factors;
+	}
+
+	/// @brief risk-free rate curve
+	/// @return rates
+	const std::shared_ptr<const YieldCurve>& DiscountCache::getRates() const
+	{
+		return _rates;
+	}
+
+	/// @brief dividend yield curve
+	/// @return dividends, nullptr for zero yield
+	const std::shared_ptr<const YieldCurve>& DiscountCache::getDividends() const
+	{
+		return _dividends;
+	}
+}
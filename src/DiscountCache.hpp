@@ -0,0 +1,61 @@
+// Discount and carry factors of a set of maturities, computed once from a
+// rate curve and a dividend yield curve. A book of many contracts sharing a
+// few hundred expiries then looks up DF(T) = exp(-r T) and the carry factor
+// exp((b - r) T) of each contract instead of calling std::exp per contract.
+// Maturities are kept sorted; a lookup first tries the entry of the previous
+// contract, so a book grouped by expiry rarely searches, and otherwise finds
+// the entry through an AxisLocator in constant time.
+
+#ifndef DISCOUNTCACHE_HPP
+#define DISCOUNTCACHE_HPP
+
+#include "AxisLocator.hpp"
+#include "YieldCurve.hpp"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace PricingLibrary {
+
+	// Rates and factors of one maturity
+	struct DiscountFactors
+	{
+		double T{};        // maturity
+		double r{};        // zero rate r(T)
+		double b{};        // cost of carry r(T) - q(T)
+		double discount{}; // exp(-r T)
+		double carry{};    // exp((b - r) T), forward over spot
+	};
+
+	class DiscountCache
+	{
+	private:
+		std::shared_ptr<const YieldCurve> _rates;     // risk-free rates
+		std::shared_ptr<const YieldCurve> _dividends; // dividend yields, zero if missing
+		std::vector<DiscountFactors> _factors;        // by increasing maturity
+		AxisLocator _locator;                         // entry of a maturity, if more than one
+
+	public:
+		// default constructor
+		DiscountCache(const std::shared_ptr<const YieldCurve>& rates, const std::shared_ptr<const YieldCurve>& dividends,
+					  std::span<const double> maturities);
+		DiscountCache(const DiscountCache& source); // copy constructor
+		DiscountCache& operator= (const DiscountCache& source); // copy assignment
+		~DiscountCache(); // destructor
+
+		// Factors of a maturity, computed from the curves if it is not cached
+		DiscountFactors getFactors(double T) const;
+		// Factors of a maturity starting the search at a hint, which is updated
+		DiscountFactors getFactors(double T, std::size_t& hint) const;
+		// Factors of any maturity from the curves
+		static DiscountFactors getFactors(const YieldCurve& rates, const YieldCurve* dividends, double T);
+
+		// Cached maturities with their factors
+		const std::vector<DiscountFactors>& getCachedFactors() const;
+		const std::shared_ptr<const YieldCurve>& getRates() const;
+		const std::shared_ptr<const YieldCurve>& getDividends() const;
+	};
+}
+
+#endif
@@ -0,0 +1,195 @@
+// Dual numbers for forward-mode automatic differentiation. A Dual carries a
+// value and its derivatives in N directions; arithmetic and the functions
+// below propagate them by the chain rule, so a pricing formula written for a
+// generic scalar type returns its price and first derivatives in one pass.
+// The scalar type is itself a template parameter: a Dual of Duals carries
+// second derivatives, e.g. Dual<Dual<double, 1>, 1> seeded on S gives gamma.
+
+#ifndef DUAL_HPP
+#define DUAL_HPP
+
+#include "StandardNormal.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace PricingLibrary {
+
+	template <typename T, std::size_t N>
+	struct Dual
+	{
+		T value{};                    // value
+		std::array<T, N> derivative{}; // derivative in each direction
+
+		Dual() =default;
+		// constant, all derivatives zero
+		Dual(const T& constant) : value{constant} {}
+		// constant from a number, also for nested duals
+		template <typename U> requires (std::is_arithmetic_v<U> && !std::is_same_v<T, U>)
+		Dual(U constant) : value(constant) {}
+
+		/// @brief independent variable, derivative 1 in its own direction
+		/// @param x value
+		/// @param direction index of the direction
+		/// @return variable
+		static Dual variable(const T& x, std::size_t direction)
+		{
+			Dual result{x};
+			result.derivative[direction] = T(1.0);
+			return result;
+		}
+	};
+
+	/************************ Arithmetic ************************/
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator-(const Dual<T, N>& a)
+	{
+		Dual<T, N> result{-a.value};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = -a.derivative[i];
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator+(const Dual<T, N>& a, const Dual<T, N>& b)
+	{
+		Dual<T, N> result{a.value + b.value};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = a.derivative[i] + b.derivative[i];
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator-(const Dual<T, N>& a, const Dual<T, N>& b)
+	{
+		Dual<T, N> result{a.value - b.value};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = a.derivative[i] - b.derivative[i];
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator*(const Dual<T, N>& a, const Dual<T, N>& b)
+	{
+		Dual<T, N> result{a.value * b.value};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = a.derivative[i] * b.value + a.value * b.derivative[i];
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator/(const Dual<T, N>& a, const Dual<T, N>& b)
+	{
+		const T quotient = a.value / b.value;
+		Dual<T, N> result{quotient};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = (a.derivative[i] - quotient * b.derivative[i]) / b.value;
+		}
+		return result;
+	}
+
+	// Mixed with plain numbers
+	template <typename T, std::size_t N>
+	Dual<T, N> operator+(const Dual<T, N>& a, double b) { return a + Dual<T, N>(b); }
+	template <typename T, std::size_t N>
+	Dual<T, N> operator+(double a, const Dual<T, N>& b) { return Dual<T, N>(a) + b; }
+	template <typename T, std::size_t N>
+	Dual<T, N> operator-(const Dual<T, N>& a, double b) { return a - Dual<T, N>(b); }
+	template <typename T, std::size_t N>
+	Dual<T, N> operator-(double a, const Dual<T, N>& b) { return Dual<T, N>(a) - b; }
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator*(const Dual<T, N>& a, double b)
+	{
+		Dual<T, N> result{a.value * b};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = a.derivative[i] * b;
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> operator*(double a, const Dual<T, N>& b) { return b * a; }
+	template <typename T, std::size_t N>
+	Dual<T, N> operator/(const Dual<T, N>& a, double b) { return a * (1.0 / b); }
+	template <typename T, std::size_t N>
+	Dual<T, N> operator/(double a, const Dual<T, N>& b) { return Dual<T, N>(a) / b; }
+
+	/************************ Functions ************************/
+
+	// Function of one argument from its value f and derivative df at x
+	template <typename T, std::size_t N>
+	Dual<T, N> chain(const Dual<T, N>& x, const T& f, const T& df)
+	{
+		Dual<T, N> result{f};
+		for (std::size_t i = 0; i < N; i++)
+		{
+			result.derivative[i] = df * x.derivative[i];
+		}
+		return result;
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> exp(const Dual<T, N>& x)
+	{
+		using std::exp;
+		const T e = exp(x.value);
+		return chain(x, e, e);
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> log(const Dual<T, N>& x)
+	{
+		using std::log;
+		return chain(x, T(log(x.value)), T(1.0 / x.value));
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> sqrt(const Dual<T, N>& x)
+	{
+		using std::sqrt;
+		const T root = sqrt(x.value);
+		return chain(x, root, T(0.5 / root));
+	}
+
+	/// @brief standard normal density of a number, the overloads for automatic
+	/// differentiation types propagate derivatives
+	inline double normalPdf(double x)
+	{
+		return StandardNormal::pdf(x);
+	}
+
+	/// @brief standard normal distribution of a number
+	inline double normalCdf(double x)
+	{
+		return StandardNormal::cdf(x);
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> normalPdf(const Dual<T, N>& x)
+	{
+		const T density = normalPdf(x.value);
+		return chain(x, density, T(-x.value * density));
+	}
+
+	template <typename T, std::size_t N>
+	Dual<T, N> normalCdf(const Dual<T, N>& x)
+	{
+		return chain(x, T(normalCdf(x.value)), T(normalPdf(x.value)));
+	}
+}
+
+#endif
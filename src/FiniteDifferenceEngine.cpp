@@ -0,0 +1,361 @@
+// Implementation of the header file FiniteDifferenceEngine.hpp
+
+#include "FiniteDifferenceEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Number of Crank-Nicolson steps replaced by two fully implicit half steps
+		// each (Rannacher start), damps the oscillations of the kinked payoff
+		constexpr std::size_t rannacher_steps = 2;
+		// Penalty factor enforcing the early-exercise constraint
+		constexpr double penalty = 1e10;
+		// Maximum number of penalty iterations per time step
+		constexpr int max_penalty_iterations = 50;
+	}
+
+	/// @brief Default constructor
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param spaceSteps number of underlying price intervals
+	/// @param timeSteps number of time steps
+	FiniteDifferenceEngine::FiniteDifferenceEngine(double S, double sigma, double r, double b,
+												   std::size_t spaceSteps, std::size_t timeSteps)
+	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _spaceSteps{spaceSteps}, _timeSteps{timeSteps},
+	  _grid{}, _values{}, _previous{}, _exercise{}, _lower{}, _diagonal{}, _upper{}, _rhs{}, _upperStar{}, _rhsStar{},
+	  _solved{false}, _lastMaturity{}, _lastStrike{}, _lastType{Payoff::Call}, _lastExercise{Payoff::European}, _last{}
+	{}
+
+	/// @brief Copy constructor, the workspace is not copied
+	/// @param source FiniteDifferenceEngine object
+	FiniteDifferenceEngine::FiniteDifferenceEngine(const FiniteDifferenceEngine& source)
+	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b},
+	  _spaceSteps{source._spaceSteps}, _timeSteps{source._timeSteps},
+	  _grid{}, _values{}, _previous{}, _exercise{}, _lower{}, _diagonal{}, _upper{}, _rhs{}, _upperStar{}, _rhsStar{},
+	  _solved{false}, _lastMaturity{}, _lastStrike{}, _lastType{Payoff::Call}, _lastExercise{Payoff::European}, _last{}
+	{}
+
+	/// @brief Copy assignment, the workspace is kept
+	/// @param source FiniteDifferenceEngine object
+	/// @return FiniteDifferenceEngine object
+	FiniteDifferenceEngine& FiniteDifferenceEngine::operator= (const FiniteDifferenceEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		PricingEngine::operator=(source);
+		_S = source._S;
+		_sigma = source._sigma;
+		_r = source._r;
+		_b = source._b;
+		_spaceSteps = source._spaceSteps;
+		_timeSteps = source._timeSteps;
+		_solved = false;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	FiniteDifferenceEngine::~FiniteDifferenceEngine() {}
+
+	/// @brief Validate if engine was passed to a correct option
+	/// @param exercise American or European
+	void FiniteDifferenceEngine::validate(const Payoff::Exercise& exercise) const
+	{
+		if (exercise != Payoff::European && exercise != Payoff::American)
+		{
+			throw IncorrectEngineException("Only European and American Options can be priced on the grid.");
+		}
+	}
+
+	/// @brief build underlying price nodes S = K + c sinh(x) on a uniform x grid, so nodes
+	/// are dense near the strike, and the coefficients of the Black-Scholes operator
+	/// 1/2 sigma^2 S^2 V_SS + b S V_S - r V with three point non-uniform differences
+	/// @param K strike price
+	/// @param T maturity
+	void FiniteDifferenceEngine::buildGrid(double K, double T) const
+	{
+		const std::size_t N{_spaceSteps};
+		_grid.resize(N + 1);
+		_values.resize(N + 1);
+		_previous.resize(N + 1);
+		_exercise.resize(N + 1);
+		_lower.assign(N + 1, 0.0);
+		_diagonal.assign(N + 1, 0.0);
+		_upper.assign(N + 1, 0.0);
+		_rhs.resize(N + 1);
+		_upperStar.resize(N + 1);
+		_rhsStar.resize(N + 1);
+
+		// Upper bound well beyond the reach of the underlying price distribution
+		const double S_max{std::max(_S, K) * std::exp(std::max(6 * _sigma * std::sqrt(T), 1.0) + std::max(_b, 0.0) * T)};
+		const double c{0.1 * K};
+		const double x_min{std::asinh(-K / c)};
+		const double x_max{std::asinh((S_max - K) / c)};
+		for (std::size_t i = 0; i <= N; i++)
+		{
+			_grid[i] = K + c * std::sinh(x_min + (x_max - x_min) * i / N);
+		}
+		_grid[0] = 0.0;
+
+		for (std::size_t i = 1; i < N; i++)
+		{
+			const double h_minus{_grid[i] - _grid[i - 1]};
+			const double h_plus{_grid[i + 1] - _grid[i]};
+			const double diffusion{0.5 * _sigma * _sigma * _grid[i] * _grid[i]};
+			const double drift{_b * _grid[i]};
+			_lower[i] = diffusion * 2 / (h_minus * (h_minus + h_plus)) - drift * h_plus / (h_minus * (h_minus + h_plus));
+			_diagonal[i] = -diffusion * 2 / (h_minus * h_plus) + drift * (h_plus - h_minus) / (h_minus * h_plus) - _r;
+			_upper[i] = diffusion * 2 / (h_plus * (h_minus + h_plus)) + drift * h_minus / (h_plus * (h_minus + h_plus));
+		}
+	}
+
+	/// @brief one time step (I - theta dt L) V_new = (I + (1 - theta) dt L) V_old.
+	/// European values are found with the Thomas algorithm; American values with the
+	/// penalty method, which repeats the Thomas solve with a large penalty on the nodes
+	/// below the exercise value until that set of nodes does not change
+	/// @param dt step length
+	/// @param theta implicitness, 1/2 for Crank-Nicolson and 1 for implicit Euler
+	/// @param tau time to expiry after the step
+	/// @param K strike price
+	/// @param type call or put
+	/// @param exercise european or american
+	void FiniteDifferenceEngine::step(double dt, double theta, double tau, double K,
+									  Payoff::Type type, Payoff::Exercise exercise) const
+	{
+		const std::size_t N{_spaceSteps};
+		const bool american{exercise == Payoff::American};
+
+		// Explicit part
+		for (std::size_t i = 1; i < N; i++)
+		{
+			_rhs[i] = _values[i] + (1 - theta) * dt
+					* (_lower[i] * _values[i - 1] + _diagonal[i] * _values[i] + _upper[i] * _values[i + 1]);
+		}
+
+		// Boundary values at the new time level
+		double low{};
+		double high{};
+		if (type == Payoff::Type::Call)
+		{
+			low = 0.0;
+			high = _grid[N] * std::exp((_b - _r) * tau) - K * std::exp(-_r * tau);
+		}
+		else
+		{
+			low = K * std::exp(-_r * tau);
+			high = 0.0;
+		}
+		if (american)
+		{
+			low = std::max(low, _exercise[0]);
+			high = std::max(high, _exercise[N]);
+		}
+		_rhs[1] += theta * dt * _lower[1] * low;
+		_rhs[N - 1] += theta * dt * _upper[N - 1] * high;
+
+		// Old values are kept for theta
+		std::copy(_values.begin(), _values.end(), _previous.begin());
+		_values[0] = low;
+		_values[N] = high;
+
+		// Penalized nodes are those where the last iterate lies below the exercise value
+		for (int iteration = 0; iteration < max_penalty_iterations; iteration++)
+		{
+			// Thomas algorithm
+			for (std::size_t i = 1; i < N; i++)
+			{
+				const bool penalized{american && _values[i] < _exercise[i]};
+				const double a{-theta * dt * _lower[i]};
+				const double m{1 - theta * dt * _diagonal[i] + (penalized ? penalty : 0.0)};
+				const double c{-theta * dt * _upper[i]};
+				const double rhs{_rhs[i] + (penalized ? penalty * _exercise[i] : 0.0)};
+				const double denominator{m - (i > 1 ? a * _upperStar[i - 1] : 0.0)};
+				_upperStar[i] = c / denominator;
+				_rhsStar[i] = (rhs - (i > 1 ? a * _rhsStar[i - 1] : 0.0)) / denominator;
+			}
+
+			bool changed{false};
+			double next{};
+			for (std::size_t i = N - 1; i >= 1; i--)
+			{
+				next = _rhsStar[i] - (i < N - 1 ? _upperStar[i] * next : 0.0);
+				if (american && ((next < _exercise[i]) != (_values[i] < _exercise[i])))
+				{
+					changed = true;
+				}
+				_values[i] = next;
+			}
+
+			if (!american || !changed)
+			{
+				break;
+			}
+		}
+	}
+
+	/// @brief solve the grid from expiry back to today, unless the payoff equals
+	/// the last one solved. Price, delta and gamma are taken from the quadratic
+	/// through the three nodes nearest to the underlying price, theta from the
+	/// change of the price over the last time step
+	/// @param payoff Payoff object
+	/// @return price, delta, gamma and theta
+	const Greeks& FiniteDifferenceEngine::solve(const std::shared_ptr<Payoff>& payoff) const
+	{
+		validate(payoff->getExercise());
+
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const Payoff::Type type{payoff->getType()};
+		const Payoff::Exercise exercise{payoff->getExercise()};
+		if (_solved && K == _lastStrike && T == _lastMaturity && type == _lastType && exercise == _lastExercise)
+		{
+			return _last;
+		}
+		if (!(K > 0.0 && T > 0.0 && _S > 0.0) || _spaceSteps < 4 || _timeSteps <= rannacher_steps)
+		{
+			throw IncorrectInputException("Finite difference engine needs positive S, K, T and more grid steps.");
+		}
+
+		buildGrid(K, T);
+		const std::size_t N{_spaceSteps};
+		for (std::size_t i = 0; i <= N; i++)
+		{
+			_exercise[i] = std::max((type == Payoff::Type::Call) ? _grid[i] - K : K - _grid[i], 0.0);
+			_values[i] = _exercise[i];
+		}
+
+		const double dt{T / _timeSteps};
+		double tau{};
+		for (std::size_t n = 0; n < _timeSteps; n++)
+		{
+			if (n < rannacher_steps)
+			{
+				step(dt / 2, 1.0, tau + dt / 2, K, type, exercise);
+				step(dt / 2, 1.0, tau + dt, K, type, exercise);
+			}
+			else
+			{
+				step(dt, 0.5, tau + dt, K, type, exercise);
+			}
+			tau += dt;
+		}
+
+		// Three nodes around the underlying price
+		const std::size_t upper{static_cast<std::size_t>(std::upper_bound(_grid.begin(), _grid.end(), _S) - _grid.begin())};
+		std::size_t j{std::clamp<std::size_t>(upper, 1, N - 1)};
+		if (j > 1 && _S - _grid[j - 1] < _grid[j] - _S)
+		{
+			j--;
+		}
+		const double x0{_grid[j - 1]}, x1{_grid[j]}, x2{_grid[j + 1]};
+		auto quadratic = [&](const std::vector<double>& v, double& value, double& first, double& second)
+		{
+			const double w0{1 / ((x0 - x1) * (x0 - x2))};
+			const double w1{1 / ((x1 - x0) * (x1 - x2))};
+			const double w2{1 / ((x2 - x0) * (x2 - x1))};
+			value = v[j - 1] * w0 * (_S - x1) * (_S - x2) + v[j] * w1 * (_S - x0) * (_S - x2) + v[j + 1] * w2 * (_S - x0) * (_S - x1);
+			first = v[j - 1] * w0 * (2 * _S - x1 - x2) + v[j] * w1 * (2 * _S - x0 - x2) + v[j + 1] * w2 * (2 * _S - x0 - x1);
+			second = 2 * (v[j - 1] * w0 + v[j] * w1 + v[j + 1] * w2);
+		};
+
+		Greeks result;
+		quadratic(_values, result.price, result.delta, result.gamma);
+		// Values one time step before, saved by the last step
+		double valueBefore{}, first{}, second{};
+		quadratic(_previous, valueBefore, first, second);
+		result.theta = -(result.price - valueBefore) / dt;
+
+		_last = result;
+		_lastStrike = K;
+		_lastMaturity = T;
+		_lastType = type;
+		_lastExercise = exercise;
+		_solved = true;
+
+		return _last;
+	}
+
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double FiniteDifferenceEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).price;
+	}
+
+	/// @brief return delta greek
+	/// @param payoff Payoff object
+	/// @return delta
+	double FiniteDifferenceEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).delta;
+	}
+
+	/// @brief return gamma greek
+	/// @param payoff Payoff object
+	/// @return gamma
+	double FiniteDifferenceEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).gamma;
+	}
+
+	/// @brief return theta greek
+	/// @param payoff Payoff object
+	/// @return theta
+	double FiniteDifferenceEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).theta;
+	}
+
+	/*! \warning Not implemented calculation of Vega greek */
+	double FiniteDifferenceEngine::getEngineVega(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/// @brief return price and Greeks selected by mask from one grid solve
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks FiniteDifferenceEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
+	{
+		const Greeks& solution = solve(payoff);
+		Greeks result;
+		if (mask & Greeks::Price)
+		{
+			result.price = solution.price;
+		}
+		if (mask & Greeks::Delta)
+		{
+			result.delta = solution.delta;
+		}
+		if (mask & Greeks::Gamma)
+		{
+			result.gamma = solution.gamma;
+		}
+		if (mask & Greeks::Vega)
+		{
+			result.vega = getEngineVega(payoff);
+		}
+		if (mask & Greeks::Theta)
+		{
+			result.theta = solution.theta;
+		}
+		if (mask & Greeks::Rho)
+		{
+			result.rho = getEngineRho(payoff);
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,80 @@
+// Define engine to price european and american options of finite maturity by
+// the Crank-Nicolson finite-difference method. The Black-Scholes equation is
+// solved on a grid concentrated near the strike; price, delta, gamma and theta
+// are read from the solution. The grid workspace is allocated once per engine
+// and reused, so an engine object must not be shared between threads.
+
+#ifndef FINITEDIFFERENCEENGINE_HPP
+#define FINITEDIFFERENCEENGINE_HPP
+
+#include "PricingEngine.hpp"
+#include "EngineException.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class FiniteDifferenceEngine : public PricingEngine
+	{
+	private:
+		double _S;       // underlying price
+		double _sigma;   // volatility
+		double _r;       // risk-free rate
+		double _b;       // cost of carry
+		std::size_t _spaceSteps; // number of underlying price intervals
+		std::size_t _timeSteps;  // number of time steps
+
+		// Grid workspace, reused between calls
+		mutable std::vector<double> _grid;     // underlying price nodes
+		mutable std::vector<double> _values;   // option values on the nodes
+		mutable std::vector<double> _previous; // values before the last time step
+		mutable std::vector<double> _exercise; // exercise values on the nodes
+		mutable std::vector<double> _lower;    // operator coefficients of V[i-1]
+		mutable std::vector<double> _diagonal; // operator coefficients of V[i]
+		mutable std::vector<double> _upper;    // operator coefficients of V[i+1]
+		mutable std::vector<double> _rhs;      // right-hand side of the time step
+		mutable std::vector<double> _upperStar; // Thomas algorithm modified upper diagonal
+		mutable std::vector<double> _rhsStar;   // Thomas algorithm modified right-hand side
+
+		// Last solved contract and its results
+		mutable bool _solved;
+		mutable double _lastMaturity;
+		mutable double _lastStrike;
+		mutable Payoff::Type _lastType;
+		mutable Payoff::Exercise _lastExercise;
+		mutable Greeks _last;
+
+		// Solve the grid for the payoff unless it was the last one solved
+		const Greeks& solve(const std::shared_ptr<Payoff>& payoff) const;
+		// Build the non-uniform grid and the operator coefficients
+		void buildGrid(double K, double T) const;
+		// One theta-scheme time step of length dt, tau is the time to expiry after the step
+		void step(double dt, double theta, double tau, double K, Payoff::Type type, Payoff::Exercise exercise) const;
+
+	public:
+		FiniteDifferenceEngine(double S, double sigma, double r, double b,
+							   std::size_t spaceSteps=400, std::size_t timeSteps=200); // default constructor
+		FiniteDifferenceEngine(const FiniteDifferenceEngine& source); // copy constructor
+		FiniteDifferenceEngine& operator= (const FiniteDifferenceEngine& source); // copy assignment
+		~FiniteDifferenceEngine(); // destructor
+
+		// Get option price
+		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
+		// Greeks from the grid
+		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+		// Not implemented
+		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		// Price, delta, gamma and theta from one solve
+		Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const override;
+
+		// Validate if engine was passed to a correct option
+		void validate(const Payoff::Exercise& exercise) const override;
+	};
+}
+
+#endif
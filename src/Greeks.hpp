@@ -0,0 +1,35 @@
+// Greeks structure holds option price and sensitivities computed in one call,
+// the mask selects which of them are required. FloatGreeks is the single
+// precision record of the float batches
+
+#ifndef GREEKS_HPP
+#define GREEKS_HPP
+
+namespace PricingLibrary {
+
+	struct Greeks
+	{
+		// Flags to select values, can be combined with |
+		enum Mask {Price=1, Delta=2, Gamma=4, Vega=8, Theta=16, Rho=32, All=63};
+
+		double price{};  // option price
+		double delta{};  // dV/dS
+		double gamma{};  // d2V/dS2
+		double vega{};   // dV/dsigma per one percentage point of volatility
+		double theta{};  // dV/dt
+		double rho{};    // dV/dr
+	};
+
+	// Greeks in single precision, filled by the float batches of AnalyticEuropeanEngine
+	struct FloatGreeks
+	{
+		float price{};  // option price
+		float delta{};  // dV/dS
+		float gamma{};  // d2V/dS2
+		float vega{};   // dV/dsigma per one percentage point of volatility
+		float theta{};  // dV/dt
+		float rho{};    // dV/dr
+	};
+}
+
+#endif
@@ -0,0 +1,190 @@
+// Implementation of the header file GridVolSurface.hpp
+
+#include "GridVolSurface.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor
+	/// @param expiries increasing positive expiries
+	/// @param moneyness increasing log forward moneyness nodes ln(K / F)
+	/// @param volatilities positive volatilities, one row of moneyness.size() values per expiry
+	GridVolSurface::GridVolSurface(const std::vector<double>& expiries, const std::vector<double>& moneyness,
+								   const std::vector<double>& volatilities)
+	: _expiries{expiries}, _moneyness{moneyness}, _variance{}, _expiryScale{}, _moneynessScale{},
+	  _expiryLocator{}, _moneynessLocator{}
+	{
+		if (_expiries.empty() || _moneyness.empty() || volatilities.size() != _expiries.size() * _moneyness.size())
+		{
+			throw IncorrectInputException("Volatility grid needs one volatility per expiry and moneyness node.");
+		}
+		for (std::size_t i = 0; i < _expiries.size(); i++)
+		{
+			if (!(_expiries[i] > 0.0) || (i > 0 && !(_expiries[i] > _expiries[i - 1])))
+			{
+				throw IncorrectInputException("Expiries of a volatility grid must be positive and increasing.");
+			}
+		}
+		for (std::size_t j = 1; j < _moneyness.size(); j++)
+		{
+			if (!(_moneyness[j] > _moneyness[j - 1]))
+			{
+				throw IncorrectInputException("Moneyness nodes of a volatility grid must be increasing.");
+			}
+		}
+
+		for (double sigma : volatilities)
+		{
+			if (!(sigma > 0.0))
+			{
+				throw IncorrectInputException("Volatilities of a volatility grid must be positive.");
+			}
+		}
+
+		// A single node is repeated, flat in moneyness, and a single expiry is
+		// repeated at the same volatilities, so that both axes have an interval
+		const std::size_t rows{_expiries.size()};
+		const std::size_t columns{_moneyness.size()};
+		if (columns == 1)
+		{
+			_moneyness.push_back(_moneyness.front() + 1.0);
+		}
+		if (rows == 1)
+		{
+			_expiries.push_back(_expiries.front() + 1.0);
+		}
+		const std::size_t nodes{_moneyness.size()};
+		_variance.resize(_expiries.size() * nodes);
+		for (std::size_t i = 0; i < _expiries.size(); i++)
+		{
+			for (std::size_t j = 0; j < nodes; j++)
+			{
+				const double sigma{volatilities[std::min(i, rows - 1) * columns + std::min(j, columns - 1)]};
+				_variance[i * nodes + j] = sigma * sigma * _expiries[i];
+			}
+		}
+
+		for (std::size_t i = 0; i + 1 < _expiries.size(); i++)
+		{
+			_expiryScale.push_back(1 / (_expiries[i + 1] - _expiries[i]));
+		}
+		for (std::size_t j = 0; j + 1 < nodes; j++)
+		{
+			_moneynessScale.push_back(1 / (_moneyness[j + 1] - _moneyness[j]));
+		}
+		_expiryLocator = AxisLocator(_expiries);
+		_moneynessLocator = AxisLocator(_moneyness);
+	}
+
+	/// @brief Copy constructor
+	/// @param source GridVolSurface object
+	GridVolSurface::GridVolSurface(const GridVolSurface& source)
+	: VolSurface{source}, _expiries{source._expiries}, _moneyness{source._moneyness}, _variance{source._variance},
+	  _expiryScale{source._expiryScale}, _moneynessScale{source._moneynessScale},
+	  _expiryLocator{source._expiryLocator}, _moneynessLocator{source._moneynessLocator}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source GridVolSurface object
+	/// @return GridVolSurface object
+	GridVolSurface& GridVolSurface::operator= (const GridVolSurface& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		VolSurface::operator=(source);
+		_expiries = source._expiries;
+		_moneyness = source._moneyness;
+		_variance = source._variance;
+		_expiryScale = source._expiryScale;
+		_moneynessScale = source._moneynessScale;
+		_expiryLocator = source._expiryLocator;
+		_moneynessLocator = source._moneynessLocator;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	GridVolSurface::~GridVolSurface() {}
+
+	/// @brief volatility at T and k. Both are clamped to the grid, which makes
+	/// total variance flat in moneyness and volatility flat in expiry beyond it,
+	/// so the lookup has no branch on the position of the contract. NaN, from
+	/// a non-positive S or K, would pass the clamps and is rejected
+	/// @param T maturity
+	/// @param k log forward moneyness
+	/// @return volatility
+	double GridVolSurface::lookup(double T, double k) const
+	{
+		if (std::isnan(k) || std::isnan(T))
+		{
+			throw IncorrectInputException("Moneyness and maturity of a volatility lookup must be numbers.");
+		}
+		const double x = std::clamp(k, _moneyness.front(), _moneyness.back());
+		const double t = std::clamp(T, _expiries.front(), _expiries.back());
+		const std::size_t node{_moneynessLocator.locate(x)};
+		const std::size_t expiry{_expiryLocator.locate(t)};
+		const double weight = (x - _moneyness[node]) * _moneynessScale[node];
+
+		// Total variance of the two expiry rows around t at x
+		const double* row = _variance.data() + expiry * _moneyness.size() + node;
+		const double w0 = row[0] + weight * (row[1] - row[0]);
+		row += _moneyness.size();
+		const double w1 = row[0] + weight * (row[1] - row[0]);
+		const double w = w0 + (w1 - w0) * (t - _expiries[expiry]) * _expiryScale[expiry];
+
+		return std::sqrt(w / t);
+	}
+
+	/// @brief volatility at maturity T and log forward moneyness k
+	/// @param T maturity
+	/// @param k log forward moneyness ln(K / F)
+	/// @return volatility
+	double GridVolSurface::getVolatility(double T, double k) const
+	{
+		return lookup(T, k);
+	}
+
+	/// @brief volatilities of contracts, without a virtual call per contract
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param b cost-of-carry parameters
+	/// @param sigma output volatilities
+	void GridVolSurface::getVolatilities(std::span<const double> S, std::span<const double> K,
+										 std::span<const double> T, std::span<const double> b,
+										 std::span<double> sigma) const
+	{
+		const std::size_t n{sigma.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || b.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			sigma[i] = lookup(T[i], std::log(K[i] / S[i]) - b[i] * T[i]);
+		}
+	}
+
+	/// @brief expiries of the grid rows, a single expiry is followed by its copy
+	/// one year later
+	/// @return expiries
+	const std::vector<double>& GridVolSurface::getExpiries() const
+	{
+		return _expiries;
+	}
+
+	/// @brief log forward moneyness nodes of the grid columns, a single node is
+	/// followed by its copy one unit to the right
+	/// @return nodes
+	const std::vector<double>& GridVolSurface::getMoneyness() const
+	{
+		return _moneyness;
+	}
+}
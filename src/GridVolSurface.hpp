@@ -0,0 +1,56 @@
+// Volatility surface interpolated on a grid of quoted volatilities, one row
+// per expiry over a common axis of log forward moneyness. The quotes are
+// stored as total variance sigma^2 T in one contiguous row-major array, and
+// both axes have a bucket table, so a lookup finds its moneyness interval,
+// shared by the two expiry rows around T, and its expiry interval in
+// constant time, then reads four values. A single node or expiry is stored
+// twice so that both axes have an interval.
+// Total variance is linear in moneyness between nodes and flat beyond the
+// first and last node; volatility is flat before the first and after the
+// last expiry.
+
+#ifndef GRIDVOLSURFACE_HPP
+#define GRIDVOLSURFACE_HPP
+
+#include "VolSurface.hpp"
+
+#include <vector>
+
+namespace PricingLibrary {
+
+	class GridVolSurface final : public VolSurface
+	{
+	private:
+		std::vector<double> _expiries;  // increasing expiries
+		std::vector<double> _moneyness; // increasing log forward moneyness nodes
+		std::vector<double> _variance;  // total variance at expiry i and node j: _variance[i * nodes + j]
+		std::vector<double> _expiryScale;    // 1 / (T[i + 1] - T[i])
+		std::vector<double> _moneynessScale; // 1 / (k[j + 1] - k[j])
+		AxisLocator _expiryLocator;     // interval of an expiry
+		AxisLocator _moneynessLocator;  // interval of a moneyness
+
+		// Volatility without a virtual call, shared by the scalar and batch lookups
+		double lookup(double T, double k) const;
+
+	public:
+		GridVolSurface(const std::vector<double>& expiries, const std::vector<double>& moneyness,
+					   const std::vector<double>& volatilities); // default constructor
+		GridVolSurface(const GridVolSurface& source); // copy constructor
+		GridVolSurface& operator= (const GridVolSurface& source); // copy assignment
+		~GridVolSurface(); // destructor
+
+		using VolSurface::getVolatility;
+		// Volatility at maturity T and log forward moneyness k
+		double getVolatility(double T, double k) const override;
+		// Volatilities of contracts stored as contiguous columns
+		void getVolatilities(std::span<const double> S, std::span<const double> K,
+							 std::span<const double> T, std::span<const double> b,
+							 std::span<double> sigma) const override;
+
+		// Grid axes
+		const std::vector<double>& getExpiries() const;
+		const std::vector<double>& getMoneyness() const;
+	};
+}
+
+#endif
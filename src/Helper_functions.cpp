@@ -2,9 +2,205 @@
 
 #include "Helper_functions.hpp"
 #include "iostream"
+#include <iomanip>
 
 namespace Helper_functions
 {
+	namespace
+	{
+		// Parameter columns of a chunk of rows
+		struct ParameterColumns
+		{
+			std::vector<double> S, K, T, sig, r, b;
+
+			explicit ParameterColumns(std::size_t n) : S(n), K(n), T(n), sig(n), r(n), b(n) {}
+		};
+
+		/// @brief load rows [begin, end) of a parameter matrix into columns
+		/// @param parameterMatrix 
+		/// @param begin first row
+		/// @param end one past the last row
+		/// @return columns
+		ParameterColumns load_columns(const std::vector<std::vector<double>>& parameterMatrix,
+									  std::size_t begin, std::size_t end)
+		{
+			ParameterColumns columns(end - begin);
+			for (std::size_t i = 0; i < end - begin; i++)
+			{
+				const std::vector<double>& parameters = parameterMatrix[begin + i];
+				columns.S[i] = parameters[0];
+				columns.K[i] = parameters[1];
+				columns.T[i] = parameters[2];
+				columns.sig[i] = parameters[3];
+				columns.r[i] = parameters[4];
+				columns.b[i] = parameters[5];
+			}
+
+			return columns;
+		}
+
+		/// @brief load points [begin, end) of a parameter grid into columns
+		/// @param grid parameter grid
+		/// @param begin first point
+		/// @param end one past the last point
+		/// @return columns
+		ParameterColumns load_columns(const ParameterGrid& grid, std::size_t begin, std::size_t end)
+		{
+			ParameterColumns columns(end - begin);
+			grid.fill(begin, end, columns.S, columns.K, columns.T, columns.sig, columns.r, columns.b);
+
+			return columns;
+		}
+
+		/// @brief throw if [begin, end) is not a range of grid points
+		/// @param grid parameter grid
+		/// @param begin first point
+		/// @param end one past the last point
+		void check_grid_range(const ParameterGrid& grid, std::size_t begin, std::size_t end)
+		{
+			if (end < begin || end > grid.size())
+			{
+				throw PricingLibrary::IncorrectInputException("Grid range is out of bounds.");
+			}
+		}
+
+		/// @brief compute a chunk of rows of the option price matrix. Serial and
+		/// parallel sweeps share this function, so they give the same results
+		/// @param columns parameters of the chunk
+		/// @param type
+		/// @param function what to compute
+		/// @param optionPrices preallocated result matrix
+		/// @param offset row of the result matrix for the first parameter
+		void compute_option_rows(const ParameterColumns& columns,
+								 const PricingLibrary::Payoff::Type& type, const std::string& function,
+								 std::vector<std::vector<double>>& optionPrices, std::size_t offset)
+		{
+			const std::size_t n{columns.S.size()};
+			std::vector<double> res(n);
+
+			// Prices are computed in one call to the batch pricing path
+			if (function == "price")
+			{
+				std::vector<PricingLibrary::Payoff::Type> types(n, type);
+				PricingLibrary::AnalyticEuropeanEngine::getBatchPrices(columns.S, columns.K, columns.T, columns.sig,
+																	   columns.r, columns.b, types, res);
+			}
+			else
+			{
+				// One payoff object is reused for all rows
+				auto exercise = PricingLibrary::Payoff::European;
+				auto payoff{std::make_shared<PricingLibrary::Payoff>(0.0, 0.0, type, exercise)};
+				for (std::size_t i = 0; i < n; i++)
+				{
+					PricingLibrary::AnalyticEuropeanEngine analytic_engine{columns.S[i], columns.sig[i],
+																		   columns.r[i], columns.b[i]};
+					*payoff = PricingLibrary::Payoff{columns.T[i], columns.K[i], type, exercise};
+					if (function == "delta")
+					{
+						res[i] = analytic_engine.getEngineDelta(payoff);
+					}
+					else if (function == "gamma")
+					{
+						res[i] = analytic_engine.getEngineGamma(payoff);
+					}
+				}
+			}
+
+			// Store the option price in the result matrix.
+			for (std::size_t i = 0; i < n; i++)
+			{
+				optionPrices[offset + i] = {columns.S[i], columns.K[i], columns.T[i],
+											columns.sig[i], columns.r[i], res[i]};
+			}
+		}
+
+		/// @brief compute a chunk of rows of the perpetual american option price matrix
+		/// @param columns parameters of the chunk
+		/// @param type
+		/// @param optionPrices preallocated result matrix
+		/// @param offset row of the result matrix for the first parameter
+		void compute_perpetual_american_option_rows(const ParameterColumns& columns,
+													const PricingLibrary::Payoff::Type& type,
+													std::vector<std::vector<double>>& optionPrices, std::size_t offset)
+		{
+			// Exponents depend only on sigma, r and b and are shared by consecutive
+			// rows that differ in S, K or T only, e.g. a spot or strike ladder
+			using Kernel = PricingLibrary::AnalyticAmericanPerpetualKernel;
+			Kernel::Exponents y{};
+			for (std::size_t i = 0; i < columns.S.size(); i++)
+			{
+				if (i == 0 || columns.sig[i] != columns.sig[i - 1] || columns.r[i] != columns.r[i - 1] ||
+					columns.b[i] != columns.b[i - 1])
+				{
+					y = Kernel::getExponents(columns.sig[i], columns.r[i], columns.b[i]);
+				}
+				double option_price = Kernel::getPrice(type, columns.S[i], columns.K[i], y);
+				// Store the option price in the result matrix.
+				optionPrices[offset + i] = {columns.S[i], columns.K[i], columns.T[i],
+											columns.sig[i], columns.r[i], option_price};
+			}
+		}
+
+		/// @brief compute option values for rows [begin, end) of a parameter source
+		/// @param source parameter matrix or grid
+		/// @param begin first row
+		/// @param end one past the last row
+		/// @param type
+		/// @param function what to compute
+		/// @param executor parallel sweep executor, serial if null
+		/// @return matrix with end - begin rows
+		template <typename Source>
+		std::vector<std::vector<double>> compute_option_range(const Source& source, std::size_t begin, std::size_t end,
+															  const PricingLibrary::Payoff::Type& type, const std::string& function,
+															  PricingLibrary::SweepExecutor* executor)
+		{
+			std::vector<std::vector<double>> optionPrices(end - begin);
+			auto task = [&](std::size_t first, std::size_t last)
+			{
+				compute_option_rows(load_columns(source, begin + first, begin + last), type, function, optionPrices, first);
+			};
+			if (executor)
+			{
+				executor->run(end - begin, task);
+			}
+			else
+			{
+				task(0, end - begin);
+			}
+
+			return optionPrices;
+		}
+
+		/// @brief compute perpetual american option prices for rows [begin, end) of a parameter source
+		/// @param source parameter matrix or grid
+		/// @param begin first row
+		/// @param end one past the last row
+		/// @param type
+		/// @param executor parallel sweep executor, serial if null
+		/// @return matrix with end - begin rows
+		template <typename Source>
+		std::vector<std::vector<double>> compute_perpetual_american_option_range(const Source& source, std::size_t begin, std::size_t end,
+																				 const PricingLibrary::Payoff::Type& type,
+																				 PricingLibrary::SweepExecutor* executor)
+		{
+			std::vector<std::vector<double>> optionPrices(end - begin);
+			auto task = [&](std::size_t first, std::size_t last)
+			{
+				compute_perpetual_american_option_rows(load_columns(source, begin + first, begin + last), type, optionPrices, first);
+			};
+			if (executor)
+			{
+				executor->run(end - begin, task);
+			}
+			else
+			{
+				task(0, end - begin);
+			}
+
+			return optionPrices;
+		}
+	}
+
 	/// @brief Generate a mesh vector from min_value 
 	/// till max_value with certain step
 	/// @param min_value
@@ -41,26 +237,8 @@ namespace Helper_functions
 														const std::vector<double>& rate,
 														double b)
 	{
-		// If b is -1, then it equals to rate, otherwise it has certain value
-		bool tmp = (std::abs(b + 1.0) <= 0.01) ? 1:0;
-		// Create result vector
-		std::vector<std::vector<double>> res;
-		// Iterate through all input parameter vectors
-		for (const auto& T : expiry)
-		{
-			for (const auto& sigma : volatility)
-			{
-				for (const auto& r : rate)
-				{
-					if (tmp) 
-					{
-						b=r;
-					}
-					res.push_back({S, K, T, sigma, r, b});
-				}
-			}
-		}
-		return res;
+		ParameterGrid grid(S, K, expiry, volatility, rate, b);
+		return grid.materialize(0, grid.size());
 	}
 
 	/// @brief compute call option prices for a matrix of parameters.
@@ -85,31 +263,20 @@ namespace Helper_functions
 	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
 																			  const PricingLibrary::Payoff::Type& type) 
 	{
-		std::vector<std::vector<double>> optionPrices;
-
-		auto exercise = PricingLibrary::Payoff::American;
-		for (const std::vector<double>& parameters : parameterMatrix) {
-
-			double S = parameters[0];
-			double K = parameters[1];
-			double T = parameters[2];
-			double sig = parameters[3];
-			double r = parameters[4];
-			double b = parameters[5];
-
-			auto analytic_perpetual_engine{std::make_shared<PricingLibrary::AnalyticAmericanPerpetualEngine>(S, 
-																	  sig, 
-																	  r, 
-																	  b)};
-			auto payoff_perpetual{std::make_shared<PricingLibrary::Payoff>(T, 
-									   K, type, exercise)};
-		   PricingLibrary::ExoticOption perpetual_option{payoff_perpetual, analytic_perpetual_engine};
-			double option_price = perpetual_option.getPrice();
-			// Store the option price in the result matrix.
-			optionPrices.push_back({S, K, T, sig, r, option_price});
-		}
+		return compute_perpetual_american_option_range(parameterMatrix, 0, parameterMatrix.size(), type, nullptr);
+	}
 
-		return optionPrices;
+	/// @brief compute perpetual american option prices for a matrix of parameters
+	/// on several threads. Rows keep the order of the parameter matrix
+	/// @param parameterMatrix 
+	/// @param type
+	/// @param executor parallel sweep executor
+	/// @return matrix, rows not reached by a cancelled sweep are empty
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
+																			  const PricingLibrary::Payoff::Type& type,
+																			  PricingLibrary::SweepExecutor& executor)
+	{
+		return compute_perpetual_american_option_range(parameterMatrix, 0, parameterMatrix.size(), type, &executor);
 	}
 
 	/// @brief compute call option delta for a matrix of parameters.
@@ -152,39 +319,80 @@ namespace Helper_functions
 	std::vector<std::vector<double>> compute_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
 														   const PricingLibrary::Payoff::Type& type, const std::string& function) 
 	{
-		std::vector<std::vector<double>> optionPrices;
+		return compute_option_range(parameterMatrix, 0, parameterMatrix.size(), type, function, nullptr);
+	}
 
-		for (const std::vector<double>& parameters : parameterMatrix) {
+	/// @brief compute option prices for a matrix of parameters on several threads.
+	/// Rows keep the order of the parameter matrix and equal the serial results
+	/// @param parameterMatrix 
+	/// @param type
+	/// @param function what to compute
+	/// @param executor parallel sweep executor
+	/// @return vector with option prices, rows not reached by a cancelled sweep are empty
+	std::vector<std::vector<double>> compute_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
+														   const PricingLibrary::Payoff::Type& type, const std::string& function,
+														   PricingLibrary::SweepExecutor& executor)
+	{
+		return compute_option_range(parameterMatrix, 0, parameterMatrix.size(), type, function, &executor);
+	}
 
-			double S = parameters[0];
-			double K = parameters[1];
-			double T = parameters[2];
-			double sig = parameters[3];
-			double r = parameters[4];
-			double b = parameters[5];
-			auto exercise = PricingLibrary::Payoff::European;
+	/// @brief compute option values for points [begin, end) of a parameter grid.
+	/// Only the requested chunk of the grid is generated
+	/// @param grid parameter grid
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @param type
+	/// @param function what to compute
+	/// @return matrix with end - begin rows
+	std::vector<std::vector<double>> compute_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+														   const PricingLibrary::Payoff::Type& type, const std::string& function)
+	{
+		check_grid_range(grid, begin, end);
+		return compute_option_range(grid, begin, end, type, function, nullptr);
+	}
 
-			auto analytic_engine{std::make_shared<PricingLibrary::AnalyticEuropeanEngine>(S, sig, r, b)};
-			auto payoff_call{std::make_shared<PricingLibrary::Payoff>(T, K, type, exercise)};
-			PricingLibrary::VanillaOption myEuropeanOption{payoff_call, analytic_engine};
-			double res{};
-			if (function == "price")
-			{
-				res = myEuropeanOption.getPrice();
-			}
-			else if (function == "delta")
-			{
-				res = myEuropeanOption.getDelta();
-			}
-			else if (function == "gamma")
-			{
-				res = myEuropeanOption.getGamma();
-			}
-			// Store the option price in the result matrix.
-			optionPrices.push_back({S, K, T, sig, r, res});
-		}
+	/// @brief compute option values for points [begin, end) of a parameter grid on several threads
+	/// @param grid parameter grid
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @param type
+	/// @param function what to compute
+	/// @param executor parallel sweep executor
+	/// @return matrix with end - begin rows, rows not reached by a cancelled sweep are empty
+	std::vector<std::vector<double>> compute_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+														   const PricingLibrary::Payoff::Type& type, const std::string& function,
+														   PricingLibrary::SweepExecutor& executor)
+	{
+		check_grid_range(grid, begin, end);
+		return compute_option_range(grid, begin, end, type, function, &executor);
+	}
 
-		return optionPrices;
+	/// @brief compute perpetual american option prices for points [begin, end) of a parameter grid
+	/// @param grid parameter grid
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @param type
+	/// @return matrix with end - begin rows
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+																			  const PricingLibrary::Payoff::Type& type)
+	{
+		check_grid_range(grid, begin, end);
+		return compute_perpetual_american_option_range(grid, begin, end, type, nullptr);
+	}
+
+	/// @brief compute perpetual american option prices for points [begin, end) of a parameter grid on several threads
+	/// @param grid parameter grid
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @param type
+	/// @param executor parallel sweep executor
+	/// @return matrix with end - begin rows, rows not reached by a cancelled sweep are empty
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+																			  const PricingLibrary::Payoff::Type& type,
+																			  PricingLibrary::SweepExecutor& executor)
+	{
+		check_grid_range(grid, begin, end);
+		return compute_perpetual_american_option_range(grid, begin, end, type, &executor);
 	}
 
 	/// @brief print option price with parameter values
@@ -201,4 +409,20 @@ namespace Helper_functions
 			std::cout << "Option price: " << std::setw(fieldWidth) << parameters[5] << '\n';
 		}
 	}
-}
\ No newline at end of file
+
+	/// @brief write option prices to a result sink, much faster than print_option_prices
+	/// for large sweeps since no stream formatting is done per value
+	/// @param optionPrice rows of underlying, strike, expiration, volatility, rate and price
+	/// @param sink sink with the columns of option_price_columns
+	void print_option_prices(const std::vector<std::vector<double>>& optionPrice, PricingLibrary::ResultSink& sink)
+	{
+		sink.write(optionPrice);
+	}
+
+	/// @brief column names of the rows returned by the compute functions
+	/// @return column names
+	std::vector<std::string> option_price_columns()
+	{
+		return {"underlying", "strike", "expiration", "volatility", "rate", "price"};
+	}
+}
@@ -8,6 +8,10 @@
 #include "AnalyticAmericanPerpetualEngine.hpp"
 #include "VanillaOption.hpp"
 #include "ExoticOption.hpp"
+#include "SweepExecutor.hpp"
+#include "ParameterGrid.hpp"
+#include "ResultSink.hpp"
+#include <string>
 #include <vector>
 
 namespace Helper_functions
@@ -37,11 +41,35 @@ namespace Helper_functions
 	// Compute option price given matrix of parameters
 	std::vector<std::vector<double>> compute_option_prices(const std::vector<std::vector<double>>& parameterMatrix, 
 														   const PricingLibrary::Payoff::Type& type, const std::string& function);
+	// Compute option price given matrix of parameters on several threads
+	std::vector<std::vector<double>> compute_option_prices(const std::vector<std::vector<double>>& parameterMatrix, 
+														   const PricingLibrary::Payoff::Type& type, const std::string& function,
+														   PricingLibrary::SweepExecutor& executor);
 	// Compute perpetual american option price
 	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
                                                                               const PricingLibrary::Payoff::Type& type);
+	// Compute perpetual american option price on several threads
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const std::vector<std::vector<double>>& parameterMatrix,
+                                                                              const PricingLibrary::Payoff::Type& type,
+                                                                              PricingLibrary::SweepExecutor& executor);
+	// Compute option price for points [begin, end) of a parameter grid
+	std::vector<std::vector<double>> compute_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+														   const PricingLibrary::Payoff::Type& type, const std::string& function);
+	std::vector<std::vector<double>> compute_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+														   const PricingLibrary::Payoff::Type& type, const std::string& function,
+														   PricingLibrary::SweepExecutor& executor);
+	// Compute perpetual american option price for points [begin, end) of a parameter grid
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+																			  const PricingLibrary::Payoff::Type& type);
+	std::vector<std::vector<double>> compute_perpetual_american_option_prices(const ParameterGrid& grid, std::size_t begin, std::size_t end,
+																			  const PricingLibrary::Payoff::Type& type,
+																			  PricingLibrary::SweepExecutor& executor);
 	// Print option prices
 	void print_option_prices(const std::vector<std::vector<double>>& optionPrice);
+	// Write option prices to a result sink created with option_price_columns
+	void print_option_prices(const std::vector<std::vector<double>>& optionPrice, PricingLibrary::ResultSink& sink);
+	// Column names of the rows returned by the compute functions
+	std::vector<std::string> option_price_columns();
 };
 
 #endif
\ No newline at end of file
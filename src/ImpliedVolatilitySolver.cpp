@@ -0,0 +1,214 @@
+// Implementation of the header file ImpliedVolatilitySolver.hpp
+
+#include "ImpliedVolatilitySolver.hpp"
+#include "StandardNormal.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Bounds of the total volatility sigma * sqrt(T) during iterations
+		constexpr double min_total_vol = 1e-8;
+		constexpr double max_total_vol = 10.0;
+		// Smallest model price used in logarithms
+		constexpr double min_price = 1e-300;
+	}
+
+	/// @brief Default constructor
+	/// @param iterations number of Halley iterations
+	/// @param tolerance relative price error accepted as converged
+	ImpliedVolatilitySolver::ImpliedVolatilitySolver(std::size_t iterations, double tolerance)
+	: _iterations{iterations}, _tolerance{tolerance} {}
+
+	/// @brief Copy constructor
+	/// @param source ImpliedVolatilitySolver object
+	ImpliedVolatilitySolver::ImpliedVolatilitySolver(const ImpliedVolatilitySolver& source)
+	: _iterations{source._iterations}, _tolerance{source._tolerance}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source ImpliedVolatilitySolver object
+	/// @return ImpliedVolatilitySolver object
+	ImpliedVolatilitySolver& ImpliedVolatilitySolver::operator= (const ImpliedVolatilitySolver& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_iterations = source._iterations;
+		_tolerance = source._tolerance;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	ImpliedVolatilitySolver::~ImpliedVolatilitySolver() {}
+
+	/// @brief implied volatility of one quote
+	/// @param price option price
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type option type
+	/// @param status result of the solve
+	/// @return volatility
+	double ImpliedVolatilitySolver::solve(double price, double S, double K, double T, double r, double b,
+										  Payoff::Type type, Status& status) const
+	{
+		double volatility{};
+		solve(std::span<const double>(&price, 1), std::span<const double>(&S, 1), std::span<const double>(&K, 1),
+			  std::span<const double>(&T, 1), std::span<const double>(&r, 1), std::span<const double>(&b, 1),
+			  std::span<const Payoff::Type>(&type, 1), std::span<double>(&volatility, 1), std::span<Status>(&status, 1));
+
+		return volatility;
+	}
+
+	/// @brief implied volatilities of a batch of quotes.
+	/// Prices are converted to undiscounted out-of-the-money forward prices q, using the
+	/// put-call parity of AnalyticEuropeanEngine, and the equation ln(q(s)) = ln(q) is solved
+	/// for the total volatility s = sigma * sqrt(T) with Halley's method, starting from the
+	/// Corrado-Miller approximation. Four iterations give a relative volatility error
+	/// below 1e-11 for quotes within four standard deviations of the forward
+	/// @param price option prices
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param r risk-free rates
+	/// @param b cost-of-carry parameters
+	/// @param type option types
+	/// @param volatility output volatilities, NaN when there is no solution
+	/// @param status output status of each solve
+	void ImpliedVolatilitySolver::solve(std::span<const double> price, std::span<const double> S, std::span<const double> K,
+										std::span<const double> T, std::span<const double> r, std::span<const double> b,
+										std::span<const Payoff::Type> type, std::span<double> volatility,
+										std::span<Status> status) const
+	{
+		const std::size_t n{price.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || r.size() != n || b.size() != n ||
+			type.size() != n || volatility.size() != n || status.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		constexpr std::size_t block_size{256};
+		// Per quote state of a block
+		double x[block_size];       // log-moneyness ln(F/K)
+		double F[block_size];       // forward
+		double strike[block_size];  // strike
+		double q[block_size];       // target out-of-the-money forward price
+		double theta[block_size];   // +1 for an out-of-the-money call, -1 for a put
+		double s[block_size];       // total volatility
+		// Normal distribution arguments and values
+		double d[3 * block_size];
+		double N_d[3 * block_size];
+
+		for (std::size_t start = 0; start < n; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, n - start)};
+
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				status[i] = Converged;
+				// Put prices are not checked for sign, the put-call parity used by the engine
+				// gives negative put prices for b < r, and the bounds are checked on q below
+				if (!(S[i] > 0.0 && K[i] > 0.0 && T[i] > 0.0) || !std::isfinite(price[i]) ||
+					!std::isfinite(r[i]) || !std::isfinite(b[i]))
+				{
+					status[i] = InvalidInput;
+				}
+
+				const double df = std::exp(-r[i] * T[i]);
+				// Call price from the put price by put-call parity, as in AnalyticEuropeanKernel
+				const double call = (type[i] == Payoff::Type::Call) ? price[i] : price[i] + S[i] - K[i] * df;
+				const double c = call / df;
+				F[j] = S[i] * std::exp(b[i] * T[i]);
+				strike[j] = K[i];
+				x[j] = std::log(F[j] / K[i]);
+				theta[j] = (F[j] > K[i]) ? -1.0 : 1.0;
+				q[j] = (theta[j] > 0) ? c : c - (F[j] - K[i]);
+				if (status[i] == Converged && q[j] <= 0.0)
+				{
+					status[i] = BelowIntrinsic;
+				}
+				if (status[i] == Converged && c >= F[j])
+				{
+					status[i] = AboveMaximum;
+				}
+				if (status[i] != Converged)
+				{
+					// Harmless values keep the iterations finite
+					F[j] = strike[j] = 1.0;
+					x[j] = 0.0;
+					theta[j] = 1.0;
+					q[j] = 0.1;
+				}
+
+				// Corrado-Miller initial guess
+				const double mid = c - (F[j] - strike[j]) / 2;
+				const double discriminant = mid * mid - (F[j] - strike[j]) * (F[j] - strike[j]) / std::numbers::pi;
+				double guess = std::sqrt(2 * std::numbers::pi) / (F[j] + strike[j])
+							 * (mid + std::sqrt(std::max(discriminant, 0.0)));
+				if (status[i] != Converged || !(guess > 0.0))
+				{
+					guess = std::sqrt(2 * std::abs(x[j])) + 0.1;
+				}
+				s[j] = std::clamp(guess, 1e-4, max_total_vol);
+			}
+
+			for (std::size_t iteration = 0; iteration <= _iterations; iteration++)
+			{
+				for (std::size_t j = 0; j < m; j++)
+				{
+					const double d1 = x[j] / s[j] + s[j] / 2;
+					d[j] = theta[j] * d1;
+					d[m + j] = theta[j] * (d1 - s[j]);
+					d[2 * m + j] = d1;
+				}
+				StandardNormal::cdf(std::span<const double>(d, 2 * m), std::span<double>(N_d, 2 * m));
+				StandardNormal::pdf(std::span<const double>(d + 2 * m, m), std::span<double>(N_d + 2 * m, m));
+
+				if (iteration == _iterations)
+				{
+					// Final price error decides convergence
+					for (std::size_t j = 0; j < m; j++)
+					{
+						const std::size_t i{start + j};
+						const double model = theta[j] * (F[j] * N_d[j] - strike[j] * N_d[m + j]);
+						if (status[i] == Converged && !(std::abs(model - q[j]) <= _tolerance * q[j]))
+						{
+							status[i] = NotConverged;
+						}
+						volatility[i] = (status[i] == Converged || status[i] == NotConverged) ?
+										s[j] / std::sqrt(T[i]) : std::numeric_limits<double>::quiet_NaN();
+					}
+					break;
+				}
+
+				for (std::size_t j = 0; j < m; j++)
+				{
+					const double d1 = d[2 * m + j];
+					const double d2 = d1 - s[j];
+					const double model = std::max(theta[j] * (F[j] * N_d[j] - strike[j] * N_d[m + j]), min_price);
+					const double vega = F[j] * N_d[2 * m + j];
+					// Halley step for g(s) = ln(model) - ln(q)
+					const double g = std::log(model / q[j]);
+					const double g1 = vega / model;
+					const double g2 = vega * d1 * d2 / (s[j] * model) - g1 * g1;
+					const double ratio = g / g1;
+					const double step = -ratio / (1 - 0.5 * ratio * g2 / g1);
+					s[j] = std::clamp(s[j] + (std::isfinite(step) ? step : 0.0), min_total_vol, max_total_vol);
+				}
+			}
+		}
+	}
+}
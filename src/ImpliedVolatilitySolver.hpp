@@ -0,0 +1,45 @@
+// Solver for Black-Scholes implied volatility of European options,
+// the inverse of the AnalyticEuropeanEngine price. Whole arrays of quotes
+// are solved in blocks with a fixed number of Halley iterations, so there is
+// no data dependent branching and the normal distribution is evaluated
+// through its vectorized array functions.
+
+#ifndef IMPLIEDVOLATILITYSOLVER_HPP
+#define IMPLIEDVOLATILITYSOLVER_HPP
+
+#include "Payoff.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace PricingLibrary {
+
+	class ImpliedVolatilitySolver
+	{
+	public:
+		// Result of the solve for one quote
+		enum Status {Converged=0, NotConverged=1, BelowIntrinsic=2, AboveMaximum=3, InvalidInput=4};
+
+	private:
+		std::size_t _iterations; // number of Halley iterations
+		double _tolerance;       // relative price error accepted as converged
+
+	public:
+		ImpliedVolatilitySolver(std::size_t iterations=4, double tolerance=1e-8); // default constructor
+		ImpliedVolatilitySolver(const ImpliedVolatilitySolver& source); // copy constructor
+		ImpliedVolatilitySolver& operator= (const ImpliedVolatilitySolver& source); // copy assignment
+		~ImpliedVolatilitySolver(); // destructor
+
+		// Implied volatility of one quote
+		double solve(double price, double S, double K, double T, double r, double b,
+					 Payoff::Type type, Status& status) const;
+		// Implied volatilities of a batch of quotes stored as contiguous columns
+		void solve(std::span<const double> price, std::span<const double> S, std::span<const double> K,
+				   std::span<const double> T, std::span<const double> r, std::span<const double> b,
+				   std::span<const Payoff::Type> type, std::span<double> volatility,
+				   std::span<Status> status) const;
+	};
+}
+
+#endif
@@ -0,0 +1,31 @@
+// Used when inputs passed to a pricing routine are inconsistent
+
+#ifndef INCORRECTINPUTEXCEPTION_HPP
+#define INCORRECTINPUTEXCEPTION_HPP
+
+#include "EngineException.hpp"
+#include <sstream>
+#include <string>
+
+namespace PricingLibrary {
+
+	class IncorrectInputException : public EngineException
+	{
+	private:
+		std::string _message;
+
+	public:
+		IncorrectInputException(const std::string& message) : _message(message) {} // default constructor
+		~IncorrectInputException() {}   // default destructor
+
+		std::string what() const // print exception message
+		{
+			std::stringstream ss;
+			ss << "Incorrect Input.\n" << _message;
+
+			return ss.str();
+		}
+	};
+}
+
+#endif
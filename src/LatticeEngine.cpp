@@ -0,0 +1,320 @@
+// Implementation of the header file LatticeEngine.hpp
+
+#include "LatticeEngine.hpp"
+#include "StandardNormal.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Black-Scholes value with time t to expiry, used for BBS smoothing
+		double blackScholes(double S, double K, double t, double sigma, double r, double b, Payoff::Type type)
+		{
+			const double d1 = (std::log(S / K) + (b + sigma * sigma / 2) * t) / (sigma * std::sqrt(t));
+			const double d2 = d1 - sigma * std::sqrt(t);
+			const double theta = (type == Payoff::Type::Call) ? 1.0 : -1.0;
+
+			return theta * (S * std::exp((b - r) * t) * StandardNormal::cdf(theta * d1)
+						  - K * std::exp(-r * t) * StandardNormal::cdf(theta * d2));
+		}
+
+		// Throw unless the branch probabilities of a time step lie in [0, 1],
+		// which fails for too few time steps when the carry is large against the volatility
+		void checkProbabilities(double up, double down, double middle)
+		{
+			auto valid = [](double p) { return p >= 0.0 && p <= 1.0; };
+			if (!(valid(up) && valid(down) && valid(middle)))
+			{
+				throw IncorrectInputException("Lattice branch probabilities are outside [0, 1], use more time steps.");
+			}
+		}
+	}
+
+	/// @brief Default constructor
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param steps number of time steps
+	/// @param tree binomial or trinomial
+	/// @param smoothing treatment of the last time step
+	LatticeEngine::LatticeEngine(double S, double sigma, double r, double b, std::size_t steps,
+								 Tree tree, Smoothing smoothing)
+	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _steps{steps}, _tree{tree}, _smoothing{smoothing}, _values{},
+	  _solved{false}, _lastMaturity{}, _lastStrike{}, _lastType{Payoff::Call}, _lastExercise{Payoff::European}, _last{}
+	{}
+
+	/// @brief Copy constructor, the buffer is not copied
+	/// @param source LatticeEngine object
+	LatticeEngine::LatticeEngine(const LatticeEngine& source)
+	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b},
+	  _steps{source._steps}, _tree{source._tree}, _smoothing{source._smoothing}, _values{},
+	  _solved{false}, _lastMaturity{}, _lastStrike{}, _lastType{Payoff::Call}, _lastExercise{Payoff::European}, _last{}
+	{}
+
+	/// @brief Copy assignment, the buffer is kept
+	/// @param source LatticeEngine object
+	/// @return LatticeEngine object
+	LatticeEngine& LatticeEngine::operator= (const LatticeEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		PricingEngine::operator=(source);
+		_S = source._S;
+		_sigma = source._sigma;
+		_r = source._r;
+		_b = source._b;
+		_steps = source._steps;
+		_tree = source._tree;
+		_smoothing = source._smoothing;
+		_solved = false;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	LatticeEngine::~LatticeEngine() {}
+
+	/// @brief Validate if engine was passed to a correct option
+	/// @param exercise American or European
+	void LatticeEngine::validate(const Payoff::Exercise& exercise) const
+	{
+		if (exercise != Payoff::European && exercise != Payoff::American)
+		{
+			throw IncorrectEngineException("Only European and American Options can be priced on the lattice.");
+		}
+	}
+
+	/// @brief roll back a lattice from expiry to today. The discounted branch
+	/// probabilities are computed once; node values of a time step overwrite those
+	/// of the next one in the same buffer, and underlying prices of a time step are
+	/// generated by multiplying with the node ratio
+	/// @param K strike price
+	/// @param T maturity
+	/// @param type call or put
+	/// @param exercise european or american
+	/// @param steps number of time steps
+	/// @return price, delta, gamma and theta
+	Greeks LatticeEngine::roll(double K, double T, Payoff::Type type, Payoff::Exercise exercise,
+							   std::size_t steps) const
+	{
+		const bool american{exercise == Payoff::American};
+		const bool binomial{_tree == Binomial};
+		const double dt{T / steps};
+		const double df{std::exp(-_r * dt)};
+
+		// Up factor, ratio of neighbouring nodes and discounted branch probabilities
+		double u{}, ratio{}, pu{}, pm{}, pd{};
+		if (binomial)
+		{
+			u = std::exp(_sigma * std::sqrt(dt));
+			ratio = u * u;
+			const double p{(std::exp(_b * dt) - 1 / u) / (u - 1 / u)};
+			checkProbabilities(p, 1 - p, 0.0);
+			pu = df * p;
+			pd = df * (1 - p);
+		}
+		else
+		{
+			u = std::exp(_sigma * std::sqrt(2 * dt));
+			ratio = u;
+			const double a{std::exp(_sigma * std::sqrt(dt / 2))};
+			const double growth{std::exp(_b * dt / 2)};
+			const double p_up{std::pow((growth - 1 / a) / (a - 1 / a), 2)};
+			const double p_down{std::pow((a - growth) / (a - 1 / a), 2)};
+			checkProbabilities(p_up, p_down, 1 - p_up - p_down);
+			pu = df * p_up;
+			pm = df * (1 - p_up - p_down);
+			pd = df * p_down;
+		}
+		// Number of nodes and lowest underlying price of time step n
+		auto width = [binomial](std::size_t n) { return binomial ? n + 1 : 2 * n + 1; };
+		auto lowest = [&](std::size_t n) { return _S * std::pow(u, -static_cast<double>(n)); };
+		auto exerciseValue = [&](double s) { return std::max((type == Payoff::Type::Call) ? s - K : K - s, 0.0); };
+
+		// Values at expiry, or with smoothing Black-Scholes values one step before
+		const std::size_t last{(_smoothing == None) ? steps : steps - 1};
+		_values.resize(width(steps));
+		double s{lowest(last)};
+		for (std::size_t j = 0; j < width(last); j++, s *= ratio)
+		{
+			_values[j] = (_smoothing == None) ? exerciseValue(s) : blackScholes(s, K, dt, _sigma, _r, _b, type);
+			if (american)
+			{
+				_values[j] = std::max(_values[j], exerciseValue(s));
+			}
+		}
+
+		// Nodes kept for the Greeks, taken from the starting values when the
+		// smoothed lattice starts at the second time step
+		double level2[3]{};
+		double level1[3]{};
+		auto keep = [&](std::size_t n)
+		{
+			if (n == 2 && binomial)
+			{
+				std::copy(_values.begin(), _values.begin() + 3, level2);
+			}
+			if (n == 1)
+			{
+				std::copy(_values.begin(), _values.begin() + width(1), level1);
+			}
+		};
+		keep(last);
+		for (std::size_t n = last; n-- > 0;)
+		{
+			s = lowest(n);
+			for (std::size_t j = 0; j < width(n); j++, s *= ratio)
+			{
+				const double continuation{binomial ? pu * _values[j + 1] + pd * _values[j]
+												   : pu * _values[j + 2] + pm * _values[j + 1] + pd * _values[j]};
+				_values[j] = american ? std::max(continuation, exerciseValue(s)) : continuation;
+			}
+			keep(n);
+		}
+
+		Greeks result;
+		result.price = _values[0];
+		if (binomial)
+		{
+			const double Su{_S * u}, Sd{_S / u}, Suu{_S * u * u}, Sdd{_S / (u * u)};
+			result.delta = (level1[1] - level1[0]) / (Su - Sd);
+			result.gamma = ((level2[2] - level2[1]) / (Suu - _S) - (level2[1] - level2[0]) / (_S - Sdd)) / ((Suu - Sdd) / 2);
+			result.theta = (level2[1] - result.price) / (2 * dt);
+		}
+		else
+		{
+			const double Su{_S * u}, Sd{_S / u};
+			result.delta = (level1[2] - level1[0]) / (Su - Sd);
+			result.gamma = ((level1[2] - level1[1]) / (Su - _S) - (level1[1] - level1[0]) / (_S - Sd)) / ((Su - Sd) / 2);
+			result.theta = (level1[1] - result.price) / dt;
+		}
+
+		return result;
+	}
+
+	/// @brief solve the lattice unless the payoff equals the last one solved.
+	/// BBSR combines the BBS lattices of N and N/2 steps as 2 V(N) - V(N/2),
+	/// which removes the leading error term
+	/// @param payoff Payoff object
+	/// @return price, delta, gamma and theta
+	const Greeks& LatticeEngine::solve(const std::shared_ptr<Payoff>& payoff) const
+	{
+		validate(payoff->getExercise());
+
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const Payoff::Type type{payoff->getType()};
+		const Payoff::Exercise exercise{payoff->getExercise()};
+		if (_solved && K == _lastStrike && T == _lastMaturity && type == _lastType && exercise == _lastExercise)
+		{
+			return _last;
+		}
+		// The Greeks need two time steps before smoothing
+		const std::size_t minimum{(_smoothing == BBSR) ? 6u : 3u};
+		if (!(K > 0.0 && T > 0.0 && _S > 0.0) || _steps < minimum)
+		{
+			throw IncorrectInputException("Lattice engine needs positive S, K, T and more time steps.");
+		}
+
+		Greeks result = roll(K, T, type, exercise, _steps);
+		if (_smoothing == BBSR)
+		{
+			const Greeks coarse = roll(K, T, type, exercise, _steps / 2);
+			result.price = 2 * result.price - coarse.price;
+			result.delta = 2 * result.delta - coarse.delta;
+			result.gamma = 2 * result.gamma - coarse.gamma;
+			result.theta = 2 * result.theta - coarse.theta;
+		}
+
+		_last = result;
+		_lastStrike = K;
+		_lastMaturity = T;
+		_lastType = type;
+		_lastExercise = exercise;
+		_solved = true;
+
+		return _last;
+	}
+
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double LatticeEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).price;
+	}
+
+	/// @brief return delta greek
+	/// @param payoff Payoff object
+	/// @return delta
+	double LatticeEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).delta;
+	}
+
+	/// @brief return gamma greek
+	/// @param payoff Payoff object
+	/// @return gamma
+	double LatticeEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).gamma;
+	}
+
+	/// @brief return theta greek
+	/// @param payoff Payoff object
+	/// @return theta
+	double LatticeEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return solve(payoff).theta;
+	}
+
+	/*! \warning Not implemented calculation of Vega greek */
+	double LatticeEngine::getEngineVega(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/// @brief return price and Greeks selected by mask from one roll back
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks LatticeEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
+	{
+		const Greeks& solution = solve(payoff);
+		Greeks result;
+		if (mask & Greeks::Price)
+		{
+			result.price = solution.price;
+		}
+		if (mask & Greeks::Delta)
+		{
+			result.delta = solution.delta;
+		}
+		if (mask & Greeks::Gamma)
+		{
+			result.gamma = solution.gamma;
+		}
+		if (mask & Greeks::Vega)
+		{
+			result.vega = getEngineVega(payoff);
+		}
+		if (mask & Greeks::Theta)
+		{
+			result.theta = solution.theta;
+		}
+		if (mask & Greeks::Rho)
+		{
+			result.rho = getEngineRho(payoff);
+		}
+
+		return result;
+	}
+}
@@ -0,0 +1,76 @@
+// Define engine to price european and american options on a recombining
+// Cox-Ross-Rubinstein binomial or Boyle trinomial lattice, the latter with the
+// squared branch probabilities given by Haug. Values are rolled back in one
+// buffer of the width of the last time step, which is allocated once per
+// engine and reused, so an engine object must not be shared between threads.
+// Price, delta, gamma and theta come from the first nodes.
+
+#ifndef LATTICEENGINE_HPP
+#define LATTICEENGINE_HPP
+
+#include "PricingEngine.hpp"
+#include "EngineException.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class LatticeEngine : public PricingEngine
+	{
+	public:
+		enum Tree {Binomial=1, Trinomial=2};
+		// None: payoff at expiry, BBS: Black-Scholes values one step before
+		// expiry, BBSR: BBS with Richardson extrapolation from N and N/2 steps
+		enum Smoothing {None=0, BBS=1, BBSR=2};
+
+	private:
+		double _S;       // underlying price
+		double _sigma;   // volatility
+		double _r;       // risk-free rate
+		double _b;       // cost of carry
+		std::size_t _steps;    // number of time steps
+		Tree _tree;            // binomial or trinomial
+		Smoothing _smoothing;  // treatment of the last time step
+
+		mutable std::vector<double> _values; // rolling buffer of node values
+
+		// Last solved contract and its results
+		mutable bool _solved;
+		mutable double _lastMaturity;
+		mutable double _lastStrike;
+		mutable Payoff::Type _lastType;
+		mutable Payoff::Exercise _lastExercise;
+		mutable Greeks _last;
+
+		// Solve the lattice for the payoff unless it was the last one solved
+		const Greeks& solve(const std::shared_ptr<Payoff>& payoff) const;
+		// Roll back a lattice of given number of steps
+		Greeks roll(double K, double T, Payoff::Type type, Payoff::Exercise exercise, std::size_t steps) const;
+
+	public:
+		LatticeEngine(double S, double sigma, double r, double b, std::size_t steps=500,
+					  Tree tree=Binomial, Smoothing smoothing=None); // default constructor
+		LatticeEngine(const LatticeEngine& source); // copy constructor
+		LatticeEngine& operator= (const LatticeEngine& source); // copy assignment
+		~LatticeEngine(); // destructor
+
+		// Get option price
+		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
+		// Greeks from the first lattice nodes
+		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+		// Not implemented
+		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		// Price, delta, gamma and theta from one roll back
+		Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const override;
+
+		// Validate if engine was passed to a correct option
+		void validate(const Payoff::Exercise& exercise) const override;
+	};
+}
+
+#endif
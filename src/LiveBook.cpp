@@ -0,0 +1,320 @@
+// Implementation of the header file LiveBook.hpp
+
+#include "LiveBook.hpp"
+#include "StandardNormal.hpp"
+#include "BlackScholesKernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Fewest contracts per thread when an underlying is repriced on several
+		// threads, below it waking a thread of the pool costs more than it saves
+		constexpr std::size_t contracts_per_thread{4096};
+	}
+
+	/// @brief Default constructor
+	/// @param threads number of threads repricing one underlying, 0 uses all hardware threads
+	/// @param precision precision of the normal distribution
+	LiveBook::LiveBook(std::size_t threads, Precision precision)
+	: _underlyings{}, _batch{0}, _threads{threads}, _precision{precision}, _contracts{}, _pool{}
+	{}
+
+	/// @brief Copy constructor, the copy starts its own threads when it needs them
+	/// @param source LiveBook object
+	LiveBook::LiveBook(const LiveBook& source)
+	: _underlyings{source._underlyings}, _batch{source._batch}, _threads{source._threads},
+	  _precision{source._precision}, _contracts{source._contracts}, _pool{}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source LiveBook object
+	/// @return LiveBook object
+	LiveBook& LiveBook::operator= (const LiveBook& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_underlyings = source._underlyings;
+		_batch = source._batch;
+		if (_threads != source._threads)
+		{
+			_pool.reset();
+		}
+		_threads = source._threads;
+		_precision = source._precision;
+		_contracts = source._contracts;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	LiveBook::~LiveBook() {}
+
+	/// @brief underlying by index
+	/// @param underlying index of the underlying
+	/// @return underlying
+	LiveBook::Underlying& LiveBook::getUnderlying(std::size_t underlying)
+	{
+		if (underlying >= _underlyings.size())
+		{
+			throw IncorrectInputException("Underlying is not in the book.");
+		}
+
+		return _underlyings[underlying];
+	}
+
+	/// @brief underlying by index
+	/// @param underlying index of the underlying
+	/// @return underlying
+	const LiveBook::Underlying& LiveBook::getUnderlying(std::size_t underlying) const
+	{
+		if (underlying >= _underlyings.size())
+		{
+			throw IncorrectInputException("Underlying is not in the book.");
+		}
+
+		return _underlyings[underlying];
+	}
+
+	/// @brief add an underlying
+	/// @param S underlying price
+	/// @return index of the underlying
+	std::size_t LiveBook::addUnderlying(double S)
+	{
+		if (!(S > 0.0))
+		{
+			throw IncorrectInputException("Underlying price must be positive.");
+		}
+		_underlyings.emplace_back();
+		_underlyings.back().S = S;
+
+		return _underlyings.size() - 1;
+	}
+
+	/// @brief add a European contract and price it at the current underlying price
+	/// @param underlying index of the underlying
+	/// @param K strike price
+	/// @param T maturity
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param type call or put
+	/// @return index of the contract in the book
+	std::size_t LiveBook::addContract(std::size_t underlying, double K, double T, double sigma, double r, double b,
+									  Payoff::Type type)
+	{
+		Underlying& u = getUnderlying(underlying);
+		if (!(K > 0.0 && T > 0.0 && sigma > 0.0))
+		{
+			throw IncorrectInputException("Strike, maturity and volatility must be positive.");
+		}
+
+		u.logStrike.push_back(std::log(K));
+		u.drift.push_back((b + sigma * sigma / 2) * T);
+		u.sigmaSqrtT.push_back(sigma * std::sqrt(T));
+		u.inverseSigmaSqrtT.push_back(1 / u.sigmaSqrtT.back());
+		u.carry.push_back(std::exp((b - r) * T));
+		u.discountedStrike.push_back(K * std::exp(-r * T));
+		u.put.push_back((type == Payoff::Type::Put) ? 1.0 : 0.0);
+		u.price.push_back(0.0);
+		reprice(u, u.price.size() - 1, u.price.size());
+
+		_contracts.emplace_back(underlying, u.price.size() - 1);
+		return _contracts.size() - 1;
+	}
+
+	/// @brief reprice contracts of an underlying from the stored terms, in blocks
+	/// that keep d1, d2 and their normal distribution values in the L1 cache.
+	/// Both loops around the vectorized cdf are free of branches, so the
+	/// compiler vectorizes them too
+	/// @tparam Real type of d1, d2 and their normal distribution values
+	/// @param u underlying
+	/// @param begin first contract
+	/// @param end one past the last contract
+	template <typename Real>
+	void LiveBook::reprice(Underlying& u, std::size_t begin, std::size_t end)
+	{
+		constexpr std::size_t block_size{256};
+		Real d[2 * block_size];
+		Real N_d[2 * block_size];
+
+		const double S{u.S};
+		const double logS{std::log(S)};
+		const double* logStrike{u.logStrike.data()};
+		const double* drift{u.drift.data()};
+		const double* sigmaSqrtT{u.sigmaSqrtT.data()};
+		const double* inverseSigmaSqrtT{u.inverseSigmaSqrtT.data()};
+		const double* carry{u.carry.data()};
+		const double* discountedStrike{u.discountedStrike.data()};
+		const double* put{u.put.data()};
+		double* price{u.price.data()};
+		for (std::size_t start = begin; start < end; start += block_size)
+		{
+			const std::size_t m{std::min(block_size, end - start)};
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const double d1 = (logS - logStrike[i] + drift[i]) * inverseSigmaSqrtT[i];
+				d[j] = static_cast<Real>(d1);
+				d[m + j] = static_cast<Real>(d1 - sigmaSqrtT[i]);
+			}
+			StandardNormal::cdf(std::span<const Real>(d, 2 * m), std::span<Real>(N_d, 2 * m));
+			for (std::size_t j = 0; j < m; j++)
+			{
+				const std::size_t i{start + j};
+				const double call = S * carry[i] * N_d[j] - discountedStrike[i] * N_d[m + j];
+				price[i] = (put[i] != 0.0) ? BlackScholesKernels::getPutFromCall(call, S, discountedStrike[i]) : call;
+			}
+		}
+	}
+
+	/// @brief reprice contracts of an underlying in the precision of the book
+	/// @param u underlying
+	/// @param begin first contract
+	/// @param end one past the last contract
+	void LiveBook::reprice(Underlying& u, std::size_t begin, std::size_t end) const
+	{
+		if (_precision == Single)
+		{
+			reprice<float>(u, begin, end);
+		}
+		else
+		{
+			reprice<double>(u, begin, end);
+		}
+	}
+
+	/// @brief reprice all contracts of an underlying. An underlying with enough
+	/// contracts is split in ranges repriced on the threads of the pool, which
+	/// is started by the first such update and reused by the next ones. The
+	/// prices are the same as on one thread
+	/// @param u underlying
+	void LiveBook::reprice(Underlying& u)
+	{
+		const std::size_t n{u.price.size()};
+		const std::size_t available{(_threads == 0) ? std::max(1u, std::thread::hardware_concurrency()) : _threads};
+		if (available <= 1 || n < 2 * contracts_per_thread)
+		{
+			reprice(u, 0, n);
+			return;
+		}
+
+		if (!_pool)
+		{
+			_pool = std::make_unique<WorkerPool>(available);
+		}
+		_pool->run(n, [this, &u](std::size_t begin, std::size_t end) { reprice(u, begin, end); },
+				   contracts_per_thread);
+	}
+
+	/// @brief reprice all contracts of an underlying at a new price
+	/// @param underlying index of the underlying
+	/// @param S underlying price
+	void LiveBook::updateSpot(std::size_t underlying, double S)
+	{
+		Underlying& u = getUnderlying(underlying);
+		if (!(S > 0.0))
+		{
+			throw IncorrectInputException("Underlying price must be positive.");
+		}
+		u.S = S;
+		reprice(u);
+	}
+
+	/// @brief apply a batch of ticks. Prices are set first and every underlying
+	/// that changed is then repriced once, at its last price in the batch
+	/// @param underlyings indices of the underlyings
+	/// @param S underlying prices
+	void LiveBook::updateSpots(std::span<const std::size_t> underlyings, std::span<const double> S)
+	{
+		if (underlyings.size() != S.size())
+		{
+			throw IncorrectInputException("Each tick needs an underlying and a price.");
+		}
+		for (std::size_t i = 0; i < S.size(); i++)
+		{
+			getUnderlying(underlyings[i]);
+			if (!(S[i] > 0.0))
+			{
+				throw IncorrectInputException("Underlying price must be positive.");
+			}
+		}
+
+		_batch++;
+		for (std::size_t i = 0; i < S.size(); i++)
+		{
+			Underlying& u = _underlyings[underlyings[i]];
+			u.S = S[i];
+			u.batch = _batch;
+		}
+		for (std::size_t i = 0; i < S.size(); i++)
+		{
+			Underlying& u = _underlyings[underlyings[i]];
+			if (u.batch == _batch)
+			{
+				reprice(u);
+				// Repriced, later ticks of the batch for it are skipped
+				u.batch = 0;
+			}
+		}
+	}
+
+	/// @brief number of underlyings
+	/// @return count
+	std::size_t LiveBook::getUnderlyingCount() const
+	{
+		return _underlyings.size();
+	}
+
+	/// @brief number of contracts
+	/// @return count
+	std::size_t LiveBook::getContractCount() const
+	{
+		return _contracts.size();
+	}
+
+	/// @brief precision of the normal distribution
+	/// @return Double or Single
+	LiveBook::Precision LiveBook::getPrecision() const
+	{
+		return _precision;
+	}
+
+	/// @brief current underlying price
+	/// @param underlying index of the underlying
+	/// @return price
+	double LiveBook::getSpot(std::size_t underlying) const
+	{
+		return getUnderlying(underlying).S;
+	}
+
+	/// @brief price of a contract
+	/// @param contract index of the contract in the book
+	/// @return price
+	double LiveBook::getPrice(std::size_t contract) const
+	{
+		if (contract >= _contracts.size())
+		{
+			throw IncorrectInputException("Contract is not in the book.");
+		}
+		const auto& [underlying, position] = _contracts[contract];
+
+		return _underlyings[underlying].price[position];
+	}
+
+	/// @brief prices of the contracts of an underlying
+	/// @param underlying index of the underlying
+	/// @return prices in the order the contracts were added
+	std::span<const double> LiveBook::getPrices(std::size_t underlying) const
+	{
+		return getUnderlying(underlying).price;
+	}
+}
@@ -0,0 +1,93 @@
+// Book of European options repriced on spot ticks. Terms of the
+// Black-Scholes price that do not depend on the underlying price, such as
+// 1 / (sigma sqrt(T)), exp(-rT) K and exp((b-r)T), are computed once when a
+// contract is added and stored per underlying as contiguous columns, so a
+// spot update only evaluates log(S), d1, d2 and the normal distribution, in
+// branch-free loops, and splits large underlyings over the threads of a
+// WorkerPool started with the first such update and kept by the book. A book
+// in single precision evaluates the normal distribution on floats.
+
+#ifndef LIVEBOOK_HPP
+#define LIVEBOOK_HPP
+
+#include "Payoff.hpp"
+#include "IncorrectInputException.hpp"
+#include "WorkerPool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class LiveBook
+	{
+	public:
+		// Precision of the normal distribution, the other terms are in double
+		enum Precision { Double, Single };
+
+	private:
+		// Contracts of one underlying as columns of spot independent terms
+		struct Underlying
+		{
+			double S{};                          // current underlying price
+			std::vector<double> logStrike;       // log(K)
+			std::vector<double> drift;           // (b + sigma^2 / 2) T
+			std::vector<double> sigmaSqrtT;      // sigma sqrt(T)
+			std::vector<double> inverseSigmaSqrtT; // 1 / (sigma sqrt(T))
+			std::vector<double> carry;           // exp((b - r) T)
+			std::vector<double> discountedStrike; // K exp(-rT)
+			std::vector<double> put;             // 1 for a put, 0 for a call
+			std::vector<double> price;           // prices at the current underlying price
+			std::size_t batch{};                 // last batch of ticks that changed S
+		};
+
+		std::vector<Underlying> _underlyings;
+		std::size_t _batch; // number of tick batches applied
+		std::size_t _threads; // number of threads repricing one underlying, 0 uses all hardware threads
+		Precision _precision; // precision of the normal distribution
+		// Underlying and position within it of each contract
+		std::vector<std::pair<std::size_t, std::size_t>> _contracts;
+		std::unique_ptr<WorkerPool> _pool; // threads of large underlyings, started when first needed
+
+		// Reprice contracts [begin, end) of an underlying with the cdf in Real
+		template <typename Real>
+		static void reprice(Underlying& underlying, std::size_t begin, std::size_t end);
+		// Reprice contracts [begin, end) of an underlying in the precision of the book
+		void reprice(Underlying& underlying, std::size_t begin, std::size_t end) const;
+		// Reprice all contracts of an underlying, on several threads if it has many
+		void reprice(Underlying& underlying);
+		// Underlying by index, throws if it does not exist
+		Underlying& getUnderlying(std::size_t underlying);
+		const Underlying& getUnderlying(std::size_t underlying) const;
+
+	public:
+		explicit LiveBook(std::size_t threads=1, Precision precision=Double); // default constructor
+		LiveBook(const LiveBook& source); // copy constructor
+		LiveBook& operator= (const LiveBook& source); // copy assignment
+		~LiveBook(); // destructor
+
+		// Add an underlying, returns its index
+		std::size_t addUnderlying(double S);
+		// Add a European contract on an underlying, returns its index in the book
+		std::size_t addContract(std::size_t underlying, double K, double T, double sigma, double r, double b,
+								Payoff::Type type);
+
+		// Reprice all contracts of an underlying at a new price
+		void updateSpot(std::size_t underlying, double S);
+		// Apply a batch of ticks, the last tick of an underlying wins
+		void updateSpots(std::span<const std::size_t> underlyings, std::span<const double> S);
+
+		std::size_t getUnderlyingCount() const; // number of underlyings
+		std::size_t getContractCount() const; // number of contracts
+		Precision getPrecision() const; // precision of the normal distribution
+		double getSpot(std::size_t underlying) const; // current underlying price
+		double getPrice(std::size_t contract) const; // price of a contract
+		// Prices of the contracts of an underlying in the order they were added
+		std::span<const double> getPrices(std::size_t underlying) const;
+	};
+}
+
+#endif
@@ -1,10 +1,9 @@
 // Program to compute exact Vanilla option price, greeks 
 // and price of perpetual American options
 //
-// Compiled from terminal: 
-// clang++ -std=c++20 -Wall -Wpedantic -Weffc++ Main.cpp AnalyticEuropeanEngine.cpp 
-// Option.cpp Payoff.cpp PricingEngine.cpp VanillaOption.cpp Helper_functions.cpp 
-// NumericalEuropeanEngine.cpp ExoticOption.cpp AnalyticAmericanPerpetualEngine.cpp -o Main
+// Built from the repository root together with the benchmark:
+// cmake -S . -B build && cmake --build build
+// which produces the executables build/Main and build/bench
 
 #include "Payoff.hpp"
 #include "VanillaOption.hpp"
@@ -16,6 +15,7 @@
 
 #include "Helper_functions.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <vector>
@@ -371,21 +371,20 @@ int main()
 	// Create option price matrix
 	option_chain.clear();
 
+	// One engine prices the whole ladder: sigma, r and b are fixed, so the
+	// exponents of the perpetual value are computed once
+	std::vector<double> perpetual_strikes(underlying_price_vector.size(), K);
+	std::vector<double> perpetual_prices(underlying_price_vector.size());
+	AnalyticAmericanPerpetualEngine perpetual_ladder_engine{S, sig, r, b};
+
 	// American perpetual call option price
-	type = Payoff::Call;
-	for (auto& price : underlying_price_vector)
+	std::vector<Payoff::Type> perpetual_types(underlying_price_vector.size(), Payoff::Call);
+	perpetual_ladder_engine.getBatchPrices(underlying_price_vector, perpetual_strikes, perpetual_types, perpetual_prices);
+	for (std::size_t i = 0; i < underlying_price_vector.size(); i++)
 	{
-		auto analytic_perpetual_engine{std::make_shared<AnalyticAmericanPerpetualEngine>(price, 
-																	  sig, 
-																	  r, 
-																	  b)};
-		auto payoff_perpetual_call{std::make_shared<Payoff>(std::numeric_limits<double>::quiet_NaN(), 
-								   K, type, exercise)};
-		ExoticOption perpetual_call_option{payoff_perpetual_call, analytic_perpetual_engine};
-		double option_price = perpetual_call_option.getPrice();
 		// Append price to the option_chain matrix with parameters
-		option_chain.push_back({price, K, std::numeric_limits<double>::quiet_NaN(), 
-								sig, r, option_price});
+		option_chain.push_back({underlying_price_vector[i], K, std::numeric_limits<double>::quiet_NaN(), 
+								sig, r, perpetual_prices[i]});
 	}
 	
 	// Print call option delta
@@ -394,20 +393,13 @@ int main()
 	option_chain.clear();
 
 	// American perpetual put option price
-	type = Payoff::Put;
-	for (auto& price : underlying_price_vector)
+	std::fill(perpetual_types.begin(), perpetual_types.end(), Payoff::Put);
+	perpetual_ladder_engine.getBatchPrices(underlying_price_vector, perpetual_strikes, perpetual_types, perpetual_prices);
+	for (std::size_t i = 0; i < underlying_price_vector.size(); i++)
 	{
-		auto analytic_perpetual_engine{std::make_shared<AnalyticAmericanPerpetualEngine>(price, 
-																	  					 sig, 
-																	  					 r, 
-																	  					 b)};
-		auto payoff_perpetual_put{std::make_shared<Payoff>(std::numeric_limits<double>::quiet_NaN(), 
-								   K, type, exercise)};
-		ExoticOption perpetual_put_option{payoff_perpetual_put, analytic_perpetual_engine};
-		double option_price = perpetual_put_option.getPrice();
 		// Append price to the option_chain matrix with parameters
-		option_chain.push_back({price, K, std::numeric_limits<double>::quiet_NaN(), 
-								sig, r, option_price});
+		option_chain.push_back({underlying_price_vector[i], K, std::numeric_limits<double>::quiet_NaN(), 
+								sig, r, perpetual_prices[i]});
 	}
 	// Print american perpetual put option price
 	std::cout << "\nAmerican perpetual put price for underlying price from 10 to 50\n";
@@ -0,0 +1,168 @@
+// Implementation of the header file MarketInputs.hpp
+
+#include "MarketInputs.hpp"
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	MarketInputs::MarketInputs(double sigma, double r, double b)
+	: _sigma{sigma}, _r{r}, _b{b}, _surface{}, _rates{}, _dividends{} {}
+
+	/// @brief Construct on a volatility surface, the volatility of each option
+	/// is read from the surface at its strike and maturity
+	/// @param surface volatility surface
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	MarketInputs::MarketInputs(const std::shared_ptr<const VolSurface>& surface, double r, double b)
+	: _sigma{}, _r{r}, _b{b}, _surface{surface}, _rates{}, _dividends{}
+	{
+		if (!surface)
+		{
+			throw IncorrectInputException("Volatility surface is missing.");
+		}
+	}
+
+	/// @brief Construct on yield curves, the rate and cost of carry of each
+	/// option are read from the curves at its maturity, b = r - q
+	/// @param sigma volatility
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	MarketInputs::MarketInputs(double sigma, const std::shared_ptr<const YieldCurve>& rates,
+							   const std::shared_ptr<const YieldCurve>& dividends)
+	: _sigma{sigma}, _r{}, _b{}, _surface{}, _rates{rates}, _dividends{dividends}
+	{
+		if (!rates)
+		{
+			throw IncorrectInputException("Rate curve is missing.");
+		}
+	}
+
+	/// @brief Construct on a volatility surface and yield curves
+	/// @param surface volatility surface
+	/// @param rates risk-free rate curve
+	/// @param dividends dividend yield curve, zero yield if nullptr
+	MarketInputs::MarketInputs(const std::shared_ptr<const VolSurface>& surface,
+							   const std::shared_ptr<const YieldCurve>& rates,
+							   const std::shared_ptr<const YieldCurve>& dividends)
+	: _sigma{}, _r{}, _b{}, _surface{surface}, _rates{rates}, _dividends{dividends}
+	{
+		if (!surface)
+		{
+			throw IncorrectInputException("Volatility surface is missing.");
+		}
+		if (!rates)
+		{
+			throw IncorrectInputException("Rate curve is missing.");
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source MarketInputs object
+	MarketInputs::MarketInputs(const MarketInputs& source)
+	: _sigma{source._sigma}, _r{source._r}, _b{source._b}, _surface{source._surface},
+	  _rates{source._rates}, _dividends{source._dividends}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source MarketInputs object
+	/// @return MarketInputs object
+	MarketInputs& MarketInputs::operator= (const MarketInputs& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_sigma = source._sigma;
+		_r = source._r;
+		_b = source._b;
+		_surface = source._surface;
+		_rates = source._rates;
+		_dividends = source._dividends;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	MarketInputs::~MarketInputs() {}
+
+	/// @brief market data of an option: the rate and carry of the curves at
+	/// its maturity, then the volatility of the surface at its strike and
+	/// maturity, each in place of the scalar if given
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @return S, sigma, r and b of the option
+	MarketQuote MarketInputs::resolve(double S, double K, double T) const
+	{
+		return resolve(MarketQuote{S, _sigma, _r, _b}, K, T);
+	}
+
+	/// @brief market data of an option, the scalars of the quote are used
+	/// where the inputs have no surface or curves
+	/// @param quote underlying price, volatility, rate and carry
+	/// @param K strike price
+	/// @param T maturity
+	/// @return S, sigma, r and b of the option
+	MarketQuote MarketInputs::resolve(const MarketQuote& quote, double K, double T) const
+	{
+		MarketQuote result{quote};
+		if (_rates)
+		{
+			result.r = _rates->getZeroRate(T);
+			result.b = result.r - (_dividends ? _dividends->getZeroRate(T) : 0.0);
+		}
+		if (_surface)
+		{
+			result.sigma = _surface->getVolatility(result.S, K, T, result.b);
+		}
+
+		return result;
+	}
+
+	/// @brief get scalar volatility
+	/// @return volatility
+	double MarketInputs::getVolatility() const
+	{
+		return _sigma;
+	}
+
+	/// @brief get scalar risk-free rate
+	/// @return rate
+	double MarketInputs::getRate() const
+	{
+		return _r;
+	}
+
+	/// @brief get scalar cost of carry
+	/// @return cost of carry
+	double MarketInputs::getCarry() const
+	{
+		return _b;
+	}
+
+	/// @brief get volatility surface
+	/// @return surface, nullptr for a scalar volatility
+	const std::shared_ptr<const VolSurface>& MarketInputs::getSurface() const
+	{
+		return _surface;
+	}
+
+	/// @brief get rate curve
+	/// @return curve, nullptr for scalar rate and carry
+	const std::shared_ptr<const YieldCurve>& MarketInputs::getRates() const
+	{
+		return _rates;
+	}
+
+	/// @brief get dividend yield curve
+	/// @return curve, nullptr for a zero yield or scalar rate and carry
+	const std::shared_ptr<const YieldCurve>& MarketInputs::getDividends() const
+	{
+		return _dividends;
+	}
+}
@@ -0,0 +1,58 @@
+// Volatility, risk-free rate and cost of carry of an engine. Each is a
+// scalar, or the volatility is read from a VolSurface at the strike and
+// maturity of an option and the rate and carry from a rate and a dividend
+// yield YieldCurve at its maturity, b = r - q. AnalyticEuropeanEngine,
+// BaroneAdesiWhaleyEngine and BjerksundStenslandEngine hold one, build their
+// constructors on it and get the market data of each option from resolve.
+
+#ifndef MARKETINPUTS_HPP
+#define MARKETINPUTS_HPP
+
+#include "VolSurface.hpp"
+#include "YieldCurve.hpp"
+#include "MarketQuote.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <memory>
+
+namespace PricingLibrary {
+
+	class MarketInputs
+	{
+	private:
+		double _sigma;   // volatility
+		double _r;       // risk-free rate
+		double _b;       // cost of carry
+		std::shared_ptr<const VolSurface> _surface;   // volatility of each option, if any
+		std::shared_ptr<const YieldCurve> _rates;     // rate of each option, if any
+		std::shared_ptr<const YieldCurve> _dividends; // dividend yield of each option, zero if missing
+
+	public:
+		MarketInputs(double sigma, double r, double b); // default constructor
+		// volatility surface in place of the volatility
+		MarketInputs(const std::shared_ptr<const VolSurface>& surface, double r, double b);
+		// rate and dividend yield curves in place of r and b
+		MarketInputs(double sigma, const std::shared_ptr<const YieldCurve>& rates,
+					 const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		MarketInputs(const std::shared_ptr<const VolSurface>& surface,
+					 const std::shared_ptr<const YieldCurve>& rates,
+					 const std::shared_ptr<const YieldCurve>& dividends=nullptr);
+		MarketInputs(const MarketInputs& source); // copy constructor
+		MarketInputs& operator= (const MarketInputs& source); // copy assignment
+		~MarketInputs(); // destructor
+
+		// Market data of an option of strike K and maturity T on an underlying at S
+		MarketQuote resolve(double S, double K, double T) const;
+		// Same, with the scalars of a quote in place of those of the inputs
+		MarketQuote resolve(const MarketQuote& quote, double K, double T) const;
+
+		double getVolatility() const; // scalar volatility
+		double getRate() const; // scalar risk-free rate
+		double getCarry() const; // scalar cost of carry
+		const std::shared_ptr<const VolSurface>& getSurface() const;
+		const std::shared_ptr<const YieldCurve>& getRates() const;
+		const std::shared_ptr<const YieldCurve>& getDividends() const;
+	};
+}
+
+#endif
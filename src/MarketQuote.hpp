@@ -0,0 +1,18 @@
+// Market data of one underlying as a plain value, used by MarketState
+// snapshots and by the value-type pricing kernels
+
+#ifndef MARKETQUOTE_HPP
+#define MARKETQUOTE_HPP
+
+namespace PricingLibrary {
+
+	struct MarketQuote
+	{
+		double S{};      // underlying price
+		double sigma{};  // volatility
+		double r{};      // risk-free rate
+		double b{};      // cost of carry
+	};
+}
+
+#endif
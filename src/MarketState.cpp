@@ -0,0 +1,223 @@
+// Implementation of the header file MarketState.hpp
+
+#include "MarketState.hpp"
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor
+	/// @param capacity maximum number of underlyings
+	MarketState::MarketState(std::size_t capacity)
+	: _capacity{capacity}, _slots{std::make_unique<Slot[]>(capacity)}, _count{0}, _writeMutex{}
+	{}
+
+	/// @brief Copy constructor, copies a snapshot of every quote
+	/// @param source MarketState object
+	MarketState::MarketState(const MarketState& source)
+	: _capacity{source._capacity}, _slots{std::make_unique<Slot[]>(source._capacity)}, _count{0}, _writeMutex{}
+	{
+		std::lock_guard<std::mutex> lock(source._writeMutex);
+		const std::size_t count{source._count.load(std::memory_order_acquire)};
+		for (std::size_t i = 0; i < count; i++)
+		{
+			write(_slots[i], source.getQuote(i));
+		}
+		_count.store(count, std::memory_order_release);
+	}
+
+	/// @brief Copy assignment, copies a snapshot of every quote into the
+	/// existing slots. Each copied quote is a new version of the slot it is
+	/// written to, so engines and caches on this object see the change. The
+	/// capacity is kept, so engines reading on other threads never see a slot
+	/// move; a source with more underlyings than fit throws
+	/// @param source MarketState object
+	/// @return MarketState object
+	MarketState& MarketState::operator= (const MarketState& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		std::scoped_lock lock(_writeMutex, source._writeMutex);
+		const std::size_t count{source._count.load(std::memory_order_acquire)};
+		if (count > _capacity)
+		{
+			throw IncorrectInputException("Market state capacity exceeded.");
+		}
+		for (std::size_t i = 0; i < count; i++)
+		{
+			write(_slots[i], source.getQuote(i));
+		}
+		_count.store(count, std::memory_order_release);
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	MarketState::~MarketState() {}
+
+	/// @brief slot by index
+	/// @param underlying index of the underlying
+	/// @return slot
+	MarketState::Slot& MarketState::getSlot(std::size_t underlying) const
+	{
+		if (underlying >= _count.load(std::memory_order_acquire))
+		{
+			throw IncorrectInputException("Underlying is not in the market state.");
+		}
+
+		return _slots[underlying];
+	}
+
+	/// @brief write a quote. The version is made odd before the fields are
+	/// stored and even again after, readers retry while it is odd or changed
+	/// @param slot slot of the underlying
+	/// @param quote new quote
+	void MarketState::write(Slot& slot, const MarketQuote& quote)
+	{
+		const std::uint64_t version{slot.version.load(std::memory_order_relaxed)};
+		slot.version.store(version + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.S.store(quote.S, std::memory_order_relaxed);
+		slot.sigma.store(quote.sigma, std::memory_order_relaxed);
+		slot.r.store(quote.r, std::memory_order_relaxed);
+		slot.b.store(quote.b, std::memory_order_relaxed);
+
+		slot.version.store(version + 2, std::memory_order_release);
+	}
+
+	/// @brief add an underlying
+	/// @param quote initial quote
+	/// @return index of the underlying
+	std::size_t MarketState::addUnderlying(const MarketQuote& quote)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		const std::size_t count{_count.load(std::memory_order_relaxed)};
+		if (count >= _capacity)
+		{
+			throw IncorrectInputException("Market state capacity exceeded.");
+		}
+
+		// The version continues from the last quote held by the slot, if any
+		write(_slots[count], quote);
+		_count.store(count + 1, std::memory_order_release);
+
+		return count;
+	}
+
+	/// @brief replace the quote of an underlying
+	/// @param underlying index of the underlying
+	/// @param quote new quote
+	void MarketState::setQuote(std::size_t underlying, const MarketQuote& quote)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		write(getSlot(underlying), quote);
+	}
+
+	/// @brief replace the underlying price
+	/// @param underlying index of the underlying
+	/// @param S underlying price
+	void MarketState::setSpot(std::size_t underlying, double S)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		Slot& slot = getSlot(underlying);
+		MarketQuote quote = getQuote(underlying);
+		quote.S = S;
+		write(slot, quote);
+	}
+
+	/// @brief replace the volatility
+	/// @param underlying index of the underlying
+	/// @param sigma volatility
+	void MarketState::setVolatility(std::size_t underlying, double sigma)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		Slot& slot = getSlot(underlying);
+		MarketQuote quote = getQuote(underlying);
+		quote.sigma = sigma;
+		write(slot, quote);
+	}
+
+	/// @brief replace the risk-free rate
+	/// @param underlying index of the underlying
+	/// @param r risk-free rate
+	void MarketState::setRate(std::size_t underlying, double r)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		Slot& slot = getSlot(underlying);
+		MarketQuote quote = getQuote(underlying);
+		quote.r = r;
+		write(slot, quote);
+	}
+
+	/// @brief replace the cost of carry
+	/// @param underlying index of the underlying
+	/// @param b cost-of-carry parameter
+	void MarketState::setCarry(std::size_t underlying, double b)
+	{
+		std::lock_guard<std::mutex> lock(_writeMutex);
+		Slot& slot = getSlot(underlying);
+		MarketQuote quote = getQuote(underlying);
+		quote.b = b;
+		write(slot, quote);
+	}
+
+	/// @brief consistent snapshot of a quote
+	/// @param underlying index of the underlying
+	/// @return quote
+	MarketQuote MarketState::getQuote(std::size_t underlying) const
+	{
+		std::uint64_t version{};
+		return getQuote(underlying, version);
+	}
+
+	/// @brief consistent snapshot of a quote, retried while a write is in progress
+	/// @param underlying index of the underlying
+	/// @param version version of the quote that was read
+	/// @return quote
+	MarketQuote MarketState::getQuote(std::size_t underlying, std::uint64_t& version) const
+	{
+		const Slot& slot = getSlot(underlying);
+		MarketQuote quote;
+		std::uint64_t before{};
+		std::uint64_t after{};
+		do
+		{
+			before = slot.version.load(std::memory_order_acquire);
+			quote.S = slot.S.load(std::memory_order_relaxed);
+			quote.sigma = slot.sigma.load(std::memory_order_relaxed);
+			quote.r = slot.r.load(std::memory_order_relaxed);
+			quote.b = slot.b.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = slot.version.load(std::memory_order_relaxed);
+		} while ((before & 1) != 0 || before != after);
+
+		version = before / 2;
+		return quote;
+	}
+
+	/// @brief version of a quote, increases with every update and never
+	/// returns to an earlier value
+	/// @param underlying index of the underlying
+	/// @return version
+	std::uint64_t MarketState::getVersion(std::size_t underlying) const
+	{
+		return getSlot(underlying).version.load(std::memory_order_acquire) / 2;
+	}
+
+	/// @brief get number of underlyings
+	/// @return number of underlyings
+	std::size_t MarketState::getUnderlyingCount() const
+	{
+		return _count.load(std::memory_order_acquire);
+	}
+
+	/// @brief get maximum number of underlyings
+	/// @return capacity
+	std::size_t MarketState::getCapacity() const
+	{
+		return _capacity;
+	}
+}
@@ -0,0 +1,78 @@
+// Market state shared by pricing engines: underlying price, volatility,
+// risk-free rate and cost of carry of each underlying. Quotes are updated
+// in place and read through a sequence lock, so engines pricing on other
+// threads always see a consistent snapshot of one version of a quote and
+// never block the writer. The number of underlyings is bounded by a
+// capacity fixed at construction so that quotes never move in memory.
+// Assignment copies quotes into the existing slots, so the capacity stays
+// that of construction. Versions only increase over the life of a
+// MarketState, also across assignments and underlyings added again, so a
+// version identifies a quote.
+
+#ifndef MARKETSTATE_HPP
+#define MARKETSTATE_HPP
+
+#include "MarketQuote.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace PricingLibrary {
+
+	class MarketState
+	{
+	private:
+		// Quote of one underlying, the version is odd while a write is in progress
+		struct alignas(64) Slot
+		{
+			std::atomic<std::uint64_t> version{0};
+			std::atomic<double> S{0.0};
+			std::atomic<double> sigma{0.0};
+			std::atomic<double> r{0.0};
+			std::atomic<double> b{0.0};
+		};
+
+		std::size_t _capacity;            // maximum number of underlyings
+		std::unique_ptr<Slot[]> _slots;   // quotes
+		std::atomic<std::size_t> _count;  // number of underlyings added
+		mutable std::mutex _writeMutex;   // serializes writers
+
+		// Slot by index, throws if the underlying does not exist
+		Slot& getSlot(std::size_t underlying) const;
+		// Write a quote, the caller holds the write mutex
+		void write(Slot& slot, const MarketQuote& quote);
+
+	public:
+		explicit MarketState(std::size_t capacity=1024); // default constructor
+		MarketState(const MarketState& source); // copy constructor
+		MarketState& operator= (const MarketState& source); // copy assignment, keeps the capacity
+		~MarketState(); // destructor
+
+		// Add an underlying, returns its index
+		std::size_t addUnderlying(const MarketQuote& quote);
+
+		// Replace the quote of an underlying
+		void setQuote(std::size_t underlying, const MarketQuote& quote);
+		// Replace one field of the quote of an underlying
+		void setSpot(std::size_t underlying, double S);
+		void setVolatility(std::size_t underlying, double sigma);
+		void setRate(std::size_t underlying, double r);
+		void setCarry(std::size_t underlying, double b);
+
+		// Consistent snapshot of the quote of an underlying
+		MarketQuote getQuote(std::size_t underlying) const;
+		// Snapshot and the version it was read at
+		MarketQuote getQuote(std::size_t underlying, std::uint64_t& version) const;
+		// Version of the quote of an underlying, increases with every update
+		std::uint64_t getVersion(std::size_t underlying) const;
+
+		std::size_t getUnderlyingCount() const; // number of underlyings
+		std::size_t getCapacity() const; // maximum number of underlyings
+	};
+}
+
+#endif
@@ -0,0 +1,298 @@
+// Implementation of the header file MonteCarloEuropeanEngine.hpp
+
+#include "MonteCarloEuropeanEngine.hpp"
+#include "StandardNormal.hpp"
+#include "SweepExecutor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Number of samples per block, blocks are the unit of work and of the reduction
+		constexpr std::size_t block_size = 4096;
+
+		// Philox4x32-10 counter-based generator (Salmon et al., 2011). The output
+		// is a bijection of the 128 bit counter under a 64 bit key
+		std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> counter, std::uint64_t seed)
+		{
+			std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+			std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+			for (int round = 0; round < 10; round++)
+			{
+				const std::uint64_t p0 = std::uint64_t{0xD2511F53} * counter[0];
+				const std::uint64_t p1 = std::uint64_t{0xCD9E8D57} * counter[2];
+				counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0, static_cast<std::uint32_t>(p1),
+						   static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1, static_cast<std::uint32_t>(p0)};
+				k0 += 0x9E3779B9;
+				k1 += 0xBB67AE85;
+			}
+
+			return counter;
+		}
+
+		// Uniform in (0, 1) from 64 random bits
+		double uniform(std::uint32_t hi, std::uint32_t lo)
+		{
+			const std::uint64_t bits = (std::uint64_t{hi} << 32 | lo) >> 11;
+			return (static_cast<double>(bits) + 0.5) * 0x1.0p-53;
+		}
+
+		// Two independent standard normal draws for a counter, by Box-Muller
+		std::array<double, 2> normals(std::uint64_t index, std::uint64_t seed)
+		{
+			const auto bits = philox({static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32), 0, 0}, seed);
+			const double radius = std::sqrt(-2.0 * std::log(uniform(bits[0], bits[1])));
+			const double angle = 2.0 * std::numbers::pi * uniform(bits[2], bits[3]);
+
+			return {radius * std::cos(angle), radius * std::sin(angle)};
+		}
+
+		// Sums over the samples of a block
+		struct BlockSums
+		{
+			double y{};  // payoff
+			double x{};  // control
+			double yy{};
+			double xx{};
+			double xy{};
+		};
+	}
+
+	/// @brief Default constructor
+	/// @param S underlying price
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @param paths number of simulated paths
+	/// @param seed random number generator key
+	/// @param antithetic pair each normal draw with its negative
+	/// @param controlVariate use the analytic call price as control variate
+	/// @param threads number of threads, 0 uses all hardware threads
+	MonteCarloEuropeanEngine::MonteCarloEuropeanEngine(double S, double sigma, double r, double b,
+													   std::size_t paths, std::uint64_t seed,
+													   bool antithetic, bool controlVariate,
+													   std::size_t threads)
+	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _paths{paths}, _seed{seed},
+	  _antithetic{antithetic}, _controlVariate{controlVariate}, _threads{threads}, _terminalPayoff{}
+	{}
+
+	/// @brief Copy constructor
+	/// @param source MonteCarloEuropeanEngine object
+	MonteCarloEuropeanEngine::MonteCarloEuropeanEngine(const MonteCarloEuropeanEngine& source)
+	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b},
+	  _paths{source._paths}, _seed{source._seed}, _antithetic{source._antithetic},
+	  _controlVariate{source._controlVariate}, _threads{source._threads}, _terminalPayoff{source._terminalPayoff}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source MonteCarloEuropeanEngine object
+	/// @return MonteCarloEuropeanEngine object
+	MonteCarloEuropeanEngine& MonteCarloEuropeanEngine::operator= (const MonteCarloEuropeanEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		PricingEngine::operator=(source);
+		_S = source._S;
+		_sigma = source._sigma;
+		_r = source._r;
+		_b = source._b;
+		_paths = source._paths;
+		_seed = source._seed;
+		_antithetic = source._antithetic;
+		_controlVariate = source._controlVariate;
+		_threads = source._threads;
+		_terminalPayoff = source._terminalPayoff;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	MonteCarloEuropeanEngine::~MonteCarloEuropeanEngine() {}
+
+	/// @brief Validate if engine was passed to a correct option
+	/// @param exercise American or European
+	void MonteCarloEuropeanEngine::validate(const Payoff::Exercise& exercise) const
+	{
+		if (exercise != Payoff::European)
+		{
+			throw IncorrectEngineException("Only European Options can be priced by terminal price simulation.");
+		}
+	}
+
+	/// @brief set payoff as a function of the terminal underlying price
+	/// @param terminalPayoff payoff function, empty restores the vanilla payoff
+	void MonteCarloEuropeanEngine::setTerminalPayoff(const TerminalPayoff& terminalPayoff)
+	{
+		_terminalPayoff = terminalPayoff;
+		touch();
+	}
+
+	/// @brief simulate price and standard error. Samples 2i and 2i + 1 use the normal
+	/// draws of Philox counter i, samples are summed per block and the block sums are
+	/// added in block order, so the result does not depend on the number of threads.
+	/// With the control variate the discounted call payoff, whose expectation is the
+	/// Black-Scholes call price, is subtracted with the estimated optimal coefficient.
+	/// The vanilla put is the expectation of max(K - S_T, 0), which differs from the
+	/// put-call parity of AnalyticEuropeanEngine when b is not equal to r
+	/// @param payoff Payoff object
+	/// @return price, standard error and number of samples
+	MonteCarloResult MonteCarloEuropeanEngine::simulate(const std::shared_ptr<Payoff>& payoff) const
+	{
+		validate(payoff->getExercise());
+		// Antithetic pairs count as one sample
+		const std::size_t samples{_antithetic ? (_paths + 1) / 2 : _paths};
+		if (samples < 2)
+		{
+			throw IncorrectInputException("Monte Carlo engine needs at least two samples.");
+		}
+
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const Payoff::Type type{payoff->getType()};
+		const double drift{(_b - _sigma * _sigma / 2) * T};
+		const double diffusion{_sigma * std::sqrt(T)};
+		const TerminalPayoff& custom{_terminalPayoff};
+
+		auto payoffAt = [&](double ST)
+		{
+			if (custom)
+			{
+				return custom(ST);
+			}
+			return (type == Payoff::Type::Call) ? std::max(ST - K, 0.0) : std::max(K - ST, 0.0);
+		};
+
+		const std::size_t blocks{(samples + block_size - 1) / block_size};
+		std::vector<BlockSums> sums(blocks);
+
+		auto task = [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t block = begin; block < end; block++)
+			{
+				BlockSums s{};
+				const std::size_t first{block * block_size};
+				const std::size_t last{std::min(first + block_size, samples)};
+				std::array<double, 2> z{};
+				for (std::size_t i = first; i < last; i++)
+				{
+					// One counter gives the draws of two consecutive samples
+					if ((i - first) % 2 == 0)
+					{
+						z = normals(i / 2, _seed);
+					}
+					const double w{z[(i - first) % 2]};
+
+					double y{};
+					double x{};
+					const double ST = _S * std::exp(drift + diffusion * w);
+					if (_antithetic)
+					{
+						const double ST_mirror = _S * std::exp(drift - diffusion * w);
+						y = (payoffAt(ST) + payoffAt(ST_mirror)) / 2;
+						x = (std::max(ST - K, 0.0) + std::max(ST_mirror - K, 0.0)) / 2;
+					}
+					else
+					{
+						y = payoffAt(ST);
+						x = std::max(ST - K, 0.0);
+					}
+
+					s.y += y;
+					s.x += x;
+					s.yy += y * y;
+					s.xx += x * x;
+					s.xy += x * y;
+				}
+				sums[block] = s;
+			}
+		};
+
+		SweepExecutor executor(_threads, 1);
+		executor.run(blocks, task);
+
+		BlockSums total{};
+		for (const auto& s : sums)
+		{
+			total.y += s.y;
+			total.x += s.x;
+			total.yy += s.yy;
+			total.xx += s.xx;
+			total.xy += s.xy;
+		}
+
+		const double n{static_cast<double>(samples)};
+		const double meanY{total.y / n};
+		const double meanX{total.x / n};
+		const double varY{std::max((total.yy - n * meanY * meanY) / (n - 1), 0.0)};
+		const double varX{std::max((total.xx - n * meanX * meanX) / (n - 1), 0.0)};
+		const double cov{(total.xy - n * meanX * meanY) / (n - 1)};
+
+		double mean{meanY};
+		double variance{varY};
+		if (_controlVariate && varX > 0.0)
+		{
+			// Undiscounted Black-Scholes call price is the expectation of the control
+			const double forward{_S * std::exp(_b * T)};
+			const double d1{(std::log(forward / K) + _sigma * _sigma / 2 * T) / diffusion};
+			const double d2{d1 - diffusion};
+			const double expectedX{forward * StandardNormal::cdf(d1) - K * StandardNormal::cdf(d2)};
+
+			const double beta{cov / varX};
+			mean = meanY - beta * (meanX - expectedX);
+			variance = std::max(varY - 2 * beta * cov + beta * beta * varX, 0.0);
+		}
+
+		const double df{std::exp(-_r * T)};
+		return {df * mean, df * std::sqrt(variance / n), samples};
+	}
+
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double MonteCarloEuropeanEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return simulate(payoff).price;
+	}
+
+	/// @brief return standard error of the option price
+	/// @param payoff Payoff object
+	/// @return standard error
+	double MonteCarloEuropeanEngine::getEngineStandardError(const std::shared_ptr<Payoff>& payoff) const
+	{
+		return simulate(payoff).standardError;
+	}
+
+	/*! \warning Not implemented calculation of Delta greek */
+	double MonteCarloEuropeanEngine::getEngineDelta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Gamma greek */
+	double MonteCarloEuropeanEngine::getEngineGamma(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Vega greek */
+	double MonteCarloEuropeanEngine::getEngineVega(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/*! \warning Not implemented calculation of Theta greek */
+	double MonteCarloEuropeanEngine::getEngineTheta(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+}
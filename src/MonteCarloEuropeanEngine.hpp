@@ -0,0 +1,77 @@
+// Define engine to price european options by Monte Carlo simulation of the
+// terminal underlying price. Paths are simulated in fixed blocks with a
+// counter-based random number generator, so each path depends only on the
+// seed and its index and the result is bit-identical for any thread count.
+
+#ifndef MONTECARLOEUROPEANENGINE_HPP
+#define MONTECARLOEUROPEANENGINE_HPP
+
+#include "PricingEngine.hpp"
+#include "EngineException.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace PricingLibrary {
+
+	// Estimate of the option price with its standard error
+	struct MonteCarloResult
+	{
+		double price{};         // discounted mean payoff
+		double standardError{}; // standard error of the price
+		std::size_t samples{};  // number of independent samples
+	};
+
+	class MonteCarloEuropeanEngine : public PricingEngine
+	{
+	public:
+		// Payoff as a function of the terminal underlying price
+		using TerminalPayoff = std::function<double(double ST)>;
+
+	private:
+		double _S;       // underlying price
+		double _sigma;   // volatility
+		double _r;       // risk-free rate
+		double _b;       // cost of carry
+		std::size_t _paths;    // number of simulated paths
+		std::uint64_t _seed;   // random number generator key
+		bool _antithetic;      // pair each normal draw with its negative
+		bool _controlVariate;  // use the analytic call price as control variate
+		std::size_t _threads;  // number of threads, 0 uses all hardware threads
+		TerminalPayoff _terminalPayoff; // custom payoff, vanilla payoff if empty
+
+	public:
+		MonteCarloEuropeanEngine(double S, double sigma, double r, double b,
+								 std::size_t paths=1 << 18, std::uint64_t seed=0,
+								 bool antithetic=true, bool controlVariate=true,
+								 std::size_t threads=1); // default constructor
+		MonteCarloEuropeanEngine(const MonteCarloEuropeanEngine& source); // copy constructor
+		MonteCarloEuropeanEngine& operator= (const MonteCarloEuropeanEngine& source); // copy assignment
+		~MonteCarloEuropeanEngine(); // destructor
+
+		// Replace the vanilla payoff of the Payoff object by a custom one,
+		// the strike and type of the Payoff object are then ignored
+		void setTerminalPayoff(const TerminalPayoff& terminalPayoff);
+
+		// Simulate price and standard error
+		MonteCarloResult simulate(const std::shared_ptr<Payoff>& payoff) const;
+
+		// Get option price
+		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
+		// Get standard error of the price
+		double getEngineStandardError(const std::shared_ptr<Payoff>& payoff) const;
+		// Below are not implemented
+		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
+
+		// Validate if engine was passed to a correct option
+		void validate(const Payoff::Exercise& exercise) const override;
+	};
+}
+
+#endif
@@ -4,18 +4,80 @@
 
 namespace PricingLibrary {
 
+	namespace
+	{
+		/// @brief Black-Scholes price with cost of carry for any scalar type X
+		/// with arithmetic, exp, log, sqrt and normalCdf, e.g. double, Dual or Adjoint
+		/// @param type call or put
+		/// @param K strike price
+		/// @param S underlying price
+		/// @param sigma volatility
+		/// @param T maturity
+		/// @param r risk-free rate
+		/// @param b cost-of-carry parameter
+		/// @return price
+		template <typename X>
+		X getBlackScholesPrice(Payoff::Type type, double K, const X& S, const X& sigma,
+							   const X& T, const X& r, const X& b)
+		{
+			using std::exp;
+			using std::log;
+			using std::sqrt;
+
+			const X sigma_sqrt_T = sigma * sqrt(T);
+			const X d1 = ( log(S / K) + (b + sigma * sigma / 2) * T ) / sigma_sqrt_T;
+			const X d2 = d1 - sigma_sqrt_T;
+			const X forward = S * exp( (b - r) * T );
+			const X discount = K * exp(-r * T);
+			if (type == Payoff::Type::Call)
+			{
+				return forward * normalCdf(d1) - discount * normalCdf(d2);
+			}
+			return discount * normalCdf(-d2) - forward * normalCdf(-d1);
+		}
+
+		/// @brief price of one option as a generic function of S, sigma, T, r and b
+		/// @param type call or put
+		/// @param K strike price
+		/// @return pricer for AutoDiff
+		auto getPricer(Payoff::Type type, double K)
+		{
+			return [type, K](const auto& S, const auto& sigma, const auto& T, const auto& r, const auto& b)
+			{
+				return getBlackScholesPrice(type, K, S, sigma, T, r, b);
+			};
+		}
+	}
+
 	/// @brief Default constructor
 	/// @param S underlying price
 	/// @param sigma volatility
 	/// @param r risk-free rate
-	/// @param b cost-of-carry parameter 
-	NumericalEuropeanEngine::NumericalEuropeanEngine(double S, double sigma, double r, double b)
-	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _h{0.01} {}
+	/// @param b cost-of-carry parameter
+	/// @param mode forward or adjoint automatic differentiation of the Greeks
+	NumericalEuropeanEngine::NumericalEuropeanEngine(double S, double sigma, double r, double b, DifferentiationMode mode)
+	: _S{S}, _sigma{sigma}, _r{r}, _b{b}, _market{}, _underlying{0}, _mode{mode} {}
+
+	/// @brief Construct on a shared market state, S, sigma, r and b are read
+	/// from the quote of the underlying each time a price or greek is requested
+	/// @param market market state
+	/// @param underlying index of the underlying in the market state
+	/// @param mode forward or adjoint automatic differentiation of the Greeks
+	NumericalEuropeanEngine::NumericalEuropeanEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying,
+													 DifferentiationMode mode)
+	: _S{}, _sigma{}, _r{}, _b{}, _market{market}, _underlying{underlying}, _mode{mode}
+	{
+		if (!market || underlying >= market->getUnderlyingCount())
+		{
+			throw IncorrectInputException("Underlying is not in the market state.");
+		}
+	}
 
 	/// @brief Copy constructor
 	/// @param source AnalyticAmericanPerpetualEngine object
 	NumericalEuropeanEngine::NumericalEuropeanEngine(const NumericalEuropeanEngine& source)
-	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b} 
+	: PricingEngine{source}, _S{source._S}, _sigma{source._sigma}, _r{source._r}, _b{source._b},
+	  _market{source._market}, _underlying{source._underlying}, _mode{source._mode}
 	{}
 
 	/// @brief Copy assignemnt
@@ -34,6 +96,9 @@ namespace PricingLibrary {
 		_sigma = source._sigma;
 		_r = source._r;
 		_b = source._b;
+		_market = source._market;
+		_underlying = source._underlying;
+		_mode = source._mode;
 
 		return *this;
 	}
@@ -41,6 +106,21 @@ namespace PricingLibrary {
 	/// @brief Default destructor
 	NumericalEuropeanEngine::~NumericalEuropeanEngine() {}
 
+	/// @brief engine on a consistent snapshot of the market quote of the underlying
+	/// @return engine with fixed market data
+	NumericalEuropeanEngine NumericalEuropeanEngine::getSnapshot() const
+	{
+		const MarketQuote quote{_market->getQuote(_underlying)};
+		return NumericalEuropeanEngine(quote.S, quote.sigma, quote.r, quote.b, _mode);
+	}
+
+	/// @brief version of the quote of the underlying in the market state
+	/// @return version, 0 without a market state
+	std::uint64_t NumericalEuropeanEngine::getMarketVersion() const
+	{
+		return _market ? _market->getVersion(_underlying) : 0;
+	}
+
 	/// @brief Validate if engine was passed to a correct option
 	/// @param exercise American or European
 	void NumericalEuropeanEngine::validate(const Payoff::Exercise& exercise) const
@@ -51,21 +131,28 @@ namespace PricingLibrary {
 		}
 	}
 
+	/// @brief return option price
+	/// @param payoff Payoff object
+	/// @return price
+	double NumericalEuropeanEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
+	{
+		if (_market)
+		{
+			return getSnapshot().getEnginePrice(payoff);
+		}
+
+		validate(payoff->getExercise());
+
+		return getBlackScholesPrice<double>(payoff->getType(), payoff->getStrike(), _S, _sigma,
+											payoff->getMaturity(), _r, _b);
+	}
+
 	/// @brief return delta greek
 	/// @param payoff Payoff object
 	/// @return delta
 	double NumericalEuropeanEngine::getEngineDelta(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		if (payoff->getType() == Payoff::Type::Call)
-		{
-			return getEngineCallDelta(payoff);
-		}
-		else
-		{
-			return getEnginePutDelta(payoff);
-		}
+		return getEngineAll(payoff, Greeks::Delta).delta;
 	}
 
 	/// @brief return gamma greek
@@ -73,127 +160,110 @@ namespace PricingLibrary {
 	/// @return gamma
 	double NumericalEuropeanEngine::getEngineGamma(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		if (payoff->getType() == Payoff::Type::Call)
-		{
-			return getEngineCallGamma(payoff);
-		}
-		else
-		{
-			return getEnginePutGamma(payoff);
-		}
+		return getEngineAll(payoff, Greeks::Gamma).gamma;
 	}
 
-	/// @brief analytic exact call price
+	/// @brief return Theta greek
 	/// @param payoff Payoff object
-	/// @param S_new underlying price
-	/// @return price
-	double NumericalEuropeanEngine::getAnalyticCallPrice(const std::shared_ptr<Payoff>& payoff, double S_new) const
+	/// @return theta
+	double NumericalEuropeanEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
 	{
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double d1 = ( std::log(S_new / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double d2 = d1 - _sigma * std::sqrt(T);
-		double N_d1 = boost::math::cdf(standard_normal, d1);
-		double N_d2 = boost::math::cdf(standard_normal, d2);
-		double price = S_new * std::exp( (_b - _r) * T ) * N_d1 - K * std::exp(-_r * T) * N_d2;
-
-		return price;
+		return getEngineAll(payoff, Greeks::Theta).theta;
 	}
 
-	/// @brief analytic exact put price
+	/// @brief return Vega greek
 	/// @param payoff Payoff object
-	/// @param S_new underlying price
-	/// @return price
-	double NumericalEuropeanEngine::getAnalyticPutPrice(const std::shared_ptr<Payoff>& payoff, double S_new) const
+	/// @return vega
+	double NumericalEuropeanEngine::getEngineVega(const std::shared_ptr<Payoff>& payoff) const
 	{
-		double K{payoff->getStrike()};
-		double T{payoff->getMaturity()};
-		boost::math::normal_distribution standard_normal(0.0, 1.0);
-		double d1 = ( std::log(S_new / K) + (_b + _sigma * _sigma / 2) * T ) / (_sigma * std::sqrt(T));
-		double d2 = d1 - _sigma * std::sqrt(T);
-		double N_d1 = boost::math::cdf(standard_normal, -d1);
-		double N_d2 = boost::math::cdf(standard_normal, -d2);
-		double price = -S_new * std::exp( (_b - _r) * T ) * N_d1 + K * std::exp(-_r * T) * N_d2;
-
-		return price;
+		return getEngineAll(payoff, Greeks::Vega).vega;
 	}
 
-	/// @brief call delta greek
+	/// @brief return Rho greek
 	/// @param payoff Payoff object
-	/// @return delta
-	double NumericalEuropeanEngine::getEngineCallDelta(const std::shared_ptr<Payoff>& payoff) const
+	/// @return rho
+	double NumericalEuropeanEngine::getEngineRho(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double price_plus_h = getAnalyticCallPrice(payoff, _S + _h);
-		double price_minus_h = getAnalyticCallPrice(payoff, _S - _h);
-		double delta = (price_plus_h - price_minus_h) / (2 * _h);
-
-		return delta;
+		return getEngineAll(payoff, Greeks::Rho).rho;
 	}
 
-	/// @brief call gamma greek
+	/// @brief return price and Greeks selected by mask from one pricing pass
+	/// differentiated automatically; the second-order pass runs only if gamma is
+	/// selected. Conventions follow AnalyticEuropeanEngine: vega per percentage
+	/// point, theta = -dV/dT, and rho moves b with r unless b = 0 (futures options)
 	/// @param payoff Payoff object
-	/// @return gamma
-	double NumericalEuropeanEngine::getEngineCallGamma(const std::shared_ptr<Payoff>& payoff) const
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks NumericalEuropeanEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
 	{
-		validate(payoff->getExercise());
+		if (_market)
+		{
+			return getSnapshot().getEngineAll(payoff, mask);
+		}
 
-		double price = getAnalyticCallPrice(payoff, _S);
-		double price_plus_h = getAnalyticCallPrice(payoff, _S + _h);
-		double price_minus_h = getAnalyticCallPrice(payoff, _S - _h);
-		double gamma = (price_plus_h - 2 * price + price_minus_h) / (_h * _h);
+		validate(payoff->getExercise());
 
-		return gamma;
-	}
+		Greeks result;
+		if (!(mask & (Greeks::Delta | Greeks::Gamma | Greeks::Vega | Greeks::Theta | Greeks::Rho)))
+		{
+			if (mask & Greeks::Price)
+			{
+				result.price = getEnginePrice(payoff);
+			}
+			return result;
+		}
 
-	/// @brief put delta greek
-	/// @param payoff Payoff object
-	/// @return delta
-	double NumericalEuropeanEngine::getEnginePutDelta(const std::shared_ptr<Payoff>& payoff) const
-	{
-		validate(payoff->getExercise());
+		const auto pricer = getPricer(payoff->getType(), payoff->getStrike());
+		const AutoDiff::Market market{_S, _sigma, payoff->getMaturity(), _r, _b};
+		const Sensitivities sensitivities = (mask & Greeks::Gamma) ?
+			AutoDiff::getSensitivities(pricer, market, _mode) : AutoDiff::getGradient(pricer, market, _mode);
 
-		double price_plus_h = getAnalyticPutPrice(payoff, _S + _h);
-		double price_minus_h = getAnalyticPutPrice(payoff, _S - _h);
-		double delta = (price_plus_h - price_minus_h) / (2 * _h);
+		const double* gradient{sensitivities.gradient};
+		if (mask & Greeks::Price)
+		{
+			result.price = sensitivities.value;
+		}
+		if (mask & Greeks::Delta)
+		{
+			result.delta = gradient[Sensitivities::Spot];
+		}
+		if (mask & Greeks::Gamma)
+		{
+			result.gamma = sensitivities.hessian[Sensitivities::Spot][Sensitivities::Spot];
+		}
+		if (mask & Greeks::Vega)
+		{
+			result.vega = gradient[Sensitivities::Volatility] / 100; // divide by 100 to covert from percentage to raw
+		}
+		if (mask & Greeks::Theta)
+		{
+			result.theta = -gradient[Sensitivities::Maturity];
+		}
+		if (mask & Greeks::Rho)
+		{
+			result.rho = (_b == 0.0) ? gradient[Sensitivities::Rate]
+									 : gradient[Sensitivities::Rate] + gradient[Sensitivities::Carry];
+		}
 
-		return delta;
+		return result;
 	}
 
-	/// @brief put gamma greek
+	/// @brief return price with all first and second derivatives in S, sigma,
+	/// T, r and b, from one pricing pass in the engine's differentiation mode.
+	/// Derivatives are raw: per unit of volatility and of maturity
 	/// @param payoff Payoff object
-	/// @return gamma
-	double NumericalEuropeanEngine::getEnginePutGamma(const std::shared_ptr<Payoff>& payoff) const
+	/// @return Sensitivities
+	Sensitivities NumericalEuropeanEngine::getEngineSensitivities(const std::shared_ptr<Payoff>& payoff) const
 	{
-		validate(payoff->getExercise());
-
-		double price = getAnalyticPutPrice(payoff, _S);
-		double price_plus_h = getAnalyticPutPrice(payoff, _S + _h);
-		double price_minus_h = getAnalyticPutPrice(payoff, _S - _h);
-		double gamma = (price_plus_h - 2 * price + price_minus_h) / (_h * _h);
+		if (_market)
+		{
+			return getSnapshot().getEngineSensitivities(payoff);
+		}
 
-		return gamma;
-	}
+		validate(payoff->getExercise());
 
-	/*! \warning Not implemented calculation of option price */
-	double NumericalEuropeanEngine::getEnginePrice(const std::shared_ptr<Payoff>& payoff) const
-	{
-		return -1.0;
-	}
-	
-	/*! \warning Not implemented calculation of Theta greek */
-	double NumericalEuropeanEngine::getEngineTheta(const std::shared_ptr<Payoff>& payoff) const
-	{
-		return -1.0;
-	}
+		const auto pricer = getPricer(payoff->getType(), payoff->getStrike());
 
-	/*! \warning Not implemented calculation of Vega greek */
-	double NumericalEuropeanEngine::getEngineVega(const std::shared_ptr<Payoff>& payoff) const
-	{
-		return -1.0;
+		return AutoDiff::getSensitivities(pricer, AutoDiff::Market{_S, _sigma, payoff->getMaturity(), _r, _b}, _mode);
 	}
-}
\ No newline at end of file
+}
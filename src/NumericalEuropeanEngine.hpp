@@ -1,14 +1,18 @@
-// Define engine to price european vanilla options numerically
+// Define engine to price european vanilla options numerically. The price is
+// the Black-Scholes formula written for a generic scalar type; the Greeks are
+// its exact derivatives by automatic differentiation, in forward or adjoint
+// mode, so one pricing pass gives the price and all first- and second-order
+// sensitivities without bumps
 
 #ifndef NUMERICALEUROPEANENGINE_HPP
 #define NUMERICALEUROPEANENGINE_HPP
 
 #include "PricingEngine.hpp"
+#include "MarketState.hpp"
+#include "AutoDiff.hpp"
 #include "EngineException.hpp"
 #include "IncorrectEngineException.hpp"
-
-#include <cmath>
-#include <boost/math/distributions/normal.hpp>
+#include "IncorrectInputException.hpp"
 
 namespace PricingLibrary {
 
@@ -19,39 +23,41 @@ namespace PricingLibrary {
 		double _sigma;   // volatility
 		double _r;       // risk-free rate
 		double _b;       // cost of carry
-		double _h; // greeks precision parameter
-
-		// Analytic call price
-		double getAnalyticCallPrice(const std::shared_ptr<Payoff>& payoff, double S_new) const;
-		// Analytic put price
-		double getAnalyticPutPrice(const std::shared_ptr<Payoff>& payoff, double S_new) const;
-		// Analytic call delta
-		double getEngineCallDelta(const std::shared_ptr<Payoff>& payoff) const;
-		// Analytic put price
-		double getEnginePutDelta(const std::shared_ptr<Payoff>& payoff) const;
-		// Analytic call gamma
-		double getEngineCallGamma(const std::shared_ptr<Payoff>& payoff) const;
-		// Analytic put gamma
-		double getEnginePutGamma(const std::shared_ptr<Payoff>& payoff) const;
+		std::shared_ptr<const MarketState> _market; // market read at pricing time, if any
+		std::size_t _underlying; // underlying in the market
+		DifferentiationMode _mode; // forward or adjoint automatic differentiation
+
+		// Engine on a snapshot of the market quote
+		NumericalEuropeanEngine getSnapshot() const;
 
 	public:
-		NumericalEuropeanEngine(double S, double sigma, double r, double b); // default constructor
+		NumericalEuropeanEngine(double S, double sigma, double r, double b,
+								DifferentiationMode mode=ForwardMode); // default constructor
+		// construct on the quote of an underlying in a shared market state
+		NumericalEuropeanEngine(const std::shared_ptr<const MarketState>& market, std::size_t underlying,
+								DifferentiationMode mode=ForwardMode);
 		NumericalEuropeanEngine(const NumericalEuropeanEngine& source);	// copy constructor
 		NumericalEuropeanEngine& operator= (const NumericalEuropeanEngine& source); // copy assignment
 		~NumericalEuropeanEngine(); // default destructor
 
 		// Validate if engine was passed to a correct option
 		void validate(const Payoff::Exercise& exercise) const override;
+		// Version of the quote of the underlying, 0 without a market state
+		std::uint64_t getMarketVersion() const override;
 
-		// Price: not implemented
+		// Price
 		double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const override;
 
 		// Calculate Greeks
 		double getEngineDelta(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const override;
-		// Below are not implemented
 		double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const override;
 		double getEngineVega(const std::shared_ptr<Payoff>& payoff) const override;
+		double getEngineRho(const std::shared_ptr<Payoff>& payoff) const override;
+		// Price and Greeks selected by mask from one differentiated pricing pass
+		Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const override;
+		// Price with all first and second derivatives in S, sigma, T, r and b
+		Sensitivities getEngineSensitivities(const std::shared_ptr<Payoff>& payoff) const;
 	};
 }
 
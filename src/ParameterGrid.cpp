@@ -0,0 +1,192 @@
+// Implementation of header file ParameterGrid.hpp
+
+#include "ParameterGrid.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace Helper_functions
+{
+	/// @brief Construct grid over all axes
+	/// @param spot underlying price axis
+	/// @param strike strike price axis
+	/// @param expiry expiry time axis
+	/// @param volatility volatility axis
+	/// @param rate risk-free rate axis
+	/// @param carry cost-of-carry axis, empty if b equals the risk-free rate
+	ParameterGrid::ParameterGrid(const std::vector<double>& spot, const std::vector<double>& strike,
+								 const std::vector<double>& expiry, const std::vector<double>& volatility,
+								 const std::vector<double>& rate, const std::vector<double>& carry)
+	: _spot{spot}, _strike{strike}, _expiry{expiry}, _volatility{volatility}, _rate{rate}, _carry{carry}
+	{}
+
+	/// @brief Construct grid with fixed underlying and strike price
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param expiry expiry time axis
+	/// @param volatility volatility axis
+	/// @param rate risk-free rate axis
+	/// @param b cost-of-carry parameter, -1 if it equals the risk-free rate
+	ParameterGrid::ParameterGrid(double S, double K, const std::vector<double>& expiry,
+								 const std::vector<double>& volatility, const std::vector<double>& rate,
+								 double b)
+	: _spot{S}, _strike{K}, _expiry{expiry}, _volatility{volatility}, _rate{rate}, _carry{}
+	{
+		// If b is -1, then it equals to rate, otherwise it has certain value
+		if (std::abs(b + 1.0) > 0.01)
+		{
+			_carry.push_back(b);
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source ParameterGrid object
+	ParameterGrid::ParameterGrid(const ParameterGrid& source)
+	: _spot{source._spot}, _strike{source._strike}, _expiry{source._expiry},
+	  _volatility{source._volatility}, _rate{source._rate}, _carry{source._carry}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source ParameterGrid object
+	/// @return ParameterGrid object
+	ParameterGrid& ParameterGrid::operator= (const ParameterGrid& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_spot = source._spot;
+		_strike = source._strike;
+		_expiry = source._expiry;
+		_volatility = source._volatility;
+		_rate = source._rate;
+		_carry = source._carry;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	ParameterGrid::~ParameterGrid() {}
+
+	/// @brief number of grid points
+	/// @return size
+	std::size_t ParameterGrid::size() const
+	{
+		return _spot.size() * _strike.size() * _expiry.size() * _volatility.size()
+			 * _rate.size() * (_carry.empty() ? 1 : _carry.size());
+	}
+
+	/// @brief grid point by index
+	/// @param index position, the carry axis changes fastest and the spot axis slowest
+	/// @return point
+	GridPoint ParameterGrid::operator[](std::size_t index) const
+	{
+		const std::size_t nCarry = _carry.empty() ? 1 : _carry.size();
+		const std::size_t iCarry = index % nCarry;
+		index /= nCarry;
+		const std::size_t iRate = index % _rate.size();
+		index /= _rate.size();
+		const std::size_t iVolatility = index % _volatility.size();
+		index /= _volatility.size();
+		const std::size_t iExpiry = index % _expiry.size();
+		index /= _expiry.size();
+		const std::size_t iStrike = index % _strike.size();
+		index /= _strike.size();
+
+		const double r = _rate[iRate];
+		return {_spot[index], _strike[iStrike], _expiry[iExpiry], _volatility[iVolatility],
+				r, _carry.empty() ? r : _carry[iCarry]};
+	}
+
+	/// @brief iterator to the first point
+	/// @return iterator
+	ParameterGrid::const_iterator ParameterGrid::begin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	/// @brief iterator past the last point
+	/// @return iterator
+	ParameterGrid::const_iterator ParameterGrid::end() const
+	{
+		return const_iterator(this, size());
+	}
+
+	/// @brief write points [begin, end) into columns. Axis positions are decoded
+	/// once and then advanced like an odometer
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @param S underlying price column
+	/// @param K strike price column
+	/// @param T expiry time column
+	/// @param sigma volatility column
+	/// @param r risk-free rate column
+	/// @param b cost-of-carry column
+	void ParameterGrid::fill(std::size_t begin, std::size_t end,
+							 std::span<double> S, std::span<double> K, std::span<double> T,
+							 std::span<double> sigma, std::span<double> r, std::span<double> b) const
+	{
+		if (end < begin || end > size())
+		{
+			throw PricingLibrary::IncorrectInputException("Grid range is out of bounds.");
+		}
+		const std::size_t n = end - begin;
+		if (S.size() != n || K.size() != n || T.size() != n || sigma.size() != n || r.size() != n || b.size() != n)
+		{
+			throw PricingLibrary::IncorrectInputException("Grid columns must have the length of the range.");
+		}
+		if (n == 0)
+		{
+			return;
+		}
+
+		// Axes from the fastest to the slowest changing one
+		const std::array<const std::vector<double>*, 6> axes{&_carry, &_rate, &_volatility, &_expiry, &_strike, &_spot};
+		std::array<std::size_t, 6> lengths{};
+		std::array<std::size_t, 6> position{};
+		std::size_t index = begin;
+		for (std::size_t a = 0; a < axes.size(); a++)
+		{
+			lengths[a] = axes[a]->empty() ? 1 : axes[a]->size();
+			position[a] = index % lengths[a];
+			index /= lengths[a];
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			S[i] = _spot[position[5]];
+			K[i] = _strike[position[4]];
+			T[i] = _expiry[position[3]];
+			sigma[i] = _volatility[position[2]];
+			r[i] = _rate[position[1]];
+			b[i] = _carry.empty() ? r[i] : _carry[position[0]];
+
+			for (std::size_t a = 0; a < axes.size() && ++position[a] == lengths[a]; a++)
+			{
+				position[a] = 0;
+			}
+		}
+	}
+
+	/// @brief write points [begin, end) as rows {S, K, T, sigma, r, b}
+	/// @param begin first point
+	/// @param end one past the last point
+	/// @return parameter matrix
+	std::vector<std::vector<double>> ParameterGrid::materialize(std::size_t begin, std::size_t end) const
+	{
+		const std::size_t n = (end > begin && end <= size()) ? end - begin : 0;
+		std::vector<double> S(n), K(n), T(n), sigma(n), r(n), b(n);
+		fill(begin, end, S, K, T, sigma, r, b);
+
+		std::vector<std::vector<double>> res(n);
+		for (std::size_t i = 0; i < n; i++)
+		{
+			res[i] = {S[i], K[i], T[i], sigma[i], r[i], b[i]};
+		}
+
+		return res;
+	}
+}
@@ -0,0 +1,91 @@
+// Lazy Cartesian product of option parameters. Points are generated from
+// the axes on request, by index, iterator or as columns of a range,
+// so the grid takes memory proportional to the sum of the axis lengths
+// and not to their product.
+
+#ifndef PARAMETERGRID_HPP
+#define PARAMETERGRID_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace Helper_functions
+{
+	// One point of the grid, in the order of a parameter matrix row
+	struct GridPoint
+	{
+		double S;      // underlying price
+		double K;      // strike price
+		double T;      // expiry time
+		double sigma;  // volatility
+		double r;      // risk-free rate
+		double b;      // cost of carry
+	};
+
+	class ParameterGrid
+	{
+	private:
+		std::vector<double> _spot;       // underlying price axis
+		std::vector<double> _strike;     // strike price axis
+		std::vector<double> _expiry;     // expiry time axis
+		std::vector<double> _volatility; // volatility axis
+		std::vector<double> _rate;       // risk-free rate axis
+		std::vector<double> _carry;      // cost-of-carry axis, empty if b=r
+
+	public:
+		// Iterator over the grid points
+		class const_iterator
+		{
+		private:
+			const ParameterGrid* _grid;
+			std::size_t _index;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = GridPoint;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = GridPoint;
+
+			const_iterator() : _grid{nullptr}, _index{0} {}
+			const_iterator(const ParameterGrid* grid, std::size_t index) : _grid{grid}, _index{index} {}
+
+			GridPoint operator*() const { return (*_grid)[_index]; }
+			const_iterator& operator++() { ++_index; return *this; }
+			const_iterator operator++(int) { const_iterator tmp{*this}; ++_index; return tmp; }
+			bool operator==(const const_iterator& other) const { return _index == other._index; }
+			bool operator!=(const const_iterator& other) const { return _index != other._index; }
+		};
+
+		// Grid over all axes, empty carry axis means b equals the risk-free rate
+		ParameterGrid(const std::vector<double>& spot, const std::vector<double>& strike,
+					  const std::vector<double>& expiry, const std::vector<double>& volatility,
+					  const std::vector<double>& rate, const std::vector<double>& carry={});
+		// Grid with fixed underlying and strike price, b=-1 means b equals the
+		// risk-free rate, as in create_mesh_matrix
+		ParameterGrid(double S, double K, const std::vector<double>& expiry,
+					  const std::vector<double>& volatility, const std::vector<double>& rate,
+					  double b=-1);
+		ParameterGrid(const ParameterGrid& source); // copy constructor
+		ParameterGrid& operator= (const ParameterGrid& source); // copy assignment
+		~ParameterGrid(); // destructor
+
+		// Number of points
+		std::size_t size() const;
+		// Point by index, the last axis changes fastest
+		GridPoint operator[](std::size_t index) const;
+		const_iterator begin() const;
+		const_iterator end() const;
+
+		// Write points [begin, end) into columns of length end - begin
+		void fill(std::size_t begin, std::size_t end,
+				  std::span<double> S, std::span<double> K, std::span<double> T,
+				  std::span<double> sigma, std::span<double> r, std::span<double> b) const;
+		// Write points [begin, end) as rows of a parameter matrix
+		std::vector<std::vector<double>> materialize(std::size_t begin, std::size_t end) const;
+	};
+}
+
+#endif
@@ -0,0 +1,247 @@
+// Implementation of the header file Portfolio.hpp
+
+#include "Portfolio.hpp"
+#include "SweepExecutor.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Greeks aggregated by getRisk
+		constexpr unsigned risk_mask = Greeks::Price | Greeks::Delta | Greeks::Gamma | Greeks::Vega | Greeks::Theta;
+		// Positions per partition at least, and most partial results kept in memory
+		constexpr std::size_t min_partition_size = 4096;
+		constexpr std::size_t max_partitions = 64;
+		constexpr std::size_t max_partial_entries = std::size_t{1} << 22;
+
+		// sum += weight * greeks
+		void accumulate(Greeks& sum, const Greeks& greeks, double weight)
+		{
+			sum.price += weight * greeks.price;
+			sum.delta += weight * greeks.delta;
+			sum.gamma += weight * greeks.gamma;
+			sum.vega += weight * greeks.vega;
+			sum.theta += weight * greeks.theta;
+		}
+
+		// Price, delta, gamma, vega and theta of one contract. Kernels without
+		// analytic Greeks are differentiated by central differences of their price
+		template <typename Kernel>
+		Greeks getGreeks(const Contract& contract, const MarketQuote& quote)
+		{
+			if constexpr (std::is_same_v<Kernel, AnalyticEuropeanKernel>)
+			{
+				return Kernel::getAll(contract, quote, risk_mask);
+			}
+			else
+			{
+				const double dS = 1e-3 * quote.S;
+				const double dSigma = 1e-4;
+				const double dT = std::min(1e-4, contract.T / 2);
+
+				MarketQuote bumped{quote};
+				Greeks result;
+				result.price = Kernel::getPrice(contract, quote);
+				bumped.S = quote.S + dS;
+				const double up = Kernel::getPrice(contract, bumped);
+				bumped.S = quote.S - dS;
+				const double down = Kernel::getPrice(contract, bumped);
+				result.delta = (up - down) / (2 * dS);
+				result.gamma = (up - 2 * result.price + down) / (dS * dS);
+
+				bumped = quote;
+				bumped.sigma = quote.sigma + dSigma;
+				const double volUp = Kernel::getPrice(contract, bumped);
+				bumped.sigma = quote.sigma - dSigma;
+				const double volDown = Kernel::getPrice(contract, bumped);
+				result.vega = (volUp - volDown) / (2 * dSigma) / 100; // per percentage point, as the analytic vega
+
+				Contract shifted{contract};
+				shifted.T = contract.T + dT;
+				const double later = Kernel::getPrice(shifted, quote);
+				shifted.T = contract.T - dT;
+				const double earlier = Kernel::getPrice(shifted, quote);
+				result.theta = -(later - earlier) / (2 * dT);
+
+				return result;
+			}
+		}
+	}
+
+	/// @brief Default constructor
+	Portfolio::Portfolio() : _arena{}, _positions{&_arena}, _underlyingCount{0} {}
+
+	/// @brief Copy constructor, positions are copied into the arena of the new portfolio
+	/// @param source Portfolio object
+	Portfolio::Portfolio(const Portfolio& source)
+	: _arena{}, _positions{source._positions, &_arena}, _underlyingCount{source._underlyingCount}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source Portfolio object
+	/// @return Portfolio object
+	Portfolio& Portfolio::operator= (const Portfolio& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_positions.assign(source._positions.begin(), source._positions.end());
+		_underlyingCount = source._underlyingCount;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	Portfolio::~Portfolio() {}
+
+	/// @brief reserve storage, adding up to this number of positions allocates
+	/// no more memory. Optional, the buffer replaced by growth is released
+	/// @param positions number of positions
+	void Portfolio::reserve(std::size_t positions)
+	{
+		_positions.reserve(positions);
+	}
+
+	/// @brief add a position
+	/// @param contract contract terms
+	/// @param quantity number of contracts, negative when short
+	/// @param underlying index of the underlying
+	/// @return index of the position
+	std::size_t Portfolio::addPosition(const Contract& contract, double quantity, std::size_t underlying)
+	{
+		_positions.push_back(Position{contract, quantity, underlying});
+		_underlyingCount = std::max(_underlyingCount, underlying + 1);
+
+		return _positions.size() - 1;
+	}
+
+	/// @brief get number of positions
+	/// @return number of positions
+	std::size_t Portfolio::getPositionCount() const
+	{
+		return _positions.size();
+	}
+
+	/// @brief get number of underlyings, the largest underlying index plus one
+	/// @return number of underlyings
+	std::size_t Portfolio::getUnderlyingCount() const
+	{
+		return _underlyingCount;
+	}
+
+	/// @brief position by index
+	/// @param position index of the position
+	/// @return position
+	const Position& Portfolio::getPosition(std::size_t position) const
+	{
+		if (position >= _positions.size())
+		{
+			throw IncorrectInputException("Position is not in the portfolio.");
+		}
+
+		return _positions[position];
+	}
+
+	/// @brief all positions in the order they were added
+	/// @return positions
+	std::span<const Position> Portfolio::getPositions() const
+	{
+		return std::span<const Position>(_positions.data(), _positions.size());
+	}
+
+	/// @brief position-weighted price, delta, gamma, vega and theta per underlying
+	/// and in total. Positions are split in at most 64 partitions of at least 4096
+	/// positions, each partition is summed by one thread and the partial sums are
+	/// added in partition order, so the result is the same for any number of threads
+	/// @param quotes quote of each underlying
+	/// @param threads number of threads, 0 uses all hardware threads
+	/// @param americanKernel kernel of the American positions
+	/// @return aggregated risk
+	PortfolioRisk Portfolio::getRisk(std::span<const MarketQuote> quotes, std::size_t threads,
+									 const PricingKernel& americanKernel) const
+	{
+		if (quotes.size() < _underlyingCount)
+		{
+			throw IncorrectInputException("Every underlying of the portfolio needs a quote.");
+		}
+		std::visit([](const auto& kernel)
+		{
+			if (std::decay_t<decltype(kernel)>::exercise != Payoff::American)
+			{
+				throw IncorrectEngineException("Kernel of American positions must price American options.");
+			}
+		}, americanKernel);
+
+		const std::size_t n{_positions.size()};
+		const std::size_t underlyings{std::max<std::size_t>(_underlyingCount, 1)};
+		std::size_t partitions = std::max<std::size_t>(1, n / min_partition_size);
+		partitions = std::min({partitions, max_partitions, std::max<std::size_t>(1, max_partial_entries / underlyings)});
+		const std::size_t partitionSize = std::max<std::size_t>(1, (n + partitions - 1) / partitions);
+
+		// Partial sums of partition p are in partial[p * underlyings, (p + 1) * underlyings)
+		std::vector<Greeks> partial(partitions * underlyings);
+		SweepExecutor executor(threads, partitionSize);
+		std::visit([&](const auto& kernel)
+		{
+			using American = std::decay_t<decltype(kernel)>;
+			executor.run(n, [&](std::size_t begin, std::size_t end)
+			{
+				Greeks* sums = partial.data() + (begin / partitionSize) * underlyings;
+				for (std::size_t i = begin; i < end; i++)
+				{
+					const Position& position = _positions[i];
+					const MarketQuote& quote = quotes[position.underlying];
+					const Greeks greeks = (position.contract.exercise == Payoff::European)
+										? getGreeks<AnalyticEuropeanKernel>(position.contract, quote)
+										: getGreeks<American>(position.contract, quote);
+					accumulate(sums[position.underlying], greeks, position.quantity);
+				}
+			});
+		}, americanKernel);
+
+		PortfolioRisk risk;
+		risk.underlyings.assign(_underlyingCount, Greeks{});
+		for (std::size_t p = 0; p < partitions; p++)
+		{
+			for (std::size_t u = 0; u < _underlyingCount; u++)
+			{
+				accumulate(risk.underlyings[u], partial[p * underlyings + u], 1.0);
+			}
+		}
+		for (const Greeks& greeks : risk.underlyings)
+		{
+			accumulate(risk.total, greeks, 1.0);
+		}
+
+		return risk;
+	}
+
+	/// @brief risk on a snapshot of the quotes of a market state, each quote is
+	/// read once so all positions on an underlying use the same version of it
+	/// @param market market state, underlying indices of the portfolio refer to it
+	/// @param threads number of threads, 0 uses all hardware threads
+	/// @param americanKernel kernel of the American positions
+	/// @return aggregated risk
+	PortfolioRisk Portfolio::getRisk(const MarketState& market, std::size_t threads,
+									 const PricingKernel& americanKernel) const
+	{
+		if (market.getUnderlyingCount() < _underlyingCount)
+		{
+			throw IncorrectInputException("Every underlying of the portfolio needs a quote.");
+		}
+
+		std::vector<MarketQuote> quotes(_underlyingCount);
+		for (std::size_t u = 0; u < _underlyingCount; u++)
+		{
+			quotes[u] = market.getQuote(u);
+		}
+
+		return getRisk(quotes, threads, americanKernel);
+	}
+}
@@ -0,0 +1,77 @@
+// Portfolio of positions, each a Contract record with a quantity and the
+// index of its underlying. Positions are stored contiguously in a vector
+// whose memory comes from a pool resource owned by the portfolio, so a book
+// of millions of positions is one large allocation rather than two shared
+// objects per option. The pool releases the old buffer when the vector grows,
+// so a book built without reserve holds no more than its current buffer. Risk is the position-weighted price, delta, gamma,
+// vega and theta per underlying and in total, computed with the pricing
+// kernels on several threads. Positions are split in a fixed number of
+// partitions whose partial sums are added in partition order, so the result
+// does not depend on the number of threads.
+
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include "Contract.hpp"
+#include "MarketQuote.hpp"
+#include "MarketState.hpp"
+#include "Greeks.hpp"
+#include "PricingKernels.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace PricingLibrary {
+
+	// Holding of one contract
+	struct Position
+	{
+		Contract contract;      // contract terms
+		double quantity{};      // number of contracts, negative when short
+		std::size_t underlying{}; // index of the underlying
+	};
+
+	// Aggregated risk, rho is not aggregated and left at zero
+	struct PortfolioRisk
+	{
+		Greeks total;                   // sum over all positions
+		std::vector<Greeks> underlyings; // sum over the positions of each underlying
+	};
+
+	class Portfolio
+	{
+	private:
+		std::pmr::unsynchronized_pool_resource _arena; // memory of the positions
+		std::pmr::vector<Position> _positions;       // positions in the order they were added
+		std::size_t _underlyingCount;                // largest underlying index + 1
+
+	public:
+		Portfolio(); // default constructor
+		Portfolio(const Portfolio& source); // copy constructor
+		Portfolio& operator= (const Portfolio& source); // copy assignment
+		~Portfolio(); // destructor
+
+		// Reserve storage for a number of positions
+		void reserve(std::size_t positions);
+		// Add a position, returns its index
+		std::size_t addPosition(const Contract& contract, double quantity, std::size_t underlying);
+
+		std::size_t getPositionCount() const; // number of positions
+		std::size_t getUnderlyingCount() const; // number of underlyings referenced
+		const Position& getPosition(std::size_t position) const; // position by index
+		std::span<const Position> getPositions() const; // all positions
+
+		// Risk with the quote of underlying i in quotes[i], European positions are
+		// priced by AnalyticEuropeanKernel and American ones by the given kernel
+		PortfolioRisk getRisk(std::span<const MarketQuote> quotes, std::size_t threads=1,
+							  const PricingKernel& americanKernel=BaroneAdesiWhaleyKernel{}) const;
+		// Risk on a snapshot of the quotes of a market state
+		PortfolioRisk getRisk(const MarketState& market, std::size_t threads=1,
+							  const PricingKernel& americanKernel=BaroneAdesiWhaleyKernel{}) const;
+	};
+}
+
+#endif
@@ -0,0 +1,193 @@
+// Implementation of the header file PriceCache.hpp
+
+#include "PriceCache.hpp"
+
+#include <bit>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Mix of 64 bits, from the finalizer of splitmix64
+		std::uint64_t mix(std::uint64_t x)
+		{
+			x ^= x >> 30;
+			x *= 0xbf58476d1ce4e5b9ULL;
+			x ^= x >> 27;
+			x *= 0x94d049bb133111ebULL;
+			x ^= x >> 31;
+			return x;
+		}
+
+		// Type and exercise of a contract with the mask of a result in 32 bits
+		std::uint32_t pack(const Payoff& payoff, unsigned mask)
+		{
+			const std::uint32_t type = (payoff.getType() == Payoff::Call) ? 1u : 2u;
+			const std::uint32_t exercise = static_cast<std::uint32_t>(payoff.getExercise());
+			return (type << 16) | (exercise << 8) | (mask & Greeks::All);
+		}
+	}
+
+	/// @brief Default constructor
+	/// @param capacity number of slots, rounded up to a power of two
+	PriceCache::PriceCache(std::size_t capacity)
+	: _capacity{}, _slots{}, _epoch{1}, _counters{}
+	{
+		if (capacity == 0)
+		{
+			throw IncorrectInputException("Price cache needs at least one slot.");
+		}
+		_capacity = std::bit_ceil(capacity);
+		_slots = std::make_unique<Slot[]>(_capacity);
+	}
+
+	/// @brief Destructor
+	PriceCache::~PriceCache() {}
+
+	/// @brief price and Greeks selected by mask. A result of the same engine
+	/// identity, market version and contract that holds all selected values is
+	/// returned from the cache; otherwise the missing values are computed by the
+	/// engine, merged with those already cached and stored, unless the market
+	/// moved while they were computed or another thread is writing the slot.
+	/// Values not selected are left at zero, as by PricingEngine::getEngineAll
+	/// @param engine pricing engine
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks PriceCache::getAll(const PricingEngine& engine, const std::shared_ptr<Payoff>& payoff, unsigned mask)
+	{
+		mask &= Greeks::All;
+		const std::uint64_t id{engine.getId()};
+		const std::uint64_t market{engine.getMarketVersion()};
+		const std::uint64_t epoch{_epoch.load(std::memory_order_acquire)};
+		const double K{payoff->getStrike()};
+		const double T{payoff->getMaturity()};
+		const std::uint32_t contract{pack(*payoff, 0)};
+
+		const std::uint64_t hash = mix(id ^ mix(market ^ mix(std::bit_cast<std::uint64_t>(K) ^
+									   mix(std::bit_cast<std::uint64_t>(T) ^ contract))));
+		const std::size_t index{static_cast<std::size_t>(hash) & (_capacity - 1)};
+		Slot& slot = _slots[index];
+		Counters& counters = _counters[index % counter_count];
+
+		// Read the slot once, a write in progress counts as a miss
+		Greeks cached;
+		unsigned have{0};
+		const std::uint64_t before{slot.version.load(std::memory_order_acquire)};
+		const bool match = slot.engine.load(std::memory_order_relaxed) == id &&
+						   slot.market.load(std::memory_order_relaxed) == market &&
+						   slot.epoch.load(std::memory_order_relaxed) == epoch &&
+						   slot.K.load(std::memory_order_relaxed) == K &&
+						   slot.T.load(std::memory_order_relaxed) == T;
+		const std::uint32_t stored{slot.contract.load(std::memory_order_relaxed)};
+		cached.price = slot.price.load(std::memory_order_relaxed);
+		cached.delta = slot.delta.load(std::memory_order_relaxed);
+		cached.gamma = slot.gamma.load(std::memory_order_relaxed);
+		cached.vega = slot.vega.load(std::memory_order_relaxed);
+		cached.theta = slot.theta.load(std::memory_order_relaxed);
+		cached.rho = slot.rho.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const std::uint64_t after{slot.version.load(std::memory_order_relaxed)};
+		if ((before & 1) == 0 && before == after && match && (stored & ~static_cast<std::uint32_t>(Greeks::All)) == contract)
+		{
+			have = stored & Greeks::All;
+		}
+
+		if ((have & mask) == mask)
+		{
+			counters.hits.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+			const Greeks computed = engine.getEngineAll(payoff, mask & ~have);
+			const unsigned missing{mask & ~have};
+			cached.price = (missing & Greeks::Price) ? computed.price : cached.price;
+			cached.delta = (missing & Greeks::Delta) ? computed.delta : cached.delta;
+			cached.gamma = (missing & Greeks::Gamma) ? computed.gamma : cached.gamma;
+			cached.vega = (missing & Greeks::Vega) ? computed.vega : cached.vega;
+			cached.theta = (missing & Greeks::Theta) ? computed.theta : cached.theta;
+			cached.rho = (missing & Greeks::Rho) ? computed.rho : cached.rho;
+
+			// Store if the market did not move and no other thread writes the slot
+			std::uint64_t version{after};
+			if ((version & 1) == 0 && engine.getMarketVersion() == market &&
+				slot.version.compare_exchange_strong(version, version + 1, std::memory_order_relaxed))
+			{
+				std::atomic_thread_fence(std::memory_order_release);
+				slot.engine.store(id, std::memory_order_relaxed);
+				slot.market.store(market, std::memory_order_relaxed);
+				slot.epoch.store(epoch, std::memory_order_relaxed);
+				slot.K.store(K, std::memory_order_relaxed);
+				slot.T.store(T, std::memory_order_relaxed);
+				slot.contract.store(pack(*payoff, have | mask), std::memory_order_relaxed);
+				slot.price.store(cached.price, std::memory_order_relaxed);
+				slot.delta.store(cached.delta, std::memory_order_relaxed);
+				slot.gamma.store(cached.gamma, std::memory_order_relaxed);
+				slot.vega.store(cached.vega, std::memory_order_relaxed);
+				slot.theta.store(cached.theta, std::memory_order_relaxed);
+				slot.rho.store(cached.rho, std::memory_order_relaxed);
+				slot.version.store(version + 2, std::memory_order_release);
+			}
+		}
+
+		Greeks result;
+		result.price = (mask & Greeks::Price) ? cached.price : 0.0;
+		result.delta = (mask & Greeks::Delta) ? cached.delta : 0.0;
+		result.gamma = (mask & Greeks::Gamma) ? cached.gamma : 0.0;
+		result.vega = (mask & Greeks::Vega) ? cached.vega : 0.0;
+		result.theta = (mask & Greeks::Theta) ? cached.theta : 0.0;
+		result.rho = (mask & Greeks::Rho) ? cached.rho : 0.0;
+
+		return result;
+	}
+
+	/// @brief drop all results in O(1): results carry the epoch they were
+	/// written in and the epoch moves on
+	void PriceCache::invalidate()
+	{
+		_epoch.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	/// @brief lookups answered from the cache
+	/// @return hits
+	std::uint64_t PriceCache::getHits() const
+	{
+		std::uint64_t hits{0};
+		for (const Counters& counters : _counters)
+		{
+			hits += counters.hits.load(std::memory_order_relaxed);
+		}
+		return hits;
+	}
+
+	/// @brief lookups that called the engine
+	/// @return misses
+	std::uint64_t PriceCache::getMisses() const
+	{
+		std::uint64_t misses{0};
+		for (const Counters& counters : _counters)
+		{
+			misses += counters.misses.load(std::memory_order_relaxed);
+		}
+		return misses;
+	}
+
+	/// @brief set hits and misses to zero
+	void PriceCache::resetCounters()
+	{
+		for (Counters& counters : _counters)
+		{
+			counters.hits.store(0, std::memory_order_relaxed);
+			counters.misses.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	/// @brief number of slots
+	/// @return capacity
+	std::size_t PriceCache::getCapacity() const
+	{
+		return _capacity;
+	}
+}
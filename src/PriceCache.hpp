@@ -0,0 +1,79 @@
+// Memoized prices and Greeks of options, for callers that ask the same
+// contracts again under unchanged market data. The cache is a direct-mapped
+// table: a key made of the engine identity, the version of the market data
+// the engine reads and the contract selects one slot, and a newer result
+// replaces the one in its slot. Each slot is written under a sequence lock
+// like the quotes of a MarketState, so readers on any number of threads never
+// block: a reader that meets a write in progress treats it as a miss, and a
+// writer that finds the slot busy does not store. Results stay valid while the
+// engine identity and market version are unchanged; invalidate() drops all of
+// them in O(1) for changes the engines cannot see.
+
+#ifndef PRICECACHE_HPP
+#define PRICECACHE_HPP
+
+#include "Payoff.hpp"
+#include "Greeks.hpp"
+#include "PricingEngine.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace PricingLibrary {
+
+	class PriceCache
+	{
+	private:
+		// Key and result of one slot, the version is odd while a write is in progress
+		struct alignas(64) Slot
+		{
+			std::atomic<std::uint64_t> version{0};
+			std::atomic<std::uint64_t> engine{0};  // engine identity, 0 if empty
+			std::atomic<std::uint64_t> market{0};  // market version
+			std::atomic<std::uint64_t> epoch{0};   // cache epoch when written
+			std::atomic<double> K{0.0};
+			std::atomic<double> T{0.0};
+			std::atomic<std::uint32_t> contract{0}; // type, exercise and mask of the result
+			std::atomic<double> price{0.0};
+			std::atomic<double> delta{0.0};
+			std::atomic<double> gamma{0.0};
+			std::atomic<double> vega{0.0};
+			std::atomic<double> theta{0.0};
+			std::atomic<double> rho{0.0};
+		};
+
+		// Hit and miss counts, spread over cache lines by slot
+		struct alignas(64) Counters
+		{
+			std::atomic<std::uint64_t> hits{0};
+			std::atomic<std::uint64_t> misses{0};
+		};
+		static constexpr std::size_t counter_count{16};
+
+		std::size_t _capacity;             // number of slots, a power of two
+		std::unique_ptr<Slot[]> _slots;    // results
+		std::atomic<std::uint64_t> _epoch; // results of older epochs are invalid
+		Counters _counters[counter_count]; // hits and misses
+
+	public:
+		explicit PriceCache(std::size_t capacity=4096); // default constructor
+		PriceCache(const PriceCache& source) =delete; // results are shared, not copied
+		PriceCache& operator= (const PriceCache& source) =delete;
+		~PriceCache(); // destructor
+
+		// Price and Greeks selected by mask from the cache, or from the engine
+		Greeks getAll(const PricingEngine& engine, const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All);
+		// Drop all results
+		void invalidate();
+
+		std::uint64_t getHits() const; // lookups answered from the cache
+		std::uint64_t getMisses() const; // lookups that called the engine
+		void resetCounters(); // set hits and misses to zero
+		std::size_t getCapacity() const; // number of slots
+	};
+}
+
+#endif
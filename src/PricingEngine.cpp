@@ -2,7 +2,123 @@
 
 #include "PricingEngine.hpp"
 
+#include <atomic>
+
 namespace PricingLibrary {
+
+	namespace
+	{
+		// First identity not handed out to a thread yet
+		std::atomic<std::uint64_t> next_block{1};
+
+		// New identity. Threads take identities in blocks, so engines built per
+		// call, e.g. snapshots of a market state, do not contend on one counter
+		std::uint64_t next_id()
+		{
+			constexpr std::uint64_t block_size{1024};
+			thread_local std::uint64_t next{0};
+			thread_local std::uint64_t end{0};
+			if (next == end)
+			{
+				next = next_block.fetch_add(block_size, std::memory_order_relaxed);
+				end = next + block_size;
+			}
+			return next++;
+		}
+	}
+
+	/// @brief Default constructor, gives the engine a new identity
+	PricingEngine::PricingEngine()
+	: _id{next_id()} {}
+
+	/// @brief Copy constructor, the copy has its own identity so that it can
+	/// change independently of the source
+	/// @param source PricingEngine object
+	PricingEngine::PricingEngine(const PricingEngine& /*source*/)
+	: _id{next_id()} {}
+
+	/// @brief Copy assignment, the inputs change so the identity does too
+	/// @param source PricingEngine object
+	/// @return PricingEngine object
+	PricingEngine& PricingEngine::operator= (const PricingEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		touch();
+
+		return *this;
+	}
+
 	/// @brief destructor
 	PricingEngine::~PricingEngine() {}
+
+	/// @brief give the engine a new identity, called by engines whose inputs change
+	void PricingEngine::touch()
+	{
+		_id = next_id();
+	}
+
+	/// @brief identity of the engine inputs. Two engines never share an identity,
+	/// and an engine gets a new one when its inputs change, so results cached
+	/// under an identity stay valid as long as the market version does not change
+	/// @return identity
+	std::uint64_t PricingEngine::getId() const
+	{
+		return _id;
+	}
+
+	/// @brief version of the market data read at pricing time. Engines on fixed
+	/// inputs return 0, engines on a MarketState the version of their quote
+	/// @return version
+	std::uint64_t PricingEngine::getMarketVersion() const
+	{
+		return 0;
+	}
+
+	/*! \warning Not implemented calculation of Rho greek */
+	double PricingEngine::getEngineRho(const std::shared_ptr<Payoff>& /*payoff*/) const
+	{
+		return -1.0;
+	}
+
+	/// @brief return price and Greeks selected by mask.
+	/// Calls the separate functions, engines that can share 
+	/// intermediate results override it
+	/// @param payoff Payoff object
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks PricingEngine::getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask) const
+	{
+		Greeks result;
+		if (mask & Greeks::Price)
+		{
+			result.price = getEnginePrice(payoff);
+		}
+		if (mask & Greeks::Delta)
+		{
+			result.delta = getEngineDelta(payoff);
+		}
+		if (mask & Greeks::Gamma)
+		{
+			result.gamma = getEngineGamma(payoff);
+		}
+		if (mask & Greeks::Vega)
+		{
+			result.vega = getEngineVega(payoff);
+		}
+		if (mask & Greeks::Theta)
+		{
+			result.theta = getEngineTheta(payoff);
+		}
+		if (mask & Greeks::Rho)
+		{
+			result.rho = getEngineRho(payoff);
+		}
+
+		return result;
+	}
 }
\ No newline at end of file
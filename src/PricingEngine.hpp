@@ -1,20 +1,38 @@
 // General engine class from which specific pricing engine class are derived:
-// AnalyticEuropeanEngine, NumericalEuropeanEngine, AnalyticAmericanPerpetualEngine
+// AnalyticEuropeanEngine, NumericalEuropeanEngine, AnalyticAmericanPerpetualEngine,
+// MonteCarloEuropeanEngine, FiniteDifferenceEngine, LatticeEngine,
+// BaroneAdesiWhaleyEngine, BjerksundStenslandEngine
 
 #ifndef PRICINGENGINE_HPP
 #define PRICINGENGINE_HPP
 
 #include "Payoff.hpp"
+#include "Greeks.hpp"
+#include <cstdint>
 #include <memory>
 
 namespace PricingLibrary {
 
 	class PricingEngine
 	{
+	private:
+		std::uint64_t _id; // identity of the engine inputs, unique per engine
+
+	protected:
+		// New identity after an input of the engine changed
+		void touch();
+
 	public:
-		PricingEngine() =default; // default constructor
+		PricingEngine(); // default constructor
+		PricingEngine(const PricingEngine& source); // copy constructor
+		PricingEngine& operator= (const PricingEngine& source); // copy assignment
 		virtual ~PricingEngine(); // destructor
 
+		// Identity of the engine inputs, new on construction, copy, assignment and change
+		std::uint64_t getId() const;
+		// Version of the market data read at pricing time, 0 for fixed inputs
+		virtual std::uint64_t getMarketVersion() const;
+
 		// Get option price
 		virtual double getEnginePrice(const std::shared_ptr<Payoff>& payoff) const =0;
 		// Get option Greeks
@@ -22,6 +40,10 @@ namespace PricingLibrary {
 		virtual double getEngineGamma(const std::shared_ptr<Payoff>& payoff) const =0;
 		virtual double getEngineTheta(const std::shared_ptr<Payoff>& payoff) const =0;
 		virtual double getEngineVega(const std::shared_ptr<Payoff>& payoff) const =0;
+		virtual double getEngineRho(const std::shared_ptr<Payoff>& payoff) const;
+		// Get price and Greeks selected by mask in one call, values 
+		// not selected are left at zero
+		virtual Greeks getEngineAll(const std::shared_ptr<Payoff>& payoff, unsigned mask=Greeks::All) const;
 		// Validate if engine was passed to a correct option
 		virtual void validate(const Payoff::Exercise& exercise) const =0;
 	};
@@ -0,0 +1,169 @@
+// Implementation of the header file PricingKernels.hpp
+
+#include "PricingKernels.hpp"
+#include "BaroneAdesiWhaleyEngine.hpp"
+#include "BjerksundStenslandEngine.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace PricingLibrary {
+
+	/// @brief European option price, put from put-call parity, by the
+	/// BlackScholesKernel of the contract type and the carry model of the quote
+	/// @param contract contract
+	/// @param quote market of the underlying
+	/// @return price
+	double AnalyticEuropeanKernel::getPrice(const Contract& contract, const MarketQuote& quote)
+	{
+		return BlackScholesKernels::visit(contract.type, quote.r, quote.b, [&](auto kernel)
+		{
+			return kernel.getPrice(quote.S, contract.K, contract.T, quote.sigma, quote.r, quote.b);
+		});
+	}
+
+	/// @brief price and Greeks selected by mask. log(S/K), sqrt(T), d1, d2,
+	/// discount factors and normal distribution values are computed once and
+	/// shared, by the BlackScholesKernel of the contract type and the carry model
+	/// of the quote
+	/// @param contract contract
+	/// @param quote market of the underlying
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks AnalyticEuropeanKernel::getAll(const Contract& contract, const MarketQuote& quote, unsigned mask)
+	{
+		return BlackScholesKernels::visit(contract.type, quote.r, quote.b, [&](auto kernel)
+		{
+			return kernel.getAll(quote.S, contract.K, contract.T, quote.sigma, quote.r, quote.b, mask);
+		});
+	}
+
+	/// @brief exponents of the perpetual call and put values, computed once per
+	/// sigma, r and b
+	/// @param sigma volatility
+	/// @param r risk-free rate
+	/// @param b cost-of-carry parameter
+	/// @return Exponents
+	AnalyticAmericanPerpetualKernel::Exponents AnalyticAmericanPerpetualKernel::getExponents(double sigma, double r,
+																							  double b)
+	{
+		const double variance = sigma * sigma;
+		const double a = b / variance - 0.5;
+		const double root = std::sqrt(a * a + (2 * r) / variance);
+		// Derivatives of -a and of the root in sigma
+		const double da = 2 * b / (variance * sigma);
+		const double droot = -(a * da + 2 * r / (variance * sigma)) / root;
+
+		return Exponents{-a + root, -a - root, da + droot, da - droot};
+	}
+
+	/// @brief exercise boundary S*, the call is exercised at S >= S* and the put
+	/// at S <= S*
+	/// @param type call or put
+	/// @param K strike price
+	/// @param y exponents
+	/// @return boundary, infinite for a call with y1 <= 1
+	double AnalyticAmericanPerpetualKernel::getBoundary(Payoff::Type type, double K, const Exponents& y)
+	{
+		if (type == Payoff::Type::Call)
+		{
+			return (y.y1 > 1) ? y.y1 * K / (y.y1 - 1) : std::numeric_limits<double>::infinity();
+		}
+		return y.y2 * K / (y.y2 - 1);
+	}
+
+	/// @brief American perpetual option price
+	/// @param contract contract
+	/// @param quote market of the underlying
+	/// @return price
+	double AnalyticAmericanPerpetualKernel::getPrice(const Contract& contract, const MarketQuote& quote)
+	{
+		return getPrice(contract.type, quote.S, contract.K, getExponents(quote.sigma, quote.r, quote.b));
+	}
+
+	/// @brief American perpetual option price from precomputed exponents, one pow
+	/// @param type call or put
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param y exponents
+	/// @return price
+	double AnalyticAmericanPerpetualKernel::getPrice(Payoff::Type type, double S, double K, const Exponents& y)
+	{
+		if (type == Payoff::Type::Call)
+		{
+			if (!(y.y1 > 1))
+			{
+				// Never exercised early, the closed form is kept as it is
+				return K / (y.y1 - 1) * std::pow( ((y.y1 - 1) * S) / (y.y1 * K), y.y1 );
+			}
+			const double boundary = y.y1 * K / (y.y1 - 1);
+			return (S < boundary) ? (boundary - K) * std::pow(S / boundary, y.y1) : S - K;
+		}
+
+		const double boundary = y.y2 * K / (y.y2 - 1);
+		return (S > boundary) ? (K - boundary) * std::pow(S / boundary, y.y2) : K - S;
+	}
+
+	/// @brief American perpetual price and Greeks selected by mask. With V = A S^y
+	/// before the boundary, delta = y V / S, gamma = y (y - 1) V / S^2 and
+	/// dV/dsigma = V ln(S / S*) dy/dsigma; beyond it the option is worth its
+	/// intrinsic value. Theta is zero since the value does not depend on time
+	/// @param type call or put
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param y exponents
+	/// @param mask combination of Greeks::Mask flags, Rho is ignored
+	/// @return Greeks
+	Greeks AnalyticAmericanPerpetualKernel::getAll(Payoff::Type type, double S, double K, const Exponents& y,
+												   unsigned mask)
+	{
+		const bool isCall{type == Payoff::Type::Call};
+		const double exponent{isCall ? y.y1 : y.y2};
+		const double dy_dsigma{isCall ? y.dy1_dsigma : y.dy2_dsigma};
+		const double boundary{getBoundary(type, K, y)};
+		const double price{getPrice(type, S, K, y)};
+		const bool exercised{isCall ? S >= boundary : S <= boundary};
+
+		Greeks result;
+		if (mask & Greeks::Price)
+		{
+			result.price = price;
+		}
+		if (mask & Greeks::Delta)
+		{
+			result.delta = exercised ? (isCall ? 1.0 : -1.0) : exponent * price / S;
+		}
+		if ((mask & Greeks::Gamma) && !exercised)
+		{
+			result.gamma = exponent * (exponent - 1) * price / (S * S);
+		}
+		if ((mask & Greeks::Vega) && !exercised)
+		{
+			// ln((y - 1) S / (y K)) equals ln(S / S*) where the boundary is finite
+			const double logMoneyness = std::log( ((exponent - 1) * S) / (exponent * K) );
+			result.vega = price * logMoneyness * dy_dsigma / 100; // divide by 100 to covert from percentage to raw
+		}
+
+		return result;
+	}
+
+	/// @brief Barone-Adesi and Whaley American option price
+	/// @param contract contract
+	/// @param quote market of the underlying
+	/// @return price
+	double BaroneAdesiWhaleyKernel::getPrice(const Contract& contract, const MarketQuote& quote)
+	{
+		return BaroneAdesiWhaleyEngine::getAmericanPrice(quote.S, contract.K, contract.T, quote.sigma, quote.r,
+														 quote.b, contract.type);
+	}
+
+	/// @brief Bjerksund and Stensland American option price
+	/// @param contract contract
+	/// @param quote market of the underlying
+	/// @return price
+	double BjerksundStenslandKernel::getPrice(const Contract& contract, const MarketQuote& quote)
+	{
+		return BjerksundStenslandEngine::getAmericanPrice(quote.S, contract.K, contract.T, quote.sigma, quote.r,
+														  quote.b, contract.type);
+	}
+}
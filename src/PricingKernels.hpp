@@ -0,0 +1,153 @@
+// Pricing kernels for the value-type option path. A kernel is a stateless
+// engine: it prices a Contract under a MarketQuote through static functions,
+// so a loop over contracts with the kernel known at compile time has no
+// virtual calls, no heap allocation and no reference counting. When the
+// kernel is only known at runtime, PricingKernel holds one of them in a
+// std::variant which is visited once per batch rather than once per contract.
+// The PricingEngine classes of the same name are thin wrappers around them.
+
+#ifndef PRICINGKERNELS_HPP
+#define PRICINGKERNELS_HPP
+
+#include "Contract.hpp"
+#include "MarketQuote.hpp"
+#include "Greeks.hpp"
+#include "BlackScholesKernel.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <span>
+#include <variant>
+
+namespace PricingLibrary {
+
+	// Black-Scholes prices and Greeks of European options, put price from put-call
+	// parity. Picks the BlackScholesKernel of the contract type and carry model
+	struct AnalyticEuropeanKernel
+	{
+		static constexpr Payoff::Exercise exercise{Payoff::European}; // accepted exercise
+		static double getPrice(const Contract& contract, const MarketQuote& quote);
+		static Greeks getAll(const Contract& contract, const MarketQuote& quote, unsigned mask=Greeks::All);
+	};
+
+	// Prices and Greeks of American perpetual options, the maturity is ignored.
+	// The value is |S* - K| (S / S*)^y before the exercise boundary S* is reached
+	// and the intrinsic value beyond it; y and S* depend only on sigma, r and b
+	struct AnalyticAmericanPerpetualKernel
+	{
+		static constexpr Payoff::Exercise exercise{Payoff::American}; // accepted exercise
+
+		// Exponents of the call and put values and their derivatives in sigma
+		struct Exponents
+		{
+			double y1{};       // call exponent, above 1 if the call is exercised early
+			double y2{};       // put exponent, negative
+			double dy1_dsigma{}; // dy1/dsigma
+			double dy2_dsigma{}; // dy2/dsigma
+		};
+
+		static Exponents getExponents(double sigma, double r, double b);
+		// Exercise boundary, infinite for a call that is never exercised early
+		static double getBoundary(Payoff::Type type, double K, const Exponents& y);
+		static double getPrice(const Contract& contract, const MarketQuote& quote);
+		static double getPrice(Payoff::Type type, double S, double K, const Exponents& y);
+		// Price, delta, gamma, vega and theta, rho is not computed
+		static Greeks getAll(Payoff::Type type, double S, double K, const Exponents& y, unsigned mask=Greeks::All);
+	};
+
+	// Barone-Adesi and Whaley prices of American options, shares the critical price cache
+	struct BaroneAdesiWhaleyKernel
+	{
+		static constexpr Payoff::Exercise exercise{Payoff::American}; // accepted exercise
+		static double getPrice(const Contract& contract, const MarketQuote& quote);
+	};
+
+	// Bjerksund and Stensland (1993) prices of American options
+	struct BjerksundStenslandKernel
+	{
+		static constexpr Payoff::Exercise exercise{Payoff::American}; // accepted exercise
+		static double getPrice(const Contract& contract, const MarketQuote& quote);
+	};
+
+	// Kernel chosen at runtime
+	using PricingKernel = std::variant<AnalyticEuropeanKernel, AnalyticAmericanPerpetualKernel,
+									   BaroneAdesiWhaleyKernel, BjerksundStenslandKernel>;
+
+	namespace PricingKernels
+	{
+		/// @brief price contracts on one underlying with a kernel known at compile time
+		/// @param kernel pricing kernel, only its type is used
+		/// @param contracts contracts
+		/// @param quote market of the underlying
+		/// @param price output prices
+		template <typename Kernel>
+		void getBatchPrices(const Kernel& /*kernel*/, std::span<const Contract> contracts, const MarketQuote& quote,
+							std::span<double> price)
+		{
+			if (price.size() != contracts.size())
+			{
+				throw IncorrectInputException("All batch columns must have the same length.");
+			}
+
+			for (std::size_t i = 0; i < contracts.size(); i++)
+			{
+				if (contracts[i].exercise != Kernel::exercise)
+				{
+					throw IncorrectEngineException("Kernel was passed a contract of the wrong exercise type.");
+				}
+				price[i] = Kernel::getPrice(contracts[i], quote);
+			}
+		}
+
+		/// @brief price contracts, each with its own market quote, with a kernel
+		/// known at compile time
+		/// @param kernel pricing kernel, only its type is used
+		/// @param contracts contracts
+		/// @param quotes market of the underlying of each contract
+		/// @param price output prices
+		template <typename Kernel>
+		void getBatchPrices(const Kernel& /*kernel*/, std::span<const Contract> contracts,
+							std::span<const MarketQuote> quotes, std::span<double> price)
+		{
+			if (quotes.size() != contracts.size() || price.size() != contracts.size())
+			{
+				throw IncorrectInputException("All batch columns must have the same length.");
+			}
+
+			for (std::size_t i = 0; i < contracts.size(); i++)
+			{
+				if (contracts[i].exercise != Kernel::exercise)
+				{
+					throw IncorrectEngineException("Kernel was passed a contract of the wrong exercise type.");
+				}
+				price[i] = Kernel::getPrice(contracts[i], quotes[i]);
+			}
+		}
+
+		/// @brief price contracts on one underlying with a kernel chosen at runtime
+		/// @param kernel pricing kernel
+		/// @param contracts contracts
+		/// @param quote market of the underlying
+		/// @param price output prices
+		inline void getBatchPrices(const PricingKernel& kernel, std::span<const Contract> contracts,
+								   const MarketQuote& quote, std::span<double> price)
+		{
+			std::visit([&](const auto& selected) { getBatchPrices(selected, contracts, quote, price); }, kernel);
+		}
+
+		/// @brief price contracts, each with its own market quote, with a kernel
+		/// chosen at runtime
+		/// @param kernel pricing kernel
+		/// @param contracts contracts
+		/// @param quotes market of the underlying of each contract
+		/// @param price output prices
+		inline void getBatchPrices(const PricingKernel& kernel, std::span<const Contract> contracts,
+								   std::span<const MarketQuote> quotes, std::span<double> price)
+		{
+			std::visit([&](const auto& selected) { getBatchPrices(selected, contracts, quotes, price); }, kernel);
+		}
+	}
+}
+
+#endif
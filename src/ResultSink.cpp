@@ -0,0 +1,62 @@
+// Implementation of the header file ResultSink.hpp
+
+#include "ResultSink.hpp"
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor
+	/// @param columns column names
+	ResultSink::ResultSink(const std::vector<std::string>& columns) : _columns{columns}
+	{
+		if (_columns.empty())
+		{
+			throw IncorrectInputException("Result sink needs at least one column.");
+		}
+	}
+
+	/// @brief destructor
+	ResultSink::~ResultSink() {}
+
+	/// @brief number of rows in a block of values
+	/// @param values row after row of values
+	/// @return number of rows
+	std::size_t ResultSink::getRowCount(std::span<const double> values) const
+	{
+		if (values.size() % _columns.size() != 0)
+		{
+			throw IncorrectInputException("Result rows must have one value per column.");
+		}
+
+		return values.size() / _columns.size();
+	}
+
+	/// @brief write rows given as one vector per row, as returned by the
+	/// Helper_functions sweeps. Empty rows, left by a cancelled sweep, are skipped
+	/// @param rows rows of getColumns().size() values
+	void ResultSink::write(const std::vector<std::vector<double>>& rows)
+	{
+		std::vector<double> values;
+		values.reserve(rows.size() * _columns.size());
+		for (const std::vector<double>& row : rows)
+		{
+			if (row.empty())
+			{
+				continue;
+			}
+			if (row.size() != _columns.size())
+			{
+				throw IncorrectInputException("Result rows must have one value per column.");
+			}
+			values.insert(values.end(), row.begin(), row.end());
+		}
+
+		write(std::span<const double>(values));
+	}
+
+	/// @brief get column names
+	/// @return column names
+	const std::vector<std::string>& ResultSink::getColumns() const
+	{
+		return _columns;
+	}
+}
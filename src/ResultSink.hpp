@@ -0,0 +1,44 @@
+// General result sink class from which specific output writers are derived:
+// CsvResultSink, BinaryResultSink and AsyncResultSink. A sink receives rows
+// of a fixed number of named columns, in blocks of rows stored one after the
+// other, and writes them to its destination.
+
+#ifndef RESULTSINK_HPP
+#define RESULTSINK_HPP
+
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class ResultSink
+	{
+	protected:
+		std::vector<std::string> _columns; // column names
+
+		// Check that values hold whole rows, returns the number of rows
+		std::size_t getRowCount(std::span<const double> values) const;
+
+	public:
+		explicit ResultSink(const std::vector<std::string>& columns); // default constructor
+		ResultSink(const ResultSink& source) =delete; // not copyable, sinks own their output
+		ResultSink& operator= (const ResultSink& source) =delete; // not copyable
+		virtual ~ResultSink(); // destructor
+
+		// Write rows, values holds row after row of getColumns().size() values
+		virtual void write(std::span<const double> values) =0;
+		// Write buffered rows to the destination
+		virtual void flush() =0;
+
+		// Write rows given as one vector per row
+		void write(const std::vector<std::vector<double>>& rows);
+		// Column names
+		const std::vector<std::string>& getColumns() const;
+	};
+}
+
+#endif
@@ -0,0 +1,286 @@
+// Implementation of the header file ScenarioEngine.hpp
+
+#include "ScenarioEngine.hpp"
+#include "StandardNormal.hpp"
+#include "BlackScholesKernel.hpp"
+#include "SweepExecutor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Positions per work item of the position cube
+		constexpr std::size_t chunk_size = 64;
+		// Positions per partition at least, and most partial results kept in memory
+		// when summing per underlying
+		constexpr std::size_t min_partition_size = 1024;
+		constexpr std::size_t max_partitions = 64;
+		constexpr std::size_t max_partial_entries = std::size_t{1} << 24;
+	}
+
+	/// @brief Default constructor
+	/// @param spotShocks relative spot shocks, the shocked spot is S (1 + shock)
+	/// @param volShocks absolute volatility shocks, the shocked volatility is sigma + shock
+	/// @param threads number of threads, 0 uses all hardware threads
+	ScenarioEngine::ScenarioEngine(const std::vector<double>& spotShocks, const std::vector<double>& volShocks,
+								   std::size_t threads)
+	: _spotShocks{spotShocks}, _volShocks{volShocks}, _threads{threads}
+	{
+		if (_spotShocks.empty() || _volShocks.empty())
+		{
+			throw IncorrectInputException("Scenario grid needs at least one spot and one volatility shock.");
+		}
+		for (double shock : _spotShocks)
+		{
+			if (!(shock > -1.0))
+			{
+				throw IncorrectInputException("Spot shocks must be above -100%.");
+			}
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source ScenarioEngine object
+	ScenarioEngine::ScenarioEngine(const ScenarioEngine& source)
+	: _spotShocks{source._spotShocks}, _volShocks{source._volShocks}, _threads{source._threads}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source ScenarioEngine object
+	/// @return ScenarioEngine object
+	ScenarioEngine& ScenarioEngine::operator= (const ScenarioEngine& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_spotShocks = source._spotShocks;
+		_volShocks = source._volShocks;
+		_threads = source._threads;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	ScenarioEngine::~ScenarioEngine() {}
+
+	/// @brief evenly spaced shocks, e.g. makeLadder(0.1, 21) gives -10%, -9%, ..., 10%
+	/// @param width largest shock
+	/// @param count number of shocks, odd so that 0 is one of them
+	/// @return shocks in increasing order
+	std::vector<double> ScenarioEngine::makeLadder(double width, std::size_t count)
+	{
+		if (count % 2 == 0)
+		{
+			throw IncorrectInputException("Ladder needs an odd number of shocks.");
+		}
+
+		std::vector<double> shocks(count);
+		const std::size_t half{count / 2};
+		for (std::size_t i = 0; i < count; i++)
+		{
+			shocks[i] = (half == 0) ? 0.0 : width * (static_cast<double>(i) - static_cast<double>(half))
+												  / static_cast<double>(half);
+		}
+
+		return shocks;
+	}
+
+	/// @brief get number of scenarios
+	/// @return spot shocks times volatility shocks
+	std::size_t ScenarioEngine::getScenarioCount() const
+	{
+		return _spotShocks.size() * _volShocks.size();
+	}
+
+	/// @brief check that every underlying has a quote and stays at a positive
+	/// volatility in every scenario
+	/// @param portfolio positions
+	/// @param quotes quote of each underlying
+	void ScenarioEngine::validate(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const
+	{
+		if (quotes.size() < portfolio.getUnderlyingCount())
+		{
+			throw IncorrectInputException("Every underlying of the portfolio needs a quote.");
+		}
+
+		const double lowest{*std::min_element(_volShocks.begin(), _volShocks.end())};
+		for (std::size_t u = 0; u < portfolio.getUnderlyingCount(); u++)
+		{
+			if (!(quotes[u].sigma + lowest > 0.0))
+			{
+				throw IncorrectInputException("Volatility shocks must leave a positive volatility.");
+			}
+		}
+	}
+
+	/// @brief revalue positions [begin, end) over all scenarios and add their P&L
+	/// to the rows of out. Per position the scenario independent terms are computed
+	/// once, and d1, d2 of all scenarios and of the unshocked market go through one
+	/// call of the vectorized cdf
+	/// @param portfolio positions
+	/// @param quotes quote of each underlying
+	/// @param logSpots shocked log spots, logSpots[u * spots + i]
+	/// @param begin first position
+	/// @param end one past the last position
+	/// @param out P&L rows
+	/// @param row maps a position index to its row in out
+	template <typename Row>
+	void ScenarioEngine::revalue(const Portfolio& portfolio, std::span<const MarketQuote> quotes,
+								 std::span<const double> logSpots, std::size_t begin, std::size_t end,
+								 double* out, Row row) const
+	{
+		const std::size_t spots{_spotShocks.size()};
+		const std::size_t vols{_volShocks.size()};
+		const std::size_t m{spots * vols};
+		// Scenarios first, the unshocked market last
+		std::vector<double> d(2 * (m + 1));
+		std::vector<double> N_d(2 * (m + 1));
+		std::vector<double> sigmaSqrtT(vols);
+		std::vector<double> drift(vols);
+
+		const std::span<const Position> positions{portfolio.getPositions()};
+		for (std::size_t p = begin; p < end; p++)
+		{
+			const Position& position = positions[p];
+			if (position.contract.exercise != Payoff::European)
+			{
+				throw IncorrectEngineException("Only European Options have analytic solution.");
+			}
+
+			const MarketQuote& quote = quotes[position.underlying];
+			const double K{position.contract.K};
+			const double T{position.contract.T};
+			const double logK = std::log(K);
+			const double sqrt_T = std::sqrt(T);
+			const double carry = std::exp( (quote.b - quote.r) * T );
+			const double discount = K * std::exp(-quote.r * T);
+			const double* logSpot = logSpots.data() + position.underlying * spots;
+
+			for (std::size_t j = 0; j < vols; j++)
+			{
+				const double sigma = quote.sigma + _volShocks[j];
+				sigmaSqrtT[j] = sigma * sqrt_T;
+				drift[j] = (quote.b + sigma * sigma / 2) * T - logK;
+			}
+			for (std::size_t i = 0; i < spots; i++)
+			{
+				for (std::size_t j = 0; j < vols; j++)
+				{
+					const double d1 = (logSpot[i] + drift[j]) / sigmaSqrtT[j];
+					d[i * vols + j] = d1;
+					d[m + 1 + i * vols + j] = d1 - sigmaSqrtT[j];
+				}
+			}
+			// The unshocked market through the terms of the cells, so a cell
+			// without shocks has a P&L of exactly 0
+			const double baseSigmaSqrtT = quote.sigma * sqrt_T;
+			const double baseDrift = (quote.b + quote.sigma * quote.sigma / 2) * T - logK;
+			const double d1 = (std::log(quote.S) + baseDrift) / baseSigmaSqrtT;
+			d[m] = d1;
+			d[2 * m + 1] = d1 - baseSigmaSqrtT;
+			StandardNormal::cdf(std::span<const double>(d), std::span<double>(N_d));
+
+			const bool isCall{position.contract.type == Payoff::Type::Call};
+			const double baseCall = quote.S * carry * N_d[m] - discount * N_d[2 * m + 1];
+			const double base = isCall ? baseCall : BlackScholesKernels::getPutFromCall(baseCall, quote.S, discount);
+			double* pnl = out + row(p) * m;
+			for (std::size_t i = 0; i < spots; i++)
+			{
+				const double S = quote.S * (1 + _spotShocks[i]);
+				for (std::size_t j = 0; j < vols; j++)
+				{
+					const std::size_t k{i * vols + j};
+					const double call = S * carry * N_d[k] - discount * N_d[m + 1 + k];
+					const double price = isCall ? call : BlackScholesKernels::getPutFromCall(call, S, discount);
+					pnl[k] += position.quantity * (price - base);
+				}
+			}
+		}
+	}
+
+	/// @brief P&L of every position in every scenario against the unshocked market
+	/// @param portfolio positions, all European
+	/// @param quotes quote of each underlying
+	/// @return cube with one row per position
+	ScenarioCube ScenarioEngine::getPositionPnL(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const
+	{
+		validate(portfolio, quotes);
+
+		const std::size_t spots{_spotShocks.size()};
+		std::vector<double> logSpots(portfolio.getUnderlyingCount() * spots);
+		for (std::size_t u = 0; u < portfolio.getUnderlyingCount(); u++)
+		{
+			for (std::size_t i = 0; i < spots; i++)
+			{
+				logSpots[u * spots + i] = std::log(quotes[u].S * (1 + _spotShocks[i]));
+			}
+		}
+
+		ScenarioCube cube{portfolio.getPositionCount(), spots, _volShocks.size(), {}};
+		cube.pnl.assign(cube.rows * getScenarioCount(), 0.0);
+		SweepExecutor executor(_threads, chunk_size);
+		executor.run(portfolio.getPositionCount(), [&](std::size_t begin, std::size_t end)
+		{
+			revalue(portfolio, quotes, logSpots, begin, end, cube.pnl.data(), [](std::size_t p) { return p; });
+		});
+
+		return cube;
+	}
+
+	/// @brief P&L in every scenario summed over the positions of each underlying.
+	/// Positions are split in at most 64 partitions of at least 1024 positions, each
+	/// partition is summed by one thread and the partial cubes are added in partition
+	/// order, so the result is the same for any number of threads
+	/// @param portfolio positions, all European
+	/// @param quotes quote of each underlying
+	/// @return cube with one row per underlying
+	ScenarioCube ScenarioEngine::getUnderlyingPnL(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const
+	{
+		validate(portfolio, quotes);
+
+		const std::size_t spots{_spotShocks.size()};
+		const std::size_t underlyings{portfolio.getUnderlyingCount()};
+		const std::size_t m{getScenarioCount()};
+		std::vector<double> logSpots(underlyings * spots);
+		for (std::size_t u = 0; u < underlyings; u++)
+		{
+			for (std::size_t i = 0; i < spots; i++)
+			{
+				logSpots[u * spots + i] = std::log(quotes[u].S * (1 + _spotShocks[i]));
+			}
+		}
+
+		const std::size_t n{portfolio.getPositionCount()};
+		const std::size_t cubeSize{std::max<std::size_t>(underlyings * m, 1)};
+		std::size_t partitions = std::max<std::size_t>(1, n / min_partition_size);
+		partitions = std::min({partitions, max_partitions, std::max<std::size_t>(1, max_partial_entries / cubeSize)});
+		const std::size_t partitionSize = std::max<std::size_t>(1, (n + partitions - 1) / partitions);
+
+		// Partial cube of partition p starts at partial[p * cubeSize]
+		std::vector<double> partial(partitions * cubeSize, 0.0);
+		const std::span<const Position> positions{portfolio.getPositions()};
+		SweepExecutor executor(_threads, partitionSize);
+		executor.run(n, [&](std::size_t begin, std::size_t end)
+		{
+			revalue(portfolio, quotes, logSpots, begin, end, partial.data() + (begin / partitionSize) * cubeSize,
+					[&](std::size_t p) { return positions[p].underlying; });
+		});
+
+		ScenarioCube cube{underlyings, spots, _volShocks.size(), std::vector<double>(underlyings * m, 0.0)};
+		for (std::size_t p = 0; p < partitions; p++)
+		{
+			for (std::size_t k = 0; k < underlyings * m; k++)
+			{
+				cube.pnl[k] += partial[p * cubeSize + k];
+			}
+		}
+
+		return cube;
+	}
+}
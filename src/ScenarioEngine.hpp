@@ -0,0 +1,78 @@
+// Scenario engine to revalue a portfolio of European options over a grid of
+// spot and volatility shocks with the Black-Scholes formulas of
+// AnalyticEuropeanEngine. Terms that do not change across scenarios, such as
+// log(K), sqrt(T), discount factors and the shocked log spots of each
+// underlying, are computed once; the d1 and d2 of all scenarios of a position
+// then go through the vectorized normal cdf in one call. Positions are
+// revalued in parallel and the result is a P&L cube, per position or summed
+// per underlying.
+
+#ifndef SCENARIOENGINE_HPP
+#define SCENARIOENGINE_HPP
+
+#include "Portfolio.hpp"
+#include "MarketQuote.hpp"
+#include "IncorrectEngineException.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace PricingLibrary {
+
+	// P&L of rows (positions or underlyings) over spot x volatility scenarios
+	struct ScenarioCube
+	{
+		std::size_t rows{};    // number of positions or underlyings
+		std::size_t spots{};   // number of spot shocks
+		std::size_t vols{};    // number of volatility shocks
+		std::vector<double> pnl; // P&L of row, spot shock i and vol shock j at (row * spots + i) * vols + j
+
+		/// @brief P&L of one scenario
+		/// @param row position or underlying
+		/// @param spot index of the spot shock
+		/// @param vol index of the volatility shock
+		/// @return P&L
+		double at(std::size_t row, std::size_t spot, std::size_t vol) const
+		{
+			return pnl[(row * spots + spot) * vols + vol];
+		}
+	};
+
+	class ScenarioEngine
+	{
+	private:
+		std::vector<double> _spotShocks; // relative spot shocks, S (1 + shock)
+		std::vector<double> _volShocks;  // absolute volatility shocks, sigma + shock
+		std::size_t _threads;            // number of threads, 0 uses all hardware threads
+
+		// Check the book and quotes before a revaluation
+		void validate(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const;
+		// Revalue positions [begin, end), position i adds its P&L to out[row(i) * scenarios ...]
+		template <typename Row>
+		void revalue(const Portfolio& portfolio, std::span<const MarketQuote> quotes,
+					 std::span<const double> logSpots, std::size_t begin, std::size_t end,
+					 double* out, Row row) const;
+
+	public:
+		ScenarioEngine(const std::vector<double>& spotShocks, const std::vector<double>& volShocks,
+					   std::size_t threads=1); // default constructor
+		ScenarioEngine(const ScenarioEngine& source); // copy constructor
+		ScenarioEngine& operator= (const ScenarioEngine& source); // copy assignment
+		~ScenarioEngine(); // destructor
+
+		// Evenly spaced shocks from -width to width, count must be odd to include 0
+		static std::vector<double> makeLadder(double width, std::size_t count);
+
+		// Number of scenarios, spot shocks times volatility shocks
+		std::size_t getScenarioCount() const;
+
+		// P&L of every position against the unshocked market
+		ScenarioCube getPositionPnL(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const;
+		// P&L summed over the positions of each underlying
+		ScenarioCube getUnderlyingPnL(const Portfolio& portfolio, std::span<const MarketQuote> quotes) const;
+	};
+}
+
+#endif
@@ -0,0 +1,641 @@
+// Implementation of the header file StandardNormal.hpp
+
+#include "StandardNormal.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STANDARDNORMAL_X86
+#include <immintrin.h>
+#endif
+
+namespace PricingLibrary {
+
+	namespace StandardNormal
+	{
+		namespace
+		{
+			// Above this absolute value the tail probability and the density are
+			// treated as zero. Vector kernels clamp their input slightly above it,
+			// which keeps the exponent of exp(-x^2/2) in the normal range
+			constexpr double cutoff = 37.0;
+			// Below this absolute value the rational approximation is used
+			constexpr double rational_limit = 7.07106781186547;
+			// ln(2) split in two parts so that n * ln2_hi is exact
+			constexpr double ln2_hi = 6.93147180369123816490e-01;
+			constexpr double ln2_lo = 1.90821492927058770002e-10;
+			constexpr double log2e = 1.44269504088896338700e+00;
+			// 1/k! for k = 13..0, Taylor series of exp on |r| <= ln(2)/2
+			constexpr double exp_coefficients[] = {
+				1.0 / 6227020800.0, 1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0,
+				1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0, 1.0 / 720.0, 1.0 / 120.0,
+				1.0 / 24.0, 1.0 / 6.0, 1.0 / 2.0, 1.0, 1.0};
+			// Hart's rational approximation, highest degree first
+			constexpr double hart_num[] = {
+				3.52624965998911e-02, 0.700383064443688, 6.37396220353165, 33.912866078383,
+				112.079291497871, 221.213596169931, 220.206867912376};
+			constexpr double hart_den[] = {
+				8.83883476483184e-02, 1.75566716318264, 16.064177579207, 86.7807322029461,
+				296.564248779674, 637.333633378831, 793.826512519948, 440.413735824752};
+
+			// Single precision kernels evaluate the same approximations in float.
+			// The tail beyond float_cutoff is treated as zero, which keeps the
+			// exponential above the smallest normal float
+			constexpr float float_cutoff = 12.0f;
+			// ln(2) split in two parts so that n * float_ln2_hi is exact
+			constexpr float float_ln2_hi = 0.693359375f;
+			constexpr float float_ln2_lo = -2.12194440e-4f;
+			// 1/k! for k = 7..0, Taylor series of exp on |r| <= ln(2)/2
+			constexpr float float_exp_coefficients[] = {
+				1.0f / 5040.0f, 1.0f / 720.0f, 1.0f / 120.0f, 1.0f / 24.0f, 1.0f / 6.0f, 1.0f / 2.0f, 1.0f, 1.0f};
+
+			/// @brief throw if input and output sizes differ
+			/// @param x input
+			/// @param result output
+			template <typename Real>
+			void check_sizes(std::span<const Real> x, std::span<Real> result)
+			{
+				if (x.size() != result.size())
+				{
+					throw IncorrectInputException("Input and output of the normal distribution must have the same length.");
+				}
+			}
+
+			/// @brief scalar cdf loop
+			void cdf_scalar(const double* x, double* result, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; i++)
+				{
+					result[i] = cdf(x[i]);
+				}
+			}
+
+			/// @brief scalar pdf loop
+			void pdf_scalar(const double* x, double* result, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; i++)
+				{
+					result[i] = pdf(x[i]);
+				}
+			}
+
+			/// @brief cdf in single precision
+			float cdf_float(float x)
+			{
+				const float a = std::abs(x);
+				float tail{};
+				if (a <= float_cutoff)
+				{
+					const float e = std::exp(-a * a / 2);
+					if (a < static_cast<float>(rational_limit))
+					{
+						float num = static_cast<float>(hart_num[0]);
+						for (std::size_t k = 1; k < std::size(hart_num); k++)
+						{
+							num = num * a + static_cast<float>(hart_num[k]);
+						}
+						float den = static_cast<float>(hart_den[0]);
+						for (std::size_t k = 1; k < std::size(hart_den); k++)
+						{
+							den = den * a + static_cast<float>(hart_den[k]);
+						}
+						tail = e * num / den;
+					}
+					else
+					{
+						float cf = a + 0.65f;
+						for (float k : {4.0f, 3.0f, 2.0f, 1.0f})
+						{
+							cf = a + k / cf;
+						}
+						tail = e / cf / 2.506628274631f;
+					}
+				}
+
+				return (x > 0) ? 1 - tail : tail;
+			}
+
+			/// @brief pdf in single precision
+			float pdf_float(float x)
+			{
+				return (std::abs(x) <= float_cutoff) ? static_cast<float>(inv_sqrt_2pi) * std::exp(-x * x / 2) : 0.0f;
+			}
+
+			/// @brief scalar single precision cdf loop
+			void cdf_scalar(const float* x, float* result, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; i++)
+				{
+					result[i] = cdf_float(x[i]);
+				}
+			}
+
+			/// @brief scalar single precision pdf loop
+			void pdf_scalar(const float* x, float* result, std::size_t n)
+			{
+				for (std::size_t i = 0; i < n; i++)
+				{
+					result[i] = pdf_float(x[i]);
+				}
+			}
+
+#ifdef STANDARDNORMAL_X86
+			/// @brief exp for arguments in [-700, 0], AVX2 lanes
+			__attribute__((target("avx2,fma")))
+			__m256d exp_avx2(__m256d x)
+			{
+				__m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(log2e)),
+											_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+				__m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2_hi), x);
+				r = _mm256_fnmadd_pd(n, _mm256_set1_pd(ln2_lo), r);
+				__m256d p = _mm256_set1_pd(exp_coefficients[0]);
+				for (std::size_t k = 1; k < std::size(exp_coefficients); k++)
+				{
+					p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(exp_coefficients[k]));
+				}
+				// Build 2^n directly in the exponent bits
+				const __m256d shifter = _mm256_set1_pd(6755399441055744.0);
+				__m256i bits = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n, shifter)),
+												_mm256_castpd_si256(shifter));
+				bits = _mm256_slli_epi64(_mm256_add_epi64(bits, _mm256_set1_epi64x(1023)), 52);
+
+				return _mm256_mul_pd(p, _mm256_castsi256_pd(bits));
+			}
+
+			/// @brief cdf of four lanes
+			__attribute__((target("avx2,fma")))
+			__m256d cdf_avx2(__m256d x)
+			{
+				const __m256d a = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+				const __m256d a_clamped = _mm256_min_pd(a, _mm256_set1_pd(cutoff + 0.5));
+				const __m256d e = exp_avx2(_mm256_mul_pd(_mm256_mul_pd(a_clamped, a_clamped), _mm256_set1_pd(-0.5)));
+
+				__m256d num = _mm256_set1_pd(hart_num[0]);
+				for (std::size_t k = 1; k < std::size(hart_num); k++)
+				{
+					num = _mm256_fmadd_pd(num, a_clamped, _mm256_set1_pd(hart_num[k]));
+				}
+				__m256d den = _mm256_set1_pd(hart_den[0]);
+				for (std::size_t k = 1; k < std::size(hart_den); k++)
+				{
+					den = _mm256_fmadd_pd(den, a_clamped, _mm256_set1_pd(hart_den[k]));
+				}
+				const __m256d rational = _mm256_div_pd(_mm256_mul_pd(e, num), den);
+
+				__m256d cf = _mm256_add_pd(a_clamped, _mm256_set1_pd(0.65));
+				for (double k : {4.0, 3.0, 2.0, 1.0})
+				{
+					cf = _mm256_add_pd(a_clamped, _mm256_div_pd(_mm256_set1_pd(k), cf));
+				}
+				const __m256d fraction = _mm256_div_pd(_mm256_div_pd(e, cf), _mm256_set1_pd(2.506628274631));
+
+				__m256d tail = _mm256_blendv_pd(fraction, rational,
+												_mm256_cmp_pd(a, _mm256_set1_pd(rational_limit), _CMP_LT_OQ));
+				tail = _mm256_and_pd(tail, _mm256_cmp_pd(a, _mm256_set1_pd(cutoff), _CMP_LE_OQ));
+
+				return _mm256_blendv_pd(tail, _mm256_sub_pd(_mm256_set1_pd(1.0), tail),
+										_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_GT_OQ));
+			}
+
+			/// @brief pdf of four lanes
+			__attribute__((target("avx2,fma")))
+			__m256d pdf_avx2(__m256d x)
+			{
+				const __m256d a = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+				const __m256d a_clamped = _mm256_min_pd(a, _mm256_set1_pd(cutoff + 0.5));
+				const __m256d e = exp_avx2(_mm256_mul_pd(_mm256_mul_pd(a_clamped, a_clamped), _mm256_set1_pd(-0.5)));
+
+				return _mm256_and_pd(_mm256_mul_pd(_mm256_set1_pd(inv_sqrt_2pi), e),
+									 _mm256_cmp_pd(a, _mm256_set1_pd(cutoff), _CMP_LE_OQ));
+			}
+
+			/// @brief apply an AVX2 kernel to an array, the remainder goes through a padded block
+			template <__m256d (*kernel)(__m256d)>
+			__attribute__((target("avx2,fma")))
+			void apply_avx2(const double* x, double* result, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + 4 <= n; i += 4)
+				{
+					_mm256_storeu_pd(result + i, kernel(_mm256_loadu_pd(x + i)));
+				}
+				if (i < n)
+				{
+					alignas(32) double block[4] = {0.0, 0.0, 0.0, 0.0};
+					std::copy(x + i, x + n, block);
+					_mm256_store_pd(block, kernel(_mm256_load_pd(block)));
+					std::copy(block, block + (n - i), result + i);
+				}
+			}
+
+			/// @brief exp for arguments in [-80, 0], eight single precision AVX2 lanes
+			__attribute__((target("avx2,fma")))
+			__m256 exp_avx2(__m256 x)
+			{
+				__m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(static_cast<float>(log2e))),
+										   _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+				__m256 r = _mm256_fnmadd_ps(n, _mm256_set1_ps(float_ln2_hi), x);
+				r = _mm256_fnmadd_ps(n, _mm256_set1_ps(float_ln2_lo), r);
+				__m256 p = _mm256_set1_ps(float_exp_coefficients[0]);
+				for (std::size_t k = 1; k < std::size(float_exp_coefficients); k++)
+				{
+					p = _mm256_fmadd_ps(p, r, _mm256_set1_ps(float_exp_coefficients[k]));
+				}
+				// Build 2^n directly in the exponent bits
+				const __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+
+				return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+			}
+
+			/// @brief cdf of eight single precision lanes
+			__attribute__((target("avx2,fma")))
+			__m256 cdf_avx2(__m256 x)
+			{
+				const __m256 a = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+				const __m256 a_clamped = _mm256_min_ps(a, _mm256_set1_ps(float_cutoff + 0.5f));
+				const __m256 e = exp_avx2(_mm256_mul_ps(_mm256_mul_ps(a_clamped, a_clamped), _mm256_set1_ps(-0.5f)));
+
+				__m256 num = _mm256_set1_ps(static_cast<float>(hart_num[0]));
+				for (std::size_t k = 1; k < std::size(hart_num); k++)
+				{
+					num = _mm256_fmadd_ps(num, a_clamped, _mm256_set1_ps(static_cast<float>(hart_num[k])));
+				}
+				__m256 den = _mm256_set1_ps(static_cast<float>(hart_den[0]));
+				for (std::size_t k = 1; k < std::size(hart_den); k++)
+				{
+					den = _mm256_fmadd_ps(den, a_clamped, _mm256_set1_ps(static_cast<float>(hart_den[k])));
+				}
+				const __m256 rational = _mm256_div_ps(_mm256_mul_ps(e, num), den);
+
+				__m256 cf = _mm256_add_ps(a_clamped, _mm256_set1_ps(0.65f));
+				for (float k : {4.0f, 3.0f, 2.0f, 1.0f})
+				{
+					cf = _mm256_add_ps(a_clamped, _mm256_div_ps(_mm256_set1_ps(k), cf));
+				}
+				const __m256 fraction = _mm256_div_ps(_mm256_div_ps(e, cf), _mm256_set1_ps(2.506628274631f));
+
+				__m256 tail = _mm256_blendv_ps(fraction, rational,
+											   _mm256_cmp_ps(a, _mm256_set1_ps(static_cast<float>(rational_limit)), _CMP_LT_OQ));
+				tail = _mm256_and_ps(tail, _mm256_cmp_ps(a, _mm256_set1_ps(float_cutoff), _CMP_LE_OQ));
+
+				return _mm256_blendv_ps(tail, _mm256_sub_ps(_mm256_set1_ps(1.0f), tail),
+										_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ));
+			}
+
+			/// @brief pdf of eight single precision lanes
+			__attribute__((target("avx2,fma")))
+			__m256 pdf_avx2(__m256 x)
+			{
+				const __m256 a = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+				const __m256 a_clamped = _mm256_min_ps(a, _mm256_set1_ps(float_cutoff + 0.5f));
+				const __m256 e = exp_avx2(_mm256_mul_ps(_mm256_mul_ps(a_clamped, a_clamped), _mm256_set1_ps(-0.5f)));
+
+				return _mm256_and_ps(_mm256_mul_ps(_mm256_set1_ps(static_cast<float>(inv_sqrt_2pi)), e),
+									 _mm256_cmp_ps(a, _mm256_set1_ps(float_cutoff), _CMP_LE_OQ));
+			}
+
+			/// @brief apply a single precision AVX2 kernel to an array, the remainder goes through a padded block
+			template <__m256 (*kernel)(__m256)>
+			__attribute__((target("avx2,fma")))
+			void apply_avx2(const float* x, float* result, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= n; i += 8)
+				{
+					_mm256_storeu_ps(result + i, kernel(_mm256_loadu_ps(x + i)));
+				}
+				if (i < n)
+				{
+					alignas(32) float block[8] = {};
+					std::copy(x + i, x + n, block);
+					_mm256_store_ps(block, kernel(_mm256_load_ps(block)));
+					std::copy(block, block + (n - i), result + i);
+				}
+			}
+
+			// AVX-512 kernels use the zero-masked forms of min, roundscale and scalef
+			// with a full mask, the unmasked forms trip -Wuninitialized in GCC 12 headers
+
+			/// @brief exp for arguments in [-700, 0], AVX-512 lanes
+			__attribute__((target("avx512f")))
+			__m512d exp_avx512(__m512d x)
+			{
+				__m512d n = _mm512_maskz_roundscale_pd(0xFF, _mm512_mul_pd(x, _mm512_set1_pd(log2e)),
+												 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+				__m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(ln2_hi), x);
+				r = _mm512_fnmadd_pd(n, _mm512_set1_pd(ln2_lo), r);
+				__m512d p = _mm512_set1_pd(exp_coefficients[0]);
+				for (std::size_t k = 1; k < std::size(exp_coefficients); k++)
+				{
+					p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(exp_coefficients[k]));
+				}
+
+				return _mm512_maskz_scalef_pd(0xFF, p, n);
+			}
+
+			/// @brief cdf of eight lanes
+			__attribute__((target("avx512f")))
+			__m512d cdf_avx512(__m512d x)
+			{
+				const __m512d a = _mm512_abs_pd(x);
+				const __m512d a_clamped = _mm512_maskz_min_pd(0xFF, a, _mm512_set1_pd(cutoff + 0.5));
+				const __m512d e = exp_avx512(_mm512_mul_pd(_mm512_mul_pd(a_clamped, a_clamped), _mm512_set1_pd(-0.5)));
+
+				__m512d num = _mm512_set1_pd(hart_num[0]);
+				for (std::size_t k = 1; k < std::size(hart_num); k++)
+				{
+					num = _mm512_fmadd_pd(num, a_clamped, _mm512_set1_pd(hart_num[k]));
+				}
+				__m512d den = _mm512_set1_pd(hart_den[0]);
+				for (std::size_t k = 1; k < std::size(hart_den); k++)
+				{
+					den = _mm512_fmadd_pd(den, a_clamped, _mm512_set1_pd(hart_den[k]));
+				}
+				const __m512d rational = _mm512_div_pd(_mm512_mul_pd(e, num), den);
+
+				__m512d cf = _mm512_add_pd(a_clamped, _mm512_set1_pd(0.65));
+				for (double k : {4.0, 3.0, 2.0, 1.0})
+				{
+					cf = _mm512_add_pd(a_clamped, _mm512_div_pd(_mm512_set1_pd(k), cf));
+				}
+				const __m512d fraction = _mm512_div_pd(_mm512_div_pd(e, cf), _mm512_set1_pd(2.506628274631));
+
+				__m512d tail = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, _mm512_set1_pd(rational_limit), _CMP_LT_OQ),
+													fraction, rational);
+				tail = _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(a, _mm512_set1_pd(cutoff), _CMP_LE_OQ), tail);
+
+				return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_GT_OQ),
+											tail, _mm512_sub_pd(_mm512_set1_pd(1.0), tail));
+			}
+
+			/// @brief pdf of eight lanes
+			__attribute__((target("avx512f")))
+			__m512d pdf_avx512(__m512d x)
+			{
+				const __m512d a = _mm512_abs_pd(x);
+				const __m512d a_clamped = _mm512_maskz_min_pd(0xFF, a, _mm512_set1_pd(cutoff + 0.5));
+				const __m512d e = exp_avx512(_mm512_mul_pd(_mm512_mul_pd(a_clamped, a_clamped), _mm512_set1_pd(-0.5)));
+
+				return _mm512_maskz_mul_pd(_mm512_cmp_pd_mask(a, _mm512_set1_pd(cutoff), _CMP_LE_OQ),
+										   _mm512_set1_pd(inv_sqrt_2pi), e);
+			}
+
+			/// @brief apply an AVX-512 kernel to an array, the remainder is handled with a lane mask
+			template <__m512d (*kernel)(__m512d)>
+			__attribute__((target("avx512f")))
+			void apply_avx512(const double* x, double* result, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + 8 <= n; i += 8)
+				{
+					_mm512_storeu_pd(result + i, kernel(_mm512_loadu_pd(x + i)));
+				}
+				if (i < n)
+				{
+					const __mmask8 mask = static_cast<__mmask8>((1u << (n - i)) - 1);
+					_mm512_mask_storeu_pd(result + i, mask, kernel(_mm512_maskz_loadu_pd(mask, x + i)));
+				}
+			}
+
+			/// @brief exp for arguments in [-80, 0], sixteen single precision AVX-512 lanes
+			__attribute__((target("avx512f")))
+			__m512 exp_avx512(__m512 x)
+			{
+				__m512 n = _mm512_maskz_roundscale_ps(0xFFFF, _mm512_mul_ps(x, _mm512_set1_ps(static_cast<float>(log2e))),
+													  _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+				__m512 r = _mm512_fnmadd_ps(n, _mm512_set1_ps(float_ln2_hi), x);
+				r = _mm512_fnmadd_ps(n, _mm512_set1_ps(float_ln2_lo), r);
+				__m512 p = _mm512_set1_ps(float_exp_coefficients[0]);
+				for (std::size_t k = 1; k < std::size(float_exp_coefficients); k++)
+				{
+					p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(float_exp_coefficients[k]));
+				}
+
+				return _mm512_maskz_scalef_ps(0xFFFF, p, n);
+			}
+
+			/// @brief cdf of sixteen single precision lanes
+			__attribute__((target("avx512f")))
+			__m512 cdf_avx512(__m512 x)
+			{
+				const __m512 a = _mm512_abs_ps(x);
+				const __m512 a_clamped = _mm512_maskz_min_ps(0xFFFF, a, _mm512_set1_ps(float_cutoff + 0.5f));
+				const __m512 e = exp_avx512(_mm512_mul_ps(_mm512_mul_ps(a_clamped, a_clamped), _mm512_set1_ps(-0.5f)));
+
+				__m512 num = _mm512_set1_ps(static_cast<float>(hart_num[0]));
+				for (std::size_t k = 1; k < std::size(hart_num); k++)
+				{
+					num = _mm512_fmadd_ps(num, a_clamped, _mm512_set1_ps(static_cast<float>(hart_num[k])));
+				}
+				__m512 den = _mm512_set1_ps(static_cast<float>(hart_den[0]));
+				for (std::size_t k = 1; k < std::size(hart_den); k++)
+				{
+					den = _mm512_fmadd_ps(den, a_clamped, _mm512_set1_ps(static_cast<float>(hart_den[k])));
+				}
+				const __m512 rational = _mm512_div_ps(_mm512_mul_ps(e, num), den);
+
+				__m512 cf = _mm512_add_ps(a_clamped, _mm512_set1_ps(0.65f));
+				for (float k : {4.0f, 3.0f, 2.0f, 1.0f})
+				{
+					cf = _mm512_add_ps(a_clamped, _mm512_div_ps(_mm512_set1_ps(k), cf));
+				}
+				const __m512 fraction = _mm512_div_ps(_mm512_div_ps(e, cf), _mm512_set1_ps(2.506628274631f));
+
+				__m512 tail = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, _mm512_set1_ps(static_cast<float>(rational_limit)), _CMP_LT_OQ),
+												   fraction, rational);
+				tail = _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(a, _mm512_set1_ps(float_cutoff), _CMP_LE_OQ), tail);
+
+				return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GT_OQ),
+											tail, _mm512_sub_ps(_mm512_set1_ps(1.0f), tail));
+			}
+
+			/// @brief pdf of sixteen single precision lanes
+			__attribute__((target("avx512f")))
+			__m512 pdf_avx512(__m512 x)
+			{
+				const __m512 a = _mm512_abs_ps(x);
+				const __m512 a_clamped = _mm512_maskz_min_ps(0xFFFF, a, _mm512_set1_ps(float_cutoff + 0.5f));
+				const __m512 e = exp_avx512(_mm512_mul_ps(_mm512_mul_ps(a_clamped, a_clamped), _mm512_set1_ps(-0.5f)));
+
+				return _mm512_maskz_mul_ps(_mm512_cmp_ps_mask(a, _mm512_set1_ps(float_cutoff), _CMP_LE_OQ),
+										   _mm512_set1_ps(static_cast<float>(inv_sqrt_2pi)), e);
+			}
+
+			/// @brief apply a single precision AVX-512 kernel to an array, the remainder is handled with a lane mask
+			template <__m512 (*kernel)(__m512)>
+			__attribute__((target("avx512f")))
+			void apply_avx512(const float* x, float* result, std::size_t n)
+			{
+				std::size_t i = 0;
+				for (; i + 16 <= n; i += 16)
+				{
+					_mm512_storeu_ps(result + i, kernel(_mm512_loadu_ps(x + i)));
+				}
+				if (i < n)
+				{
+					const __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+					_mm512_mask_storeu_ps(result + i, mask, kernel(_mm512_maskz_loadu_ps(mask, x + i)));
+				}
+			}
+#endif
+
+			/// @brief detect the widest supported instruction set
+			/// @return instruction set
+			Isa detect_isa()
+			{
+#ifdef STANDARDNORMAL_X86
+				if (__builtin_cpu_supports("avx512f"))
+				{
+					return Isa::AVX512;
+				}
+				if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				{
+					return Isa::AVX2;
+				}
+#endif
+				return Isa::Scalar;
+			}
+		}
+
+		/// @brief instruction set used by the batch functions, detected once
+		/// @return instruction set
+		Isa selectedIsa()
+		{
+			static const Isa isa = detect_isa();
+			return isa;
+		}
+
+		/// @brief evaluate cdf on an array with the best instruction set
+		/// @param x points
+		/// @param result output probabilities
+		void cdf(std::span<const double> x, std::span<double> result)
+		{
+			cdf(x, result, selectedIsa());
+		}
+
+		/// @brief evaluate cdf on an array with a given instruction set.
+		/// Instruction sets the CPU does not support fall back to the best supported one
+		/// @param x points
+		/// @param result output probabilities
+		/// @param isa instruction set
+		void cdf(std::span<const double> x, std::span<double> result, Isa isa)
+		{
+			check_sizes(x, result);
+			isa = std::min(isa, selectedIsa());
+#ifdef STANDARDNORMAL_X86
+			if (isa == Isa::AVX512)
+			{
+				apply_avx512<cdf_avx512>(x.data(), result.data(), x.size());
+				return;
+			}
+			if (isa == Isa::AVX2)
+			{
+				apply_avx2<cdf_avx2>(x.data(), result.data(), x.size());
+				return;
+			}
+#endif
+			cdf_scalar(x.data(), result.data(), x.size());
+		}
+
+		/// @brief evaluate pdf on an array with the best instruction set
+		/// @param x points
+		/// @param result output densities
+		void pdf(std::span<const double> x, std::span<double> result)
+		{
+			pdf(x, result, selectedIsa());
+		}
+
+		/// @brief evaluate pdf on an array with a given instruction set.
+		/// Instruction sets the CPU does not support fall back to the best supported one
+		/// @param x points
+		/// @param result output densities
+		/// @param isa instruction set
+		void pdf(std::span<const double> x, std::span<double> result, Isa isa)
+		{
+			check_sizes(x, result);
+			isa = std::min(isa, selectedIsa());
+#ifdef STANDARDNORMAL_X86
+			if (isa == Isa::AVX512)
+			{
+				apply_avx512<pdf_avx512>(x.data(), result.data(), x.size());
+				return;
+			}
+			if (isa == Isa::AVX2)
+			{
+				apply_avx2<pdf_avx2>(x.data(), result.data(), x.size());
+				return;
+			}
+#endif
+			pdf_scalar(x.data(), result.data(), x.size());
+		}
+
+		/// @brief evaluate cdf on a single precision array with the best instruction set
+		/// @param x points
+		/// @param result output probabilities
+		void cdf(std::span<const float> x, std::span<float> result)
+		{
+			cdf(x, result, selectedIsa());
+		}
+
+		/// @brief evaluate cdf on a single precision array with a given instruction set.
+		/// Hart's approximation evaluated in float: absolute error below 2e-7, and
+		/// relative error of the tail min(cdf, 1 - cdf) below 5e-6 for |x| <= 12,
+		/// mostly from rounding x^2/2 in float. Beyond, the tail is zero
+		/// @param x points
+		/// @param result output probabilities
+		/// @param isa instruction set
+		void cdf(std::span<const float> x, std::span<float> result, Isa isa)
+		{
+			check_sizes(x, result);
+			isa = std::min(isa, selectedIsa());
+#ifdef STANDARDNORMAL_X86
+			if (isa == Isa::AVX512)
+			{
+				apply_avx512<cdf_avx512>(x.data(), result.data(), x.size());
+				return;
+			}
+			if (isa == Isa::AVX2)
+			{
+				apply_avx2<cdf_avx2>(x.data(), result.data(), x.size());
+				return;
+			}
+#endif
+			cdf_scalar(x.data(), result.data(), x.size());
+		}
+
+		/// @brief evaluate pdf on a single precision array with the best instruction set
+		/// @param x points
+		/// @param result output densities
+		void pdf(std::span<const float> x, std::span<float> result)
+		{
+			pdf(x, result, selectedIsa());
+		}
+
+		/// @brief evaluate pdf on a single precision array with a given instruction set,
+		/// relative error below 5e-6 for |x| <= 12 and zero beyond
+		/// @param x points
+		/// @param result output densities
+		/// @param isa instruction set
+		void pdf(std::span<const float> x, std::span<float> result, Isa isa)
+		{
+			check_sizes(x, result);
+			isa = std::min(isa, selectedIsa());
+#ifdef STANDARDNORMAL_X86
+			if (isa == Isa::AVX512)
+			{
+				apply_avx512<pdf_avx512>(x.data(), result.data(), x.size());
+				return;
+			}
+			if (isa == Isa::AVX2)
+			{
+				apply_avx2<pdf_avx2>(x.data(), result.data(), x.size());
+				return;
+			}
+#endif
+			pdf_scalar(x.data(), result.data(), x.size());
+		}
+	}
+}
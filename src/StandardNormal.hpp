@@ -0,0 +1,90 @@
+// Standard normal cumulative distribution and density functions.
+// Scalar functions are inline so they can be used inside pricing loops,
+// batch functions evaluate whole arrays of doubles or floats with scalar, AVX2
+// or AVX-512 kernels chosen at runtime from the CPU features.
+
+#ifndef STANDARDNORMAL_HPP
+#define STANDARDNORMAL_HPP
+
+#include <cmath>
+#include <span>
+
+namespace PricingLibrary {
+
+	namespace StandardNormal
+	{
+		// Instruction set used by the batch functions
+		enum class Isa {Scalar=0, AVX2=1, AVX512=2};
+
+		// 1 / sqrt(2 * pi)
+		inline constexpr double inv_sqrt_2pi = 0.398942280401432677940;
+
+		/// @brief standard normal density
+		/// @param x point
+		/// @return density at x
+		inline double pdf(double x)
+		{
+			return inv_sqrt_2pi * std::exp(-x * x / 2);
+		}
+
+		/// @brief standard normal cumulative distribution function.
+		/// Hart's double precision rational approximation (as arranged by West),
+		/// absolute error below 1e-15 on the whole real line
+		/// @param x point
+		/// @return probability that a standard normal variable is below x
+		inline double cdf(double x)
+		{
+			double a = std::abs(x);
+			double tail{};
+			if (a <= 37.0)
+			{
+				double e = std::exp(-a * a / 2);
+				if (a < 7.07106781186547)
+				{
+					double num = 3.52624965998911e-02 * a + 0.700383064443688;
+					num = num * a + 6.37396220353165;
+					num = num * a + 33.912866078383;
+					num = num * a + 112.079291497871;
+					num = num * a + 221.213596169931;
+					num = num * a + 220.206867912376;
+					double den = 8.83883476483184e-02 * a + 1.75566716318264;
+					den = den * a + 16.064177579207;
+					den = den * a + 86.7807322029461;
+					den = den * a + 296.564248779674;
+					den = den * a + 637.333633378831;
+					den = den * a + 793.826512519948;
+					den = den * a + 440.413735824752;
+					tail = e * num / den;
+				}
+				else
+				{
+					// Continued fraction for the Mills ratio
+					double cf = a + 0.65;
+					cf = a + 4 / cf;
+					cf = a + 3 / cf;
+					cf = a + 2 / cf;
+					cf = a + 1 / cf;
+					tail = e / cf / 2.506628274631;
+				}
+			}
+
+			return (x > 0) ? 1 - tail : tail;
+		}
+
+		// Instruction set picked for this CPU
+		Isa selectedIsa();
+		// Evaluate cdf for every element of x
+		void cdf(std::span<const double> x, std::span<double> result);
+		void cdf(std::span<const double> x, std::span<double> result, Isa isa);
+		// Evaluate pdf for every element of x
+		void pdf(std::span<const double> x, std::span<double> result);
+		void pdf(std::span<const double> x, std::span<double> result, Isa isa);
+		// Single precision versions, for batches priced in float
+		void cdf(std::span<const float> x, std::span<float> result);
+		void cdf(std::span<const float> x, std::span<float> result, Isa isa);
+		void pdf(std::span<const float> x, std::span<float> result);
+		void pdf(std::span<const float> x, std::span<float> result, Isa isa);
+	}
+}
+
+#endif
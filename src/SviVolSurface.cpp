@@ -0,0 +1,141 @@
+// Implementation of the header file SviVolSurface.hpp
+
+#include "SviVolSurface.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	/// @brief total variance of the slice
+	/// @param k log forward moneyness
+	/// @return total variance
+	double SviSlice::getTotalVariance(double k) const
+	{
+		const double x = k - m;
+		return a + b * (rho * x + std::sqrt(x * x + sigma * sigma));
+	}
+
+	/// @brief Default constructor, slices are sorted by expiry
+	/// @param slices raw SVI slices of distinct positive expiries
+	SviVolSurface::SviVolSurface(const std::vector<SviSlice>& slices)
+	: _expiries{}, _slices{slices}, _expiryLocator{}
+	{
+		if (_slices.empty())
+		{
+			throw IncorrectInputException("SVI surface needs at least one slice.");
+		}
+		std::sort(_slices.begin(), _slices.end(), [](const SviSlice& x, const SviSlice& y) { return x.T < y.T; });
+
+		for (std::size_t i = 0; i < _slices.size(); i++)
+		{
+			const SviSlice& slice = _slices[i];
+			if (!(slice.T > 0.0) || (i > 0 && !(slice.T > _slices[i - 1].T)))
+			{
+				throw IncorrectInputException("SVI slices must have distinct positive expiries.");
+			}
+			// Minimum total variance a + b sigma sqrt(1 - rho^2) must be positive
+			if (!(slice.b >= 0.0) || !(std::abs(slice.rho) < 1.0) || !(slice.sigma > 0.0) ||
+				!(slice.a + slice.b * slice.sigma * std::sqrt(1 - slice.rho * slice.rho) > 0.0))
+			{
+				throw IncorrectInputException("SVI slice parameters give a negative variance.");
+			}
+			_expiries.push_back(slice.T);
+		}
+		if (_expiries.size() > 1)
+		{
+			_expiryLocator = AxisLocator(_expiries);
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source SviVolSurface object
+	SviVolSurface::SviVolSurface(const SviVolSurface& source)
+	: VolSurface{source}, _expiries{source._expiries}, _slices{source._slices}, _expiryLocator{source._expiryLocator}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source SviVolSurface object
+	/// @return SviVolSurface object
+	SviVolSurface& SviVolSurface::operator= (const SviVolSurface& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		VolSurface::operator=(source);
+		_expiries = source._expiries;
+		_slices = source._slices;
+		_expiryLocator = source._expiryLocator;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	SviVolSurface::~SviVolSurface() {}
+
+	/// @brief volatility at T and k, flat in volatility before the first and
+	/// after the last slice. NaN, from a non-positive S or K, is rejected
+	/// @param T maturity
+	/// @param k log forward moneyness
+	/// @return volatility
+	double SviVolSurface::lookup(double T, double k) const
+	{
+		if (std::isnan(k) || std::isnan(T))
+		{
+			throw IncorrectInputException("Moneyness and maturity of a volatility lookup must be numbers.");
+		}
+		if (T <= _expiries.front())
+		{
+			return std::sqrt(_slices.front().getTotalVariance(k) / _expiries.front());
+		}
+		if (T >= _expiries.back())
+		{
+			return std::sqrt(_slices.back().getTotalVariance(k) / _expiries.back());
+		}
+		const std::size_t earlier{_expiryLocator.locate(T)};
+
+		return interpolateVariance(T, _expiries[earlier], _slices[earlier].getTotalVariance(k),
+								   _expiries[earlier + 1], _slices[earlier + 1].getTotalVariance(k));
+	}
+
+	/// @brief volatility at maturity T and log forward moneyness k
+	/// @param T maturity
+	/// @param k log forward moneyness ln(K / F)
+	/// @return volatility
+	double SviVolSurface::getVolatility(double T, double k) const
+	{
+		return lookup(T, k);
+	}
+
+	/// @brief volatilities of contracts, without a virtual call per contract
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param b cost-of-carry parameters
+	/// @param sigma output volatilities
+	void SviVolSurface::getVolatilities(std::span<const double> S, std::span<const double> K,
+										std::span<const double> T, std::span<const double> b,
+										std::span<double> sigma) const
+	{
+		const std::size_t n{sigma.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || b.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			sigma[i] = lookup(T[i], std::log(K[i] / S[i]) - b[i] * T[i]);
+		}
+	}
+
+	/// @brief slices by increasing expiry
+	/// @return slices
+	const std::vector<SviSlice>& SviVolSurface::getSlices() const
+	{
+		return _slices;
+	}
+}
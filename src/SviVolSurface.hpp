@@ -0,0 +1,61 @@
+// Volatility surface of raw SVI slices (Gatheral 2004). The total variance
+// of the slice of expiry T at log forward moneyness k is
+//     w(k) = a + b (rho (k - m) + sqrt((k - m)^2 + sigma^2))
+// Slices are stored by increasing expiry in one contiguous array, so a
+// lookup is a bucket table search in expiry and one or two slice evaluations.
+
+#ifndef SVIVOLSURFACE_HPP
+#define SVIVOLSURFACE_HPP
+
+#include "VolSurface.hpp"
+
+#include <vector>
+
+namespace PricingLibrary {
+
+	// Raw SVI parameters of one expiry
+	struct SviSlice
+	{
+		double T{};     // expiry
+		double a{};     // level of total variance
+		double b{};     // slope of the wings, b >= 0
+		double rho{};   // skew, |rho| < 1
+		double m{};     // moneyness of the vertex
+		double sigma{}; // curvature at the vertex, sigma > 0
+
+		/// @brief total variance of the slice
+		/// @param k log forward moneyness
+		/// @return total variance
+		double getTotalVariance(double k) const;
+	};
+
+	class SviVolSurface final : public VolSurface
+	{
+	private:
+		std::vector<double> _expiries; // increasing expiries, searched first
+		std::vector<SviSlice> _slices; // slices in the same order
+		AxisLocator _expiryLocator;    // interval of an expiry
+
+		// Volatility without a virtual call, shared by the scalar and batch lookups
+		double lookup(double T, double k) const;
+
+	public:
+		SviVolSurface(const std::vector<SviSlice>& slices); // default constructor
+		SviVolSurface(const SviVolSurface& source); // copy constructor
+		SviVolSurface& operator= (const SviVolSurface& source); // copy assignment
+		~SviVolSurface(); // destructor
+
+		using VolSurface::getVolatility;
+		// Volatility at maturity T and log forward moneyness k
+		double getVolatility(double T, double k) const override;
+		// Volatilities of contracts stored as contiguous columns
+		void getVolatilities(std::span<const double> S, std::span<const double> K,
+							 std::span<const double> T, std::span<const double> b,
+							 std::span<double> sigma) const override;
+
+		// Slices by increasing expiry
+		const std::vector<SviSlice>& getSlices() const;
+	};
+}
+
+#endif
@@ -0,0 +1,161 @@
+// Implementation of the header file SweepExecutor.hpp
+
+#include "SweepExecutor.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PricingLibrary {
+
+	/// @brief Default constructor
+	/// @param threads number of threads, 0 uses all hardware threads
+	/// @param chunkSize number of indices processed per work item
+	SweepExecutor::SweepExecutor(std::size_t threads, std::size_t chunkSize)
+	: _threads{threads}, _chunkSize{std::max<std::size_t>(chunkSize, 1)}, _run{0}, _cancelled{0}
+	{
+		if (_threads == 0)
+		{
+			_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+	}
+
+	/// @brief Copy constructor, copies the configuration only
+	/// @param source SweepExecutor object
+	SweepExecutor::SweepExecutor(const SweepExecutor& source)
+	: _threads{source._threads}, _chunkSize{source._chunkSize}, _run{0}, _cancelled{0}
+	{}
+
+	/// @brief Copy assignment, copies the configuration only
+	/// @param source SweepExecutor object
+	/// @return SweepExecutor object
+	SweepExecutor& SweepExecutor::operator= (const SweepExecutor& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_threads = source._threads;
+		_chunkSize = source._chunkSize;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	SweepExecutor::~SweepExecutor() {}
+
+	/// @brief return number of threads
+	/// @return threads
+	std::size_t SweepExecutor::getThreadCount() const
+	{
+		return _threads;
+	}
+
+	/// @brief return chunk size
+	/// @return chunk size
+	std::size_t SweepExecutor::getChunkSize() const
+	{
+		return _chunkSize;
+	}
+
+	/// @brief run task over [0, n). Chunks are taken from a shared counter,
+	/// the calling thread takes part in the work. The first exception thrown
+	/// by the task stops the sweep and is rethrown after all threads finish,
+	/// as is a failure to start a thread once the threads already started
+	/// have been joined
+	/// @param n number of indices
+	/// @param task function processing [begin, end)
+	/// @return false if the sweep was cancelled before all indices were processed
+	bool SweepExecutor::run(std::size_t n, const Task& task)
+	{
+		// The sweep stops when cancel() marks its token or the task throws
+		const std::uint64_t token{_run.fetch_add(1, std::memory_order_acq_rel) + 1};
+		std::atomic<bool> stopped{false};
+		std::atomic<std::size_t> next{0};
+		std::atomic<std::size_t> done{0};
+		std::exception_ptr error;
+		std::mutex errorMutex;
+
+		auto worker = [&]()
+		{
+			while (!stopped.load(std::memory_order_relaxed) && _cancelled.load(std::memory_order_relaxed) != token)
+			{
+				const std::size_t begin = next.fetch_add(_chunkSize, std::memory_order_relaxed);
+				if (begin >= n)
+				{
+					return;
+				}
+				const std::size_t end = std::min(begin + _chunkSize, n);
+				try
+				{
+					task(begin, end);
+					done.fetch_add(end - begin, std::memory_order_relaxed);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!error)
+					{
+						error = std::current_exception();
+					}
+					stopped = true;
+				}
+			}
+		};
+
+		// No more threads than chunks, the calling thread is one of them
+		const std::size_t threads = std::min(_threads, (n + _chunkSize - 1) / _chunkSize);
+		std::vector<std::thread> pool;
+		pool.reserve(threads);
+		try
+		{
+			for (std::size_t i = 1; i < threads; i++)
+			{
+				pool.emplace_back(worker);
+			}
+		}
+		catch (...)
+		{
+			// Joinable threads must not be destroyed
+			stopped = true;
+			for (auto& thread : pool)
+			{
+				thread.join();
+			}
+			throw;
+		}
+		worker();
+		for (auto& thread : pool)
+		{
+			thread.join();
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+
+		return done.load() == n;
+	}
+
+	/// @brief stop the running sweep, chunks already started are completed.
+	/// The token of the latest sweep is marked, so a cancellation between
+	/// sweeps does not stop the next one
+	void SweepExecutor::cancel()
+	{
+		_cancelled = _run.load(std::memory_order_acquire);
+	}
+
+	/// @brief if cancellation of the running or last sweep was requested,
+	/// also when it came after the last chunk had started
+	/// @return boolean
+	bool SweepExecutor::isCancelled() const
+	{
+		const std::uint64_t run{_run.load(std::memory_order_acquire)};
+		return run != 0 && _cancelled.load() == run;
+	}
+}
@@ -0,0 +1,47 @@
+// Executor to run a sweep over an index range on several threads.
+// The range is split in chunks of fixed size which threads take in turn,
+// so every index is processed exactly once and writes to a preallocated
+// output keep the serial order. A running sweep can be cancelled; each
+// sweep has its own token, so a cancellation never carries over to the next.
+
+#ifndef SWEEPEXECUTOR_HPP
+#define SWEEPEXECUTOR_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace PricingLibrary {
+
+	class SweepExecutor
+	{
+	private:
+		std::size_t _threads;    // number of threads, including the calling one
+		std::size_t _chunkSize;  // number of indices processed per work item
+		std::atomic<std::uint64_t> _run;       // token of the latest sweep, 0 before the first
+		std::atomic<std::uint64_t> _cancelled; // token of the latest cancelled sweep
+
+	public:
+		// Task processes the indices [begin, end)
+		using Task = std::function<void(std::size_t begin, std::size_t end)>;
+
+		// thread count 0 uses all hardware threads
+		explicit SweepExecutor(std::size_t threads=0, std::size_t chunkSize=1024); // default constructor
+		SweepExecutor(const SweepExecutor& source); // copy constructor
+		SweepExecutor& operator= (const SweepExecutor& source); // copy assignment
+		~SweepExecutor(); // destructor
+
+		std::size_t getThreadCount() const; // get number of threads
+		std::size_t getChunkSize() const; // get chunk size
+
+		// Run task over [0, n), returns false if the sweep was cancelled
+		bool run(std::size_t n, const Task& task);
+		// Stop the running sweep, no effect if none is running
+		void cancel();
+		// If the running or last sweep was cancelled
+		bool isCancelled() const;
+	};
+}
+
+#endif
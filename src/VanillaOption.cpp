@@ -14,7 +14,7 @@ namespace PricingLibrary {
 	/// @param engine pricing engine object
 	VanillaOption::VanillaOption(const std::shared_ptr<Payoff>& payoff,
 								 const std::shared_ptr<PricingEngine>& engine) :
-								Option{payoff}, _engine{engine} {}
+								Option{payoff}, _engine{engine}, _cache{} {}
 
 	/// @brief Copy constructor
 	/// @param source VanillaOption object
@@ -25,6 +25,7 @@ namespace PricingLibrary {
 		{
 			_engine = source._engine;
 		}
+		_cache = source._cache;
 	}
 
 	/// @brief Copy assignemnt
@@ -40,6 +41,7 @@ namespace PricingLibrary {
 		
 		_payoff = source._payoff;
 		_engine = source._engine;
+		_cache = source._cache;
 
 		return *this;
 	}
@@ -54,10 +56,21 @@ namespace PricingLibrary {
 		_engine = engine;
 	}
 
+	/// @brief set result cache, may be shared by many options and threads
+	/// @param cache PriceCache object, nullptr to price every call with the engine
+	void VanillaOption::setCache(const std::shared_ptr<PriceCache>& cache)
+	{
+		_cache = cache;
+	}
+
 	/// @brief option price
 	/// @return price
 	double VanillaOption::getPrice() const
 	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Price).price;
+		}
 		return _engine->getEnginePrice(_payoff);
 	}
 
@@ -65,6 +78,10 @@ namespace PricingLibrary {
 	/// @return delta
 	double VanillaOption::getDelta() const
 	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Delta).delta;
+		}
 		return _engine->getEngineDelta(_payoff);
 	}
 
@@ -72,6 +89,10 @@ namespace PricingLibrary {
 	/// @return gamma
 	double VanillaOption::getGamma() const
 	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Gamma).gamma;
+		}
 		return _engine->getEngineGamma(_payoff);
 	}
 
@@ -79,6 +100,10 @@ namespace PricingLibrary {
 	/// @return vega
 	double VanillaOption::getVega() const
 	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Vega).vega;
+		}
 		return _engine->getEngineVega(_payoff);
 	}
 
@@ -86,6 +111,33 @@ namespace PricingLibrary {
 	/// @return theta
 	double VanillaOption::getTheta() const
 	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Theta).theta;
+		}
 		return _engine->getEngineTheta(_payoff);
 	}
+
+	/// @brief option rho greek
+	/// @return rho
+	double VanillaOption::getRho() const
+	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, Greeks::Rho).rho;
+		}
+		return _engine->getEngineRho(_payoff);
+	}
+
+	/// @brief option price and greeks computed together
+	/// @param mask combination of Greeks::Mask flags
+	/// @return Greeks
+	Greeks VanillaOption::getAll(unsigned mask) const
+	{
+		if (_cache)
+		{
+			return _cache->getAll(*_engine, _payoff, mask);
+		}
+		return _engine->getEngineAll(_payoff, mask);
+	}
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 // Has pricing engine and payoff as member variables
 // pricing engine is used to return option price and greeks
 // payoff includes data such as maturity, strike, option type and exercise
+// an optional PriceCache shared by many options memoizes the results
 
 #ifndef VANILLAOPTION_HPP
 #define VANILLAOPTION_HPP
@@ -10,6 +11,7 @@
 #include "Payoff.hpp"
 #include "PricingEngine.hpp"
 #include "AnalyticEuropeanEngine.hpp"
+#include "PriceCache.hpp"
 
 #include <memory>
 
@@ -19,6 +21,7 @@ namespace PricingLibrary {
 	{
 	private:
 		std::shared_ptr<PricingEngine> _engine; // pricing engine
+		std::shared_ptr<PriceCache> _cache; // results of previous calls, if any
 
 	public:
 		explicit VanillaOption(const std::shared_ptr<Payoff>& payoff); // default constructor
@@ -30,6 +33,8 @@ namespace PricingLibrary {
 
 		// Set pricing engine
 		void setEngine(const std::shared_ptr<PricingEngine>& engine);
+		// Set result cache, nullptr prices every call with the engine
+		void setCache(const std::shared_ptr<PriceCache>& cache);
 
 		// Option price
 		double getPrice() const override;
@@ -38,6 +43,9 @@ namespace PricingLibrary {
 		double getGamma() const;
 		double getVega() const;
 		double getTheta() const;
+		double getRho() const;
+		// Price and Greeks selected by mask in one call
+		Greeks getAll(unsigned mask=Greeks::All) const;
 	};
 }
 
@@ -0,0 +1,58 @@
+// Implementation of the header file VolSurface.hpp
+
+#include "VolSurface.hpp"
+
+#include <cmath>
+
+namespace PricingLibrary {
+
+	/// @brief destructor
+	VolSurface::~VolSurface() {}
+
+	/// @brief volatility between two expiries, linear in total variance
+	/// @param T maturity
+	/// @param T0 earlier expiry
+	/// @param w0 total variance at T0
+	/// @param T1 later expiry
+	/// @param w1 total variance at T1
+	/// @return volatility
+	double VolSurface::interpolateVariance(double T, double T0, double w0, double T1, double w1)
+	{
+		const double w = w0 + (w1 - w0) * (T - T0) / (T1 - T0);
+		return std::sqrt(w / T);
+	}
+
+	/// @brief volatility of a contract
+	/// @param S underlying price
+	/// @param K strike price
+	/// @param T maturity
+	/// @param b cost-of-carry parameter
+	/// @return volatility
+	double VolSurface::getVolatility(double S, double K, double T, double b) const
+	{
+		return getVolatility(T, std::log(K / S) - b * T);
+	}
+
+	/// @brief volatilities of contracts, one virtual call per contract. Surfaces
+	/// override it with a loop over their own lookup
+	/// @param S underlying prices
+	/// @param K strike prices
+	/// @param T maturities
+	/// @param b cost-of-carry parameters
+	/// @param sigma output volatilities
+	void VolSurface::getVolatilities(std::span<const double> S, std::span<const double> K,
+									 std::span<const double> T, std::span<const double> b,
+									 std::span<double> sigma) const
+	{
+		const std::size_t n{sigma.size()};
+		if (S.size() != n || K.size() != n || T.size() != n || b.size() != n)
+		{
+			throw IncorrectInputException("All batch columns must have the same length.");
+		}
+
+		for (std::size_t i = 0; i < n; i++)
+		{
+			sigma[i] = getVolatility(T[i], std::log(K[i] / S[i]) - b[i] * T[i]);
+		}
+	}
+}
@@ -0,0 +1,42 @@
+// Abstract volatility surface. A surface gives the implied volatility of a
+// maturity T and a log forward moneyness k = ln(K / F), F = S exp(bT), so
+// one surface serves a whole option chain with a smile: GridVolSurface
+// interpolates quoted volatilities, SviVolSurface evaluates SVI slices.
+// Between expiries both interpolate linearly in total variance sigma^2 T.
+// AnalyticEuropeanEngine, BaroneAdesiWhaleyEngine and BjerksundStenslandEngine
+// and their batch paths take a surface in place of a scalar volatility.
+
+#ifndef VOLSURFACE_HPP
+#define VOLSURFACE_HPP
+
+#include "AxisLocator.hpp"
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class VolSurface
+	{
+	protected:
+		// Volatility at T from total variances w0 at T0 and w1 at T1, T0 < T < T1
+		static double interpolateVariance(double T, double T0, double w0, double T1, double w1);
+
+	public:
+		VolSurface() =default; // default constructor
+		virtual ~VolSurface(); // destructor
+
+		// Volatility at maturity T and log forward moneyness k
+		virtual double getVolatility(double T, double k) const =0;
+		// Volatility of a contract, k = ln(K / S) - bT
+		double getVolatility(double S, double K, double T, double b) const;
+		// Volatilities of contracts stored as contiguous columns
+		virtual void getVolatilities(std::span<const double> S, std::span<const double> K,
+									 std::span<const double> T, std::span<const double> b,
+									 std::span<double> sigma) const;
+	};
+}
+
+#endif
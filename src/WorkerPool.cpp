@@ -0,0 +1,170 @@
+// Implementation of the header file WorkerPool.hpp
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace PricingLibrary {
+
+	namespace
+	{
+		// Yields of an idle thread before it sleeps on a condition variable
+		constexpr std::size_t spin_count{2048};
+	}
+
+	/// @brief Default constructor, starts the threads
+	/// @param threads number of threads including the calling one, 0 uses all hardware threads
+	WorkerPool::WorkerPool(std::size_t threads)
+	: _threads{threads}, _workers{}, _runMutex{}, _mutex{}, _posted{}, _finished{}, _run{0}, _pending{0},
+	  _task{nullptr}, _n{0}, _parts{0}, _error{}, _stop{false}
+	{
+		if (_threads == 0)
+		{
+			_threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		_workers.reserve(_threads - 1);
+		try
+		{
+			for (std::size_t i = 1; i < _threads; i++)
+			{
+				_workers.emplace_back(&WorkerPool::work, this, i);
+			}
+		}
+		catch (...)
+		{
+			// Joinable threads must not be destroyed
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_stop = true;
+			}
+			_posted.notify_all();
+			for (auto& worker : _workers)
+			{
+				worker.join();
+			}
+			throw;
+		}
+	}
+
+	/// @brief Destructor, stops and joins the threads
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_stop = true;
+		}
+		_posted.notify_all();
+		for (auto& worker : _workers)
+		{
+			worker.join();
+		}
+	}
+
+	/// @brief return number of threads
+	/// @return threads
+	std::size_t WorkerPool::getThreadCount() const
+	{
+		return _threads;
+	}
+
+	/// @brief process one range of the current run, keeping its first exception
+	/// @param index range index, from 0 to the number of threads
+	void WorkerPool::process(std::size_t index)
+	{
+		if (index >= _parts)
+		{
+			return;
+		}
+
+		const std::size_t begin{_n * index / _parts};
+		const std::size_t end{_n * (index + 1) / _parts};
+		try
+		{
+			(*_task)(begin, end);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_error)
+			{
+				_error = std::current_exception();
+			}
+		}
+	}
+
+	/// @brief loop of a worker thread: wait for a run, process its range and
+	/// report it done, until the destructor is called
+	/// @param index range index of the thread in each run
+	void WorkerPool::work(std::size_t index)
+	{
+		std::uint64_t seen{0};
+		while (true)
+		{
+			for (std::size_t spin = 0; spin < spin_count && _run.load(std::memory_order_acquire) == seen; spin++)
+			{
+				std::this_thread::yield();
+			}
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_posted.wait(lock, [&]() { return _stop || _run.load(std::memory_order_relaxed) != seen; });
+				if (_stop)
+				{
+					return;
+				}
+				seen = _run.load(std::memory_order_relaxed);
+			}
+
+			process(index);
+			if (_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				std::lock_guard<std::mutex> lock(_mutex);
+				_finished.notify_one();
+			}
+		}
+	}
+
+	/// @brief run task over [0, n). The range is split in one contiguous range
+	/// per thread, fewer if a range would be shorter than minRange; the calling
+	/// thread processes the first one
+	/// @param n number of indices
+	/// @param task function processing [begin, end)
+	/// @param minRange fewest indices per range
+	void WorkerPool::run(std::size_t n, const Task& task, std::size_t minRange)
+	{
+		const std::size_t parts{std::clamp<std::size_t>(n / std::max<std::size_t>(minRange, 1), 1, _threads)};
+		if (parts == 1)
+		{
+			if (n > 0)
+			{
+				task(0, n);
+			}
+			return;
+		}
+
+		std::lock_guard<std::mutex> running(_runMutex);
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_task = &task;
+			_n = n;
+			_parts = parts;
+			_error = nullptr;
+			_pending.store(_workers.size(), std::memory_order_relaxed);
+			_run.fetch_add(1, std::memory_order_release);
+		}
+		_posted.notify_all();
+
+		process(0);
+		for (std::size_t spin = 0; spin < spin_count && _pending.load(std::memory_order_acquire) != 0; spin++)
+		{
+			std::this_thread::yield();
+		}
+		std::unique_lock<std::mutex> lock(_mutex);
+		_finished.wait(lock, [&]() { return _pending.load(std::memory_order_acquire) == 0; });
+
+		if (_error)
+		{
+			std::rethrow_exception(_error);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+// Pool of threads started once and reused by every run. run splits an index
+// range in one contiguous range per thread and returns when all of them are
+// processed, so a caller that sweeps the same data many times, such as a
+// LiveBook repricing on each tick, does not start and join threads per sweep.
+// Idle threads spin briefly before they sleep, so runs that follow each other
+// closely do not wait for a wake-up.
+
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class WorkerPool
+	{
+	public:
+		// Task processes the indices [begin, end)
+		using Task = std::function<void(std::size_t begin, std::size_t end)>;
+
+	private:
+		std::size_t _threads;                 // number of threads, including the calling one
+		std::vector<std::thread> _workers;    // threads other than the calling one
+		std::mutex _runMutex;                 // one run at a time
+		std::mutex _mutex;                    // guards the run posted to the workers
+		std::condition_variable _posted;      // signals a new run or stop
+		std::condition_variable _finished;    // signals that all workers are done
+		std::atomic<std::uint64_t> _run;      // number of runs posted
+		std::atomic<std::size_t> _pending;    // workers still busy with the current run
+		const Task* _task;                    // task of the current run
+		std::size_t _n;                       // number of indices of the current run
+		std::size_t _parts;                   // number of ranges of the current run
+		std::exception_ptr _error;            // first exception of the current run
+		bool _stop;                           // destructor was called
+
+		// Loop of worker thread index, processes range index of each run
+		void work(std::size_t index);
+		// Process range index of the current run
+		void process(std::size_t index);
+
+	public:
+		explicit WorkerPool(std::size_t threads=0); // default constructor, 0 uses all hardware threads
+		~WorkerPool(); // destructor, stops and joins the threads
+
+		std::size_t getThreadCount() const; // get number of threads
+
+		// Run task over [0, n) in ranges of at least minRange indices,
+		// rethrows the first exception of the task
+		void run(std::size_t n, const Task& task, std::size_t minRange=1);
+	};
+}
+
+#endif
@@ -0,0 +1,122 @@
+// Implementation of the header file YieldCurve.hpp
+
+#include "YieldCurve.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PricingLibrary {
+
+	/// @brief Constructor of a flat curve
+	/// @param rate zero rate of every maturity
+	YieldCurve::YieldCurve(double rate)
+	: YieldCurve(std::vector<double>{1.0}, std::vector<double>{rate}) {}
+
+	/// @brief Default constructor
+	/// @param times increasing positive node times
+	/// @param rates continuously compounded zero rate of each node
+	/// @param interpolation LinearZeroRate or LogLinearDiscount
+	YieldCurve::YieldCurve(const std::vector<double>& times, const std::vector<double>& rates,
+						   Interpolation interpolation)
+	: _times{times}, _rates{rates}, _logDiscount{}, _interpolation{interpolation}
+	{
+		if (_times.empty() || _times.size() != _rates.size())
+		{
+			throw IncorrectInputException("Yield curve needs one zero rate per node.");
+		}
+		for (std::size_t i = 0; i < _times.size(); i++)
+		{
+			if (!(_times[i] > 0.0) || (i > 0 && !(_times[i] > _times[i - 1])))
+			{
+				throw IncorrectInputException("Node times of a yield curve must be positive and increasing.");
+			}
+			_logDiscount.push_back(-_rates[i] * _times[i]);
+		}
+	}
+
+	/// @brief Copy constructor
+	/// @param source YieldCurve object
+	YieldCurve::YieldCurve(const YieldCurve& source)
+	: _times{source._times}, _rates{source._rates}, _logDiscount{source._logDiscount},
+	  _interpolation{source._interpolation}
+	{}
+
+	/// @brief Copy assignment
+	/// @param source YieldCurve object
+	/// @return YieldCurve object
+	YieldCurve& YieldCurve::operator= (const YieldCurve& source)
+	{
+		// check for self-assignment
+		if (this == &source)
+		{
+			return *this;
+		}
+
+		_times = source._times;
+		_rates = source._rates;
+		_logDiscount = source._logDiscount;
+		_interpolation = source._interpolation;
+
+		return *this;
+	}
+
+	/// @brief Destructor
+	YieldCurve::~YieldCurve() {}
+
+	/// @brief continuously compounded zero rate to time T
+	/// @param T time, positive
+	/// @return zero rate
+	double YieldCurve::getZeroRate(double T) const
+	{
+		if (T <= _times.front() || _times.size() == 1)
+		{
+			return _rates.front();
+		}
+		if (_interpolation == LinearZeroRate && T >= _times.back())
+		{
+			return _rates.back();
+		}
+
+		// Interval of T, the last one beyond the last node
+		const std::size_t i = std::min<std::size_t>(
+			std::upper_bound(_times.begin(), _times.end(), T) - _times.begin(), _times.size() - 1) - 1;
+		const double weight = (T - _times[i]) / (_times[i + 1] - _times[i]);
+
+		if (_interpolation == LinearZeroRate)
+		{
+			return _rates[i] + weight * (_rates[i + 1] - _rates[i]);
+		}
+		// Linear in -r T, extended with the forward rate of the last interval
+		const double logDiscount = _logDiscount[i] + weight * (_logDiscount[i + 1] - _logDiscount[i]);
+		return -logDiscount / T;
+	}
+
+	/// @brief discount factor to time T
+	/// @param T time, positive
+	/// @return exp(-r(T) T)
+	double YieldCurve::getDiscountFactor(double T) const
+	{
+		return std::exp(-getZeroRate(T) * T);
+	}
+
+	/// @brief node times
+	/// @return times
+	const std::vector<double>& YieldCurve::getTimes() const
+	{
+		return _times;
+	}
+
+	/// @brief zero rate of each node
+	/// @return rates
+	const std::vector<double>& YieldCurve::getRates() const
+	{
+		return _rates;
+	}
+
+	/// @brief interpolation between nodes
+	/// @return interpolation
+	YieldCurve::Interpolation YieldCurve::getInterpolation() const
+	{
+		return _interpolation;
+	}
+}
@@ -0,0 +1,52 @@
+// Term structure of continuously compounded zero rates r(T), with the
+// discount factor DF(T) = exp(-r(T) T). Between nodes the curve interpolates
+// linearly either in zero rates or in log discount factors, the latter
+// giving piecewise flat forward rates. Before the first node the zero rate is
+// flat; after the last node the zero rate is flat, or the last forward rate
+// is, in log discount factor interpolation. A dividend yield or any other
+// carry deduction q(T) is a YieldCurve as well, with cost of carry
+// b(T) = r(T) - q(T).
+
+#ifndef YIELDCURVE_HPP
+#define YIELDCURVE_HPP
+
+#include "IncorrectInputException.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace PricingLibrary {
+
+	class YieldCurve
+	{
+	public:
+		// Interpolation between nodes
+		enum Interpolation {LinearZeroRate=1, LogLinearDiscount=2};
+
+	private:
+		std::vector<double> _times;    // increasing positive node times
+		std::vector<double> _rates;    // zero rate of each node
+		std::vector<double> _logDiscount; // -r T of each node
+		Interpolation _interpolation;  // interpolation between nodes
+
+	public:
+		explicit YieldCurve(double rate); // flat curve
+		YieldCurve(const std::vector<double>& times, const std::vector<double>& rates,
+				   Interpolation interpolation=LinearZeroRate); // default constructor
+		YieldCurve(const YieldCurve& source); // copy constructor
+		YieldCurve& operator= (const YieldCurve& source); // copy assignment
+		~YieldCurve(); // destructor
+
+		// Continuously compounded zero rate to time T
+		double getZeroRate(double T) const;
+		// Discount factor to time T
+		double getDiscountFactor(double T) const;
+
+		// Node times and zero rates
+		const std::vector<double>& getTimes() const;
+		const std::vector<double>& getRates() const;
+		Interpolation getInterpolation() const;
+	};
+}
+
+#endif
@@ -0,0 +1,110 @@
+// Test of LiveBook repricing on its worker pool: a book split over several
+// threads must give the prices of a book on one thread at every tick, also
+// for a copy of the book, and a WorkerPool must pass an exception of its
+// task to the caller and stay usable.
+// Exits with 1 if a check fails
+
+#include "LiveBook.hpp"
+#include "WorkerPool.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace PricingLibrary;
+
+namespace
+{
+	/// @brief compare the prices of two books on one underlying
+	/// @param name case
+	/// @param book book to check
+	/// @param expected book on one thread
+	/// @param underlying index of the underlying in both books
+	/// @return true if all prices are equal
+	bool check(const std::string& name, const LiveBook& book, const LiveBook& expected, std::size_t underlying)
+	{
+		const auto prices = book.getPrices(underlying);
+		const auto expectedPrices = expected.getPrices(underlying);
+		std::size_t different{0};
+		for (std::size_t i = 0; i < prices.size(); i++)
+		{
+			different += (prices[i] != expectedPrices[i]) ? 1 : 0;
+		}
+
+		const bool passed = prices.size() == expectedPrices.size() && different == 0;
+		std::cout << (passed ? "ok   " : "FAIL ") << name << ": " << different << " of " << prices.size()
+				  << " prices differ\n";
+		return passed;
+	}
+}
+
+int main()
+{
+	// Enough contracts for four ranges of the pool
+	LiveBook threaded(4);
+	LiveBook single(1);
+	const std::size_t underlying{threaded.addUnderlying(100.0)};
+	single.addUnderlying(100.0);
+	for (std::size_t i = 0; i < 40000; i++)
+	{
+		const double K{50.0 + (i % 200)};
+		const double T{0.05 + (i % 37) * 0.1};
+		const double sigma{0.1 + (i % 11) * 0.05};
+		const Payoff::Type type{(i % 2 == 0) ? Payoff::Call : Payoff::Put};
+		threaded.addContract(underlying, K, T, sigma, 0.03, 0.01, type);
+		single.addContract(underlying, K, T, sigma, 0.03, 0.01, type);
+	}
+
+	bool passed{true};
+	for (std::size_t tick = 0; tick < 200; tick++)
+	{
+		const double S{95.0 + 0.05 * tick};
+		threaded.updateSpot(underlying, S);
+		single.updateSpot(underlying, S);
+	}
+	passed = check("pool after 200 ticks", threaded, single, underlying) && passed;
+
+	LiveBook copy(threaded);
+	copy.updateSpot(underlying, 103.0);
+	threaded.updateSpot(underlying, 103.0);
+	single.updateSpot(underlying, 103.0);
+	passed = check("copy of a book on the pool", copy, single, underlying) && passed;
+	passed = check("book after its copy", threaded, single, underlying) && passed;
+
+	// An exception of the task reaches the caller and the pool keeps working
+	WorkerPool pool(4);
+	bool threw{false};
+	try
+	{
+		pool.run(1000, [](std::size_t begin, std::size_t)
+		{
+			if (begin > 0)
+			{
+				throw std::runtime_error("range failed");
+			}
+		});
+	}
+	catch (const std::runtime_error&)
+	{
+		threw = true;
+	}
+	std::vector<int> visited(1000, 0);
+	pool.run(visited.size(), [&visited](std::size_t begin, std::size_t end)
+	{
+		for (std::size_t i = begin; i < end; i++)
+		{
+			visited[i]++;
+		}
+	});
+	bool once{true};
+	for (int count : visited)
+	{
+		once = once && count == 1;
+	}
+	const bool recovered = threw && once;
+	std::cout << (recovered ? "ok   " : "FAIL ") << "exception of the task is rethrown, next run covers every index once\n";
+
+	return (passed && recovered) ? 0 : 1;
+}
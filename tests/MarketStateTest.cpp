@@ -0,0 +1,90 @@
+// Test of MarketState under a concurrent reader: a thread reads the quote of
+// an underlying while the market is assigned, in turn, from market states of
+// two capacities. Every snapshot must be one of the quotes written, the
+// capacity must stay that of construction, and a source with more
+// underlyings than fit must throw.
+// Exits with 1 if a check fails
+
+#include "MarketState.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+
+using namespace PricingLibrary;
+
+namespace
+{
+	/// @brief if two quotes hold the same values
+	bool equal(const MarketQuote& a, const MarketQuote& b)
+	{
+		return a.S == b.S && a.sigma == b.sigma && a.r == b.r && a.b == b.b;
+	}
+}
+
+int main()
+{
+	const MarketQuote first{100.0, 0.2, 0.05, 0.05};
+	const MarketQuote second{150.0, 0.3, 0.04, 0.02};
+
+	MarketState market(8);
+	market.addUnderlying(first);
+	MarketState large(8);
+	MarketState small(4);
+	for (std::size_t i = 0; i < 6; i++)
+	{
+		large.addUnderlying(first);
+	}
+	for (std::size_t i = 0; i < 4; i++)
+	{
+		small.addUnderlying(second);
+	}
+
+	// Reader of underlying 0, which every assignment keeps
+	std::atomic<bool> stop{false};
+	std::atomic<std::size_t> torn{0};
+	std::atomic<std::size_t> reads{0};
+	std::thread reader([&]()
+	{
+		while (!stop.load(std::memory_order_relaxed))
+		{
+			const MarketQuote quote = market.getQuote(0);
+			if (!equal(quote, first) && !equal(quote, second))
+			{
+				torn.fetch_add(1, std::memory_order_relaxed);
+			}
+			reads.fetch_add(1, std::memory_order_relaxed);
+		}
+	});
+
+	for (std::size_t i = 0; i < 20000; i++)
+	{
+		market = (i % 2 == 0) ? large : small;
+	}
+	stop = true;
+	reader.join();
+
+	bool passed = torn.load() == 0 && market.getCapacity() == 8;
+	std::cout << (passed ? "ok   " : "FAIL ") << "concurrent reader: " << reads.load() << " reads, "
+			  << torn.load() << " inconsistent, capacity " << market.getCapacity() << "\n";
+
+	// A source with more underlyings than the capacity
+	bool threw{false};
+	try
+	{
+		small = large;
+	}
+	catch (const IncorrectInputException&)
+	{
+		threw = true;
+	}
+	catch (...)
+	{
+	}
+	const bool kept = threw && small.getCapacity() == 4 && small.getUnderlyingCount() == 4 &&
+					  equal(small.getQuote(0), second);
+	std::cout << (kept ? "ok   " : "FAIL ") << "assignment beyond capacity throws and keeps the quotes\n";
+
+	return (passed && kept) ? 0 : 1;
+}
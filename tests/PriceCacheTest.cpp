@@ -0,0 +1,79 @@
+// Test of PriceCache results on engines that read a MarketState: a cached
+// price must not be returned once the quote it was computed from has been
+// replaced, also when the replacement comes from assigning another
+// MarketState or from adding an underlying again.
+// Exits with 1 if a cached price differs from the engine price
+
+#include "AnalyticEuropeanEngine.hpp"
+#include "MarketState.hpp"
+#include "Payoff.hpp"
+#include "PriceCache.hpp"
+#include "VanillaOption.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace PricingLibrary;
+
+namespace
+{
+	/// @brief compare the price of an option through its cache with the engine price
+	/// @param name case
+	/// @param option option priced through the cache
+	/// @param engine engine of the option
+	/// @param payoff payoff of the option
+	/// @return true if both prices agree
+	bool check(const std::string& name, const VanillaOption& option, const PricingEngine& engine,
+			   const std::shared_ptr<Payoff>& payoff)
+	{
+		const double cached{option.getPrice()};
+		const double expected{engine.getEnginePrice(payoff)};
+		const bool passed = std::abs(cached - expected) <= 1e-12;
+		std::cout << (passed ? "ok   " : "FAIL ") << name << ": cached " << cached << ", engine " << expected << "\n";
+		return passed;
+	}
+}
+
+int main()
+{
+	const auto payoff = std::make_shared<Payoff>(1.0, 100.0, Payoff::Call, Payoff::European);
+	const auto cache = std::make_shared<PriceCache>(1024);
+	bool passed{true};
+
+	// Assigning a market state of another capacity copies into the existing slots
+	{
+		auto market = std::make_shared<MarketState>();
+		const std::size_t underlying = market->addUnderlying({100.0, 0.2, 0.05, 0.05});
+		market->setSpot(underlying, 100.0);
+		const auto engine = std::make_shared<AnalyticEuropeanEngine>(market, underlying);
+		VanillaOption option(payoff, engine);
+		option.setCache(cache);
+		passed = check("before assignment", option, *engine, payoff) && passed;
+
+		MarketState other(16);
+		other.addUnderlying({150.0, 0.2, 0.05, 0.05});
+		*market = other;
+		passed = check("assignment of another capacity", option, *engine, payoff) && passed;
+	}
+
+	// An underlying dropped by an assignment and added again
+	{
+		auto market = std::make_shared<MarketState>(4);
+		market->addUnderlying({100.0, 0.2, 0.05, 0.05});
+		const std::size_t underlying = market->addUnderlying({100.0, 0.2, 0.05, 0.05});
+		const auto engine = std::make_shared<AnalyticEuropeanEngine>(market, underlying);
+		VanillaOption option(payoff, engine);
+		option.setCache(cache);
+		passed = check("before adding again", option, *engine, payoff) && passed;
+
+		MarketState other(4);
+		other.addUnderlying({100.0, 0.2, 0.05, 0.05});
+		*market = other;
+		market->addUnderlying({120.0, 0.2, 0.05, 0.05});
+		passed = check("underlying added again", option, *engine, payoff) && passed;
+	}
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+// Test of ScenarioEngine P&L: the scenario without a spot or volatility shock
+// must have a P&L of exactly 0 for every position, and a shocked cell must
+// agree with the difference of two AnalyticEuropeanEngine prices.
+// Exits with 1 if a check fails
+
+#include "ScenarioEngine.hpp"
+#include "AnalyticEuropeanEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace PricingLibrary;
+
+int main()
+{
+	Portfolio portfolio;
+	std::vector<MarketQuote> quotes;
+	for (std::size_t u = 0; u < 4; u++)
+	{
+		quotes.push_back({80.0 + 17.3 * u, 0.12 + 0.07 * u, 0.01 + 0.013 * u, 0.005 * u});
+	}
+	for (std::size_t i = 0; i < 400; i++)
+	{
+		const Contract contract{40.0 + 0.37 * i, 0.02 + 0.0131 * i, (i % 2 == 0) ? Payoff::Call : Payoff::Put,
+								Payoff::European};
+		portfolio.addPosition(contract, 1.0 + (i % 5), i % quotes.size());
+	}
+
+	const std::vector<double> spotShocks{ScenarioEngine::makeLadder(0.2, 21)};
+	const std::vector<double> volShocks{ScenarioEngine::makeLadder(0.05, 11)};
+	const ScenarioEngine scenarios(spotShocks, volShocks);
+	const ScenarioCube cube{scenarios.getPositionPnL(portfolio, quotes)};
+
+	// Scenario without shocks
+	std::size_t nonZero{0};
+	for (std::size_t p = 0; p < cube.rows; p++)
+	{
+		nonZero += (cube.at(p, spotShocks.size() / 2, volShocks.size() / 2) != 0.0) ? 1 : 0;
+	}
+	const bool zero = nonZero == 0;
+	std::cout << (zero ? "ok   " : "FAIL ") << "unshocked scenario: " << nonZero << " of " << cube.rows
+			  << " positions with a non-zero P&L\n";
+
+	// Every cell against the engine
+	double error{0.0};
+	const auto positions = portfolio.getPositions();
+	for (std::size_t p = 0; p < cube.rows; p++)
+	{
+		const Position& position = positions[p];
+		const MarketQuote& quote = quotes[position.underlying];
+		const auto payoff = std::make_shared<Payoff>(position.contract.T, position.contract.K, position.contract.type,
+													 Payoff::European);
+		const double base{AnalyticEuropeanEngine(quote.S, quote.sigma, quote.r, quote.b).getEnginePrice(payoff)};
+		for (std::size_t i = 0; i < spotShocks.size(); i++)
+		{
+			for (std::size_t j = 0; j < volShocks.size(); j++)
+			{
+				const AnalyticEuropeanEngine engine(quote.S * (1 + spotShocks[i]), quote.sigma + volShocks[j],
+													quote.r, quote.b);
+				const double expected{position.quantity * (engine.getEnginePrice(payoff) - base)};
+				error = std::max(error, std::abs(cube.at(p, i, j) - expected));
+			}
+		}
+	}
+	const bool agrees = error <= 1e-9;
+	std::cout << (agrees ? "ok   " : "FAIL ") << "shocked scenarios: max absolute error " << error << "\n";
+
+	return (zero && agrees) ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+// Test of the standard normal cdf and pdf against boost::math on the range
+// of d1 and d2 met by the engines, for the scalar functions and for the
+// batch functions on every instruction set the CPU supports.
+// Exits with 1 if an error exceeds its bound
+
+#include "StandardNormal.hpp"
+
+#include <boost/math/distributions/normal.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace PricingLibrary;
+
+namespace
+{
+	// Absolute error bounds of the double precision functions
+	constexpr double cdf_bound = 1e-15;
+	constexpr double pdf_bound = 1e-15;
+
+	const char* isaName(StandardNormal::Isa isa)
+	{
+		switch (isa)
+		{
+		case StandardNormal::Isa::AVX512:
+			return "avx512";
+		case StandardNormal::Isa::AVX2:
+			return "avx2";
+		default:
+			return "scalar";
+		}
+	}
+
+	/// @brief compare one set of results with boost and report the largest error
+	/// @param name function and instruction set
+	/// @param result computed values
+	/// @param expected boost values
+	/// @param bound largest allowed absolute error
+	/// @return true if the bound holds
+	bool check(const std::string& name, const std::vector<double>& result, const std::vector<double>& expected, double bound)
+	{
+		double error{0.0};
+		for (std::size_t i = 0; i < result.size(); i++)
+		{
+			error = std::max(error, std::abs(result[i] - expected[i]));
+		}
+
+		const bool passed = error <= bound;
+		std::cout << (passed ? "ok   " : "FAIL ") << name << ": max absolute error " << error << " (bound " << bound << ")\n";
+		return passed;
+	}
+}
+
+int main()
+{
+	// d1 and d2 on [-40, 40], beyond the cutoff of the tails, with the odd
+	// count so that vector remainders are exercised too
+	const boost::math::normal_distribution<double> normal(0.0, 1.0);
+	std::vector<double> x;
+	for (double value = -40.0; value <= 40.0; value += 0.00037)
+	{
+		x.push_back(value);
+	}
+	x.push_back(0.0);
+
+	std::vector<double> expectedCdf(x.size());
+	std::vector<double> expectedPdf(x.size());
+	std::vector<double> scalarCdf(x.size());
+	std::vector<double> scalarPdf(x.size());
+	for (std::size_t i = 0; i < x.size(); i++)
+	{
+		expectedCdf[i] = boost::math::cdf(normal, x[i]);
+		expectedPdf[i] = boost::math::pdf(normal, x[i]);
+		scalarCdf[i] = StandardNormal::cdf(x[i]);
+		scalarPdf[i] = StandardNormal::pdf(x[i]);
+	}
+
+	bool passed = check("cdf inline", scalarCdf, expectedCdf, cdf_bound);
+	passed = check("pdf inline", scalarPdf, expectedPdf, pdf_bound) && passed;
+
+	const StandardNormal::Isa best{StandardNormal::selectedIsa()};
+	for (StandardNormal::Isa isa : {StandardNormal::Isa::Scalar, StandardNormal::Isa::AVX2, StandardNormal::Isa::AVX512})
+	{
+		if (isa > best)
+		{
+			std::cout << "skip " << isaName(isa) << ": not supported by this CPU\n";
+			continue;
+		}
+
+		std::vector<double> result(x.size());
+		StandardNormal::cdf(x, result, isa);
+		passed = check(std::string("cdf ") + isaName(isa), result, expectedCdf, cdf_bound) && passed;
+		StandardNormal::pdf(x, result, isa);
+		passed = check(std::string("pdf ") + isaName(isa), result, expectedPdf, pdf_bound) && passed;
+	}
+
+	return passed ? 0 : 1;
+}
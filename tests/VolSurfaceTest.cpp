@@ -0,0 +1,75 @@
+// Test of volatility surface lookups at moneyness that is not a number: a
+// non-positive underlying price gives NaN log moneyness, which the grid and
+// SVI surfaces must reject, by scalar and batch lookup, instead of passing
+// it to their axis locators. Valid lookups on both sides of the grid must
+// still give the volatility of the nearest node.
+// Exits with 1 if a check fails
+
+#include "GridVolSurface.hpp"
+#include "SviVolSurface.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace PricingLibrary;
+
+namespace
+{
+	/// @brief if a lookup throws IncorrectInputException
+	/// @param lookup function performing the lookup
+	/// @return true if it throws
+	template <typename Lookup>
+	bool rejects(Lookup lookup)
+	{
+		try
+		{
+			lookup();
+		}
+		catch (const IncorrectInputException&)
+		{
+			return true;
+		}
+		catch (...)
+		{
+		}
+		return false;
+	}
+
+	/// @brief report that a surface rejects NaN moneyness and maturity
+	/// @param name surface
+	/// @param surface surface to check
+	/// @return true if every lookup is rejected
+	bool check(const std::string& name, const VolSurface& surface)
+	{
+		const double nan{std::numeric_limits<double>::quiet_NaN()};
+		const std::vector<double> S{100.0, -100.0}, K{100.0, 100.0}, T{0.5, 0.5}, b{0.0, 0.0};
+		std::vector<double> sigma(2);
+
+		const bool passed = rejects([&]() { surface.getVolatility(-100.0, 100.0, 0.5, 0.0); }) &&
+							rejects([&]() { surface.getVolatility(0.5, nan); }) &&
+							rejects([&]() { surface.getVolatility(nan, 0.0); }) &&
+							rejects([&]() { surface.getVolatilities(S, K, T, b, sigma); });
+		std::cout << (passed ? "ok   " : "FAIL ") << name << ": NaN moneyness and maturity are rejected\n";
+		return passed;
+	}
+}
+
+int main()
+{
+	const GridVolSurface grid({0.25, 1.0}, {-0.5, 0.0, 0.5}, {0.30, 0.20, 0.25, 0.28, 0.22, 0.24});
+	const SviVolSurface svi({{0.25, 0.01, 0.1, -0.3, 0.0, 0.2}, {1.0, 0.04, 0.1, -0.3, 0.0, 0.2}});
+
+	bool passed = check("grid", grid);
+	passed = check("svi", svi) && passed;
+
+	// Beyond the grid on both sides, also far enough to overflow a bucket index
+	const bool clamped = std::abs(grid.getVolatility(0.25, -1e300) - 0.30) <= 1e-15 &&
+						 std::abs(grid.getVolatility(0.25, std::numeric_limits<double>::infinity()) - 0.25) <= 1e-15 &&
+						 std::abs(grid.getVolatility(1e300, 0.0) - 0.22) <= 1e-15;
+	std::cout << (clamped ? "ok   " : "FAIL ") << "grid: lookups beyond the grid take the nearest node\n";
+
+	return (passed && clamped) ? 0 : 1;
+}